@@ -29,6 +29,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <array>
 #include <cmath>
 #include <boost/algorithm/string.hpp>
 #include "FFEA_return_codes.h"
@@ -79,6 +80,51 @@ class BindingSite{
 		scalar characteristic_length;
 };
 
+/**
+ * Spatial hash of the binding sites of all active blobs, so that the sites
+ * that could be in range of a given site are found without checking every
+ * pair. Centroids and characteristic lengths are calculated once, when the
+ * hash is built. The cell size is the largest possible binding range (twice
+ * the largest characteristic length), so only the 27 cells around a site
+ * need to be searched.
+ */
+class BindingSite_hash{
+
+	public:
+
+		void clear();
+		void add_site(int blob_index, BindingSite *site);
+		void build(int num_blobs);
+
+		int find_first_in_range(int blob_index, int site_index, int target_type);
+		BindingSite* get_site(int entry);
+
+	private:
+
+		struct Entry {
+			BindingSite *site;
+			int blob_index;
+			arr3 centroid;
+			scalar characteristic_length;
+			std::array<long long, 3> cell;
+		};
+
+		std::array<long long, 3> get_cell(const arr3 &pos);
+		int get_bucket(const std::array<long long, 3> &cell);
+
+		/** Sites in order of blob, then site index, so the lowest matching entry is the first site the exhaustive search would find */
+		vector<Entry> entries;
+
+		/** entries[blob_start[i]] is the first site of blob i */
+		vector<int> blob_start;
+
+		scalar cell_size = 0;
+
+		/** The entries in bucket b are bucket_entries[bucket_start[b]] to bucket_entries[bucket_start[b + 1] - 1] */
+		vector<int> bucket_start;
+		vector<int> bucket_entries;
+};
+
 class BindingSite_matrix{
 
 	public:
@@ -36,12 +36,14 @@
 #include <memory>
 #include <omp.h>
 #include <algorithm>  // std::find
+#include <limits>
 #include <Eigen/Sparse>
 #include "FFEA_return_codes.h"
 #include "mat_vec_types.h"
 #include "mat_vec_fns.h"
 #include "mesh_node.h"
 #include "tetra_element_linear.h"
+#include "TetraElementBlock.h"
 #include "SimulationParams.h"
 #include "Solver.h"
 #include "SparseSubstitutionSolver.h"
@@ -121,7 +123,12 @@ public:
              scalar compress, int linear_solver, int blob_state, const SimulationParams &params,
              const PreComp_params &pc_params, SSINT_matrix *ssint_matrix,
              BindingSite_matrix *binding_matrix, std::shared_ptr<std::vector<RngStream>> &rng);
-    void init();
+
+    /**
+     * Loads the mesh and builds everything the Blob needs to be simulated. If with_solver is false the
+     * linear Solver is not built, leaving it to build_solver() (used for conformations that are not active yet).
+     */
+    void init(bool with_solver = true);
 
     /**
      * Calculates all internal forces on the finite element mesh, storing them on the elements
@@ -145,6 +152,18 @@ public:
      */
     void reset_solver();
 
+    /**
+     * Builds the linear Solver (and its matrices) if it has not been built yet. Does nothing for non-dynamic Blobs.
+     */
+    void build_solver();
+
+    /**
+     * Frees the linear Solver, e.g. for a conformation that is no longer active. build_solver() brings it back.
+     */
+    void release_solver();
+
+    bool has_solver() const;
+
     /**
       * Translates the linear nodes, then linearises the secondary nodes
       */
@@ -201,6 +220,11 @@ public:
      * Calculates and returns the centroid of this Blob
      */
     void get_centroid(arr3 &com);
+
+    /**
+     * As get_centroid(), also storing it in CoG. Reuses the centroid found by update_positions() if the
+     * nodes have not moved since.
+     */
     void calc_and_store_centroid(arr3 &com);
     arr3 calc_centroid() const;
 
@@ -307,7 +331,8 @@ public:
 
 
     /**
-     * Set all forces on the blob to zero
+     * Set all (surface and element) forces on the blob to zero. Not needed between steps, as update_positions() zeroes
+     * the forces as it uses them.
      */
     void zero_force();
 
@@ -364,7 +389,7 @@ public:
      * Applies the WALL_TYPE_HARD boundary conditions simply by finding all nodes that have "passed through" the wall,
      * then zeroing any component of those nodes' velocities that points into the wall. This allows the Blob to "wobble"
      * its way back out of the wall (and effectively prevents any penetration larger than dt * largest velocity,
-     * generally very small for sensible dt).
+     * generally very small for sensible dt). A wall is skipped if the surface node bounds show that no node is past it.
      */
     void enforce_box_boundaries(arr3 &box_dim);
 
@@ -429,10 +454,10 @@ public:
     //void kinetic_bind(int site_index);
     //void kinetic_unbind(int site_index);
 
-    /** Activates binding sites by adding nodes to the list */
+    /** Activates binding sites by adding nodes to the list, and pinning them in the solver (no rebuild needed) */
     void pin_binding_site(set<int> node_indices);
 
-    /** Deactivates binding sites by removing nodes to the list */
+    /** Deactivates binding sites by removing nodes from the list, and unpinning them in the solver */
     void unpin_binding_site(set<int> node_indices);
 
     void print_node_positions() const;
@@ -489,6 +514,9 @@ private:
     /** Array of elements */
     std::vector<tetra_element_linear> elem = {};
 
+    /** The per-step data of the elements, which is all the element loop in update_internal_forces() reads */
+    TetraElementBlock elem_block;
+
     /** Array of surface faces */
     std::vector<Face> surface = {};
 
@@ -585,6 +613,15 @@ private:
     /** The Blob force vector (an array of the force on every node) */
     std::vector<arr3> force = {};
 
+    /**
+     * The forces the elements add onto every node (stress, noise and PreComp). Kept apart from force, which is
+     * written to the trajectory, until aggregate_forces_and_solve() adds them in.
+     */
+    std::vector<arr3> elem_force = {};
+
+    /** The Blob velocity vector (an array of the velocity of every node) */
+    std::vector<arr3> vel = {};
+
     /** The array of random number generators (needed for parallel runs) */
     std::shared_ptr<std::vector<RngStream>> rng = nullptr;
 
@@ -603,7 +640,22 @@ private:
     scalar rmsd = 0;
     //@}
 
+    //@{
+    /**
+     * The lowest and highest coordinates of the surface nodes. These and CoG are worked out at the end of
+     * update_positions(), and stay valid until something else moves the nodes.
+     */
+    arr3 surface_min = {}, surface_max = {};
+    bool node_bounds_valid = false;
+    //@}
+
+    /** For each second order node, the two linear nodes it sits halfway between ({-1, -1} for linear nodes) */
+    std::vector<std::array<int, 2>> midpoint_parents = {};
+
     std::unique_ptr<CG_solver> poisson_solver = nullptr;
+
+    /** The Poisson (diffusion * epsilon * volume) matrix of each element */
+    std::vector<PoissonMatrixQuadratic> K_alpha = {};
     std::shared_ptr<SparseMatrixFixedPattern> poisson_surface_matrix = nullptr;
     std::shared_ptr<SparseMatrixFixedPattern> poisson_interior_matrix = nullptr;
     std::vector<scalar> phi_Omega = {};
@@ -703,14 +755,17 @@ private:
     void aggregate_forces_and_solve();
 
     /*
-     *
+     * Updates the node velocities and positions from the solved forces, zeroing the forces as it goes
      */
     void euler_integrate();
 
-    /*
-     *
+    /**
+     * Calculates CoG and the surface node bounds, first putting each second order node back halfway
+     * between its linear nodes if linearise is set (this is linearise_element() for every element, done
+     * once per node)
      */
-    void calculate_node_element_connectivity();
+    void calc_centroid_and_bounds(bool linearise);
+
 
     void build_mass_matrix();
 };
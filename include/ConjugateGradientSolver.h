@@ -61,9 +61,18 @@ private:
     /** Maximum number of iterations the solver should use before giving up (as solution is not converging) */
     int i_max;
 
-    /** Number of rows in original matrix */
+    /** Number of rows in original matrix (one per free node) */
     int num_rows;
 
+    /** Number of nodes, including the pinned ones that have no row */
+    int num_nodes;
+
+    /** Maps each row of the matrix to the node it belongs to */
+    std::vector<int> free_node;
+
+    /** Maps each node to its row in the matrix, or -1 if the node is pinned */
+    std::vector<int> reduced_index;
+
     /** Array of all non-zero entries comprising the mass matrix, in the order they appear in the matrix
      * when scanned left to right across rows first (and columns secondary)
      */
@@ -80,12 +89,15 @@ private:
     /** Jacobi preconditioner (inverse of the mass matrix diagonal) */
     std::vector<scalar> preconditioner;
 
-    /** Work vectors */
-    std::vector<arr3> d, r, q, s, f;
+    /** Work vectors, over the free nodes only. v is the solution */
+    std::vector<arr3> v, d, r, q, s, f;
 
     /* */
     scalar conjugate_gradient_residual_assume_x_zero(std::vector<arr3> &b);
 
+    /** Writes the solution back onto every node, with zero for the pinned ones */
+    void scatter_solution(std::vector<arr3> &x);
+
     /* */
     scalar parallel_sparse_matrix_apply();
 
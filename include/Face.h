@@ -92,6 +92,15 @@ public:
     bool checkTetraIntersection(const Face *f2);
     bool checkTetraIntersection(const Face *f2, const std::vector<scalar> &blob_corr,int f1_daddy_blob_index,int f2_daddy_blob_index);
 
+    /** Check whether the axis aligned bounding boxes of the tetrahedron
+      *   formed by this face and the opposite linear node, and the
+      *   corresponding tetrahedron in f2, overlap.
+      * Returns false if the tetrahedra can not intersect, and is meant
+      *   as a broad phase filter in front of checkTetraIntersection.
+      **/
+    bool checkTetraBoundsOverlap(const Face *f2) const;
+    bool checkTetraBoundsOverlap(const Face *f2, const std::vector<scalar> &blob_corr,int f1_daddy_blob_index,int f2_daddy_blob_index) const;
+
     /** Get the volume that the enclose the intersection
       *   of the tetrahedron formed by this face an the opposite
       *   linear node with the corresponding tetrahedron in f2.
@@ -125,11 +134,11 @@ public:
       *   In addition, return the gradient of this volume,
       *     calculated as dV/dx,dV/dy,dV/dz, and the internal coordinates
       *     of the point where the force is applied.
-      * It calls 4 times volumeIntersection.
+      * The gradient is analytic, from the same call to volumeIntersectionAndGradientII.
       * This version works well for the double loop i<j. 
       **/
-    bool getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, geoscalar dr, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2);
-    bool getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, geoscalar dr, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2, const std::vector<scalar> &blob_corr, int f1_daddy_blob_index, int f2_daddy_blob_index);
+    bool getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2);
+    bool getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2, const std::vector<scalar> &blob_corr, int f1_daddy_blob_index, int f2_daddy_blob_index);
 
 
     Blob *daddy_blob;
@@ -183,6 +192,9 @@ private:
     int stuff;
     bool dealloc_n3;
 
+    /** Bounding box overlap test, with f2 translated by -f2_shift */
+    bool tetraBoundsOverlap(const Face *f2, const arr3 &f2_shift) const;
+
 };
 
 #endif
@@ -48,25 +48,38 @@
 
 using namespace std;
 
-class LJ_pair {
-public:
-    scalar Emin = 0;
-    scalar Rmin = 0;
+/**
+ * Flat copy of the SSINT parameters, one array per parameter, indexed with
+ * LJI(type1, type2). It is filled once the parameter file has been read, so
+ * that the face-pair kernels do no allocation or string look-ups.
+ */
+struct SSINT_table {
+    std::vector<scalar> Emin;
+    std::vector<scalar> Rmin;
+    std::vector<scalar> Rmin_3;
+    std::vector<scalar> Rmin_6;
+    std::vector<scalar> Rmini;   ///< 1 / Rmin, or 0 if Rmin is 0.
+    std::vector<scalar> k0;
 };
 
 class SSINT_matrix {
 public:
     void init(const string &ssint_params_fname, const string &ssint_type, int calc_ssint, scalar ssint_cutoff);
 
-   // void get_SSINT_params(int type1, int type2, map<string, scalar> *parmap);
-    map<string, scalar> get_SSINT_params(int type1, int type2);   
+    const map<string, scalar> &get_SSINT_params(int type1, int type2);
     int get_num_types();
 
+    /** Pre-resolved parameters for every type pair, see get_SSINT_index() */
+    const SSINT_table &get_SSINT_table() const { return table; }
+    /** Index of the (type1, type2) pair within the arrays of get_SSINT_table() */
+    int get_SSINT_index(int type1, int type2) const { return LJI(type1, type2); }
+
 private:
     void init_ssint(const string &ssint_params_fname, const string &ssint_type, scalar ssint_cutoff);
     void init_steric();
-    //LJ_pair *params;
+    void build_table();
     std::vector<map<string, scalar>> params = {};
+    SSINT_table table;
     int num_ssint_face_types = 0;
 };
 
@@ -24,6 +24,8 @@
 #ifndef LINKEDLISTCUBE_H_INCLUDED
 #define LINKEDLISTCUBE_H_INCLUDED
 
+#include <vector>
+
 template <class T>
 struct LinkedListNode {
     /** Pointer to the object this LinkedListNode represents */
@@ -71,6 +73,20 @@ public:
     /** Returns pointer to ith object in the pool */
     LinkedListNode<T> * get_from_pool(int i);
 
+    /**
+     * Adds (state = true) or removes (state = false) the pool nodes [first, first + count) from the active set.
+     * Only active nodes are placed on the grid and visited through get_active_from_pool(), so objects that
+     * are not taking part in the simulation (e.g. inactive conformations) cost nothing per step.
+     * Pool indices are unchanged, and the active set is kept in pool order.
+     */
+    void set_pool_range_active(int first, int count, bool state);
+
+    /** Returns pointer to the ith active object in the pool */
+    LinkedListNode<T> * get_active_from_pool(int i);
+
+    /** Returns how many objects in the 'pool' are active */
+    int get_num_active();
+
     /**
      * Completely clears entire grid of all linked lists by setting all pointers to nullptr in root,
      * and all 'next' pointers to nullptr in the pool of LinkedListNodes.
@@ -112,6 +128,10 @@ protected:
     /** The number of nodes in use */
     int num_nodes_in_pool;
 
+    /** Whether each pool node is active, and the pool indices of the active nodes in ascending order */
+    std::vector<bool> pool_active;
+    std::vector<int> active_pool;
+
     /** A cubic grid of pointers */
     LinkedListNode<T> **root1;
     LinkedListNode<T> **root2;
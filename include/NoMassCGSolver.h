@@ -53,6 +53,9 @@ public:
     /** Adds values to sparse viscosity matrix and uses it to solve the system Kv = f using conjugate gradient*/
     void solve(std::vector<arr3> &x) override;
 
+    /** Masks (or unmasks) the rows and columns of the given nodes, leaving their velocities at zero */
+    void set_nodes_pinned(const set<int> &node_indices, bool state) override;
+
     /* */
     void print_matrices(std::vector<arr3> &x);
 
@@ -67,17 +70,32 @@ private:
     /** Maximum number of iterations the solver should use before giving up (as solution is not converging) */
     int i_max;
 
-    /** Number of rows in V (3 * num_nodes due to x, y and z) */
+    /** Number of rows in V (3 * num_free_nodes due to x, y and z) */
     int num_rows;
 
     /** Number of nodes */
     int num_nodes;
 
+    /** Number of nodes that are not pinned, and so are in the system being solved */
+    int num_free_nodes;
+
+    /** Maps each row block of the system to the node it belongs to */
+    std::vector<int> free_node;
+
+    /** Maps each node to its row block in the system, or -1 if the node is pinned */
+    std::vector<int> reduced_index;
+
+    /**
+     * Row blocks of nodes pinned by binding sites. Unlike pinned_nodes_list these stay in the system, and their rows are masked
+     * out after every matrix product instead, so that binding and unbinding do not need the pattern rebuilt.
+     */
+    std::set<int> masked_nodes;
+
     /** Jacobi preconditioner (inverse of the viscosity matrix diagonal) */
     std::vector<scalar> preconditioner;
 
-    /** Work vectors */
-    std::vector<arr3> r, p, z, q, f;
+    /** Work vectors, over the free nodes only. v is the solution */
+    std::vector<arr3> v, r, p, z, q, f;
 
     /** Unchanging memory locoation */
     scalar one;
@@ -85,6 +103,9 @@ private:
     /* */
     scalar conjugate_gradient_residual_assume_x_zero(std::vector<arr3> &b);
 
+    /** Writes the solution back onto every node, with zero for the pinned ones */
+    void scatter_solution(std::vector<arr3> &x);
+
     /* */
     scalar residual2();
 
@@ -51,7 +51,7 @@ public:
   void init(const PreComp_params *pc_params, const SimulationParams *params, Blob **blob_array);
   void solve(scalar *blob_corr=nullptr); ///< calculate the forces using a straightforward double loop.
   void solve_using_neighbours();  ///< calculate the forces using linkedlists.
-  void solve_using_neighbours_non_critical(const std::vector<scalar> &blob_corr = {});  ///< using linkedlists, calculate twice the forces to avoid any critical regions.
+  void solve_using_neighbours_non_critical(const std::vector<scalar> &blob_corr = {});  ///< using the cell sorted bead arrays, visit every pair once, with per thread force buffers instead of critical regions.
   void reset_fieldenergy(); 
   scalar get_U(scalar x, int typei, int typej);
   scalar get_F(scalar x, int typei, int typej);
@@ -76,7 +76,18 @@ private:
 
   void calc_force_from_pot();
   
-  scalar finterpolate(std::vector<scalar> &Z, scalar x, int typei, int typej);
+  /** convert the tabulated U and F into cubic Hermite splines, on a grid as coarse as spline_tol allows. */
+  void build_splines(const PreComp_params &pc_params);
+
+  /** evaluate the spline for the pair typei-typej at x, getting both the potential u and the force f. */
+  void finterpolate(scalar x, int typei, int typej, scalar &u, scalar &f);
+
+  void build_cell_arrays(); ///< copy the beads in the active linked list into the cell sorted arrays.
+
+  /** Add the interactions between the bead in slot i and the beads in slots [j0, j1)
+   *    to the forces (fx, fy, fz) of both, and their energy to fe. */
+  void calc_slot_interactions(int i, int j0, int j1, const scalar *corr,
+                              scalar *fx, scalar *fy, scalar *fz, scalar *u, scalar *fe);
 
   // stuff related to the LinkedLists:
   LinkedListCube<int> pcLookUp; ///< the linkedlist itself
@@ -111,10 +122,52 @@ private:
         {+1, +1, 0},
         {+1, +1, +1}
   };
+  /** the own cell and the 13 cells "ahead" of it, so that every pair of
+   *    neighbouring cells is visited once */
+  static constexpr int half_shell_cells[14][3] = {
+        {0, 0, 0},
+        {0, 0, +1},
+        {0, +1, -1},
+        {0, +1, 0},
+        {0, +1, +1},
+        {+1, -1, -1},
+        {+1, -1, 0},
+        {+1, -1, +1},
+        {+1, 0, -1},
+        {+1, 0, 0},
+        {+1, 0, +1},
+        {+1, +1, -1},
+        {+1, +1, 0},
+        {+1, +1, +1}
+  };
+
+  /** The beads sorted by cell, as structure of arrays. 
+   *    They are rebuilt every time that the linked list changes,
+   *    while the positions are gathered at every step. */
+  bool cells_stale = true;
+  std::vector<int> cell_start;     ///< beads in cell c are in slots [cell_start[c], cell_start[c+1])
+  std::vector<int> occupied_cells; ///< cells with at least one bead
+  std::vector<int> slot_bead;      ///< index of the bead in every slot
+  std::vector<int> s_type;         ///< bead type per slot
+  std::vector<int> s_daddy;        ///< daddy blob per slot
+  std::vector<scalar> s_x, s_y, s_z; ///< bead positions per slot
+  std::vector<scalar> t_forces;    ///< forces per slot, fx, fy and fz blocks for every thread
+  std::vector<scalar> t_u;         ///< energy scratch per slot for every thread
+  std::vector<scalar> no_corr;     ///< zero blob_corr, used when there is no PBC correction
+  /** offset of the table for every pair of types in spline, or -1 if the pair is not active */
+  std::vector<int> pair_table;
   
 
   /** delta x in tabulated potentials and forces"  */
   scalar Dx = 0; 
+  /** delta x between the spline knots, a multiple of Dx */
+  scalar Dxs = 0;
+  /** number of spline intervals per table */
+  int n_intervals = 0;
+  /** 4 coefficients for every interval of every pair table: 
+   *    U(t) = c0 + c1 t + c2 t^2 + c3 t^3, with t in [0,1) along the interval, 
+   *    and F = - dU/dx. */
+  std::vector<scalar> spline;
   /** x_range */ 
   std::array<scalar, 2> x_range = {};
   /** squared x_range */
@@ -137,6 +190,8 @@ private:
   std::vector<int> b_types;
   /** map b_unq_elems to beads */
   std::vector<int> map_e_to_b;
+  /** the force on each node of each of b_unq_elems, staged so they are added to the nodes in a fixed order */
+  std::vector<arr3> unq_elem_forces;
   /** number of beads */ 
   int n_beads = 0;
   /** number of different elements */
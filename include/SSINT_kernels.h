@@ -0,0 +1,135 @@
+//
+//  This file is part of the FFEA simulation package
+//
+//  Copyright (c) by the Theory and Development FFEA teams,
+//  as they appear in the README.md file.
+//
+//  FFEA is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  FFEA is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+//
+//  To help us fund FFEA development, we humbly ask that you cite
+//  the research papers on the package.
+//
+
+#ifndef SSINT_KERNELS_H_INCLUDED
+#define SSINT_KERNELS_H_INCLUDED
+
+#include "mat_vec_types.h"
+
+/**
+ * Batched surface-surface interaction kernels.
+ *
+ * Each kernel evaluates n point pairs at once, given as separation
+ * vectors (dx, dy, dz) = p - q and an energy weight w per pair.
+ * The force on p for every pair is written to (fx, fy, fz) and the
+ * weighted energy is added to energy. The loops are written without
+ * branches, pow or per pair divisions by |r| so that they vectorise.
+ *
+ * A call only covers the point pairs of one face pair (or a single pair
+ * in the far field), so the kernels are inline, to be vectorised in
+ * place with the packing and unpacking around them.
+ *
+ * The scalar path in VdW_solver computes force_mag(r) * (p - q) / r.
+ * Here the 1/r is folded into the force factor, so LJ only needs 1/r^2
+ * and the other potentials a single sqrt per pair.
+ */
+
+/** Lennard-Jones: E = Emin (Rmin^12/r^12 - 2 Rmin^6/r^6) */
+inline void ssint_lj_kernel(int n, const scalar *dx, const scalar *dy, const scalar *dz, const scalar *w,
+                            scalar Emin, scalar Rmin_6,
+                            scalar *fx, scalar *fy, scalar *fz, scalar &energy) {
+
+    scalar e = 0;
+    #pragma omp simd reduction(+:e)
+    for (int i = 0; i < n; i++) {
+        scalar r2 = dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i];
+        scalar ri2 = 1 / r2;
+        scalar vdw_fac_6 = Rmin_6 * ri2 * ri2 * ri2;
+        scalar f = 12 * Emin * vdw_fac_6 * (vdw_fac_6 - 1) * ri2;
+        fx[i] = f * dx[i];
+        fy[i] = f * dy[i];
+        fz[i] = f * dz[i];
+        e += w[i] * Emin * vdw_fac_6 * (vdw_fac_6 - 2);
+    }
+    energy += e;
+}
+
+/** Lennard-Jones for r > Rmin, soft cubic core for r < Rmin (ljsteric) */
+inline void ssint_ljinterpolated_kernel(int n, const scalar *dx, const scalar *dy, const scalar *dz, const scalar *w,
+                            scalar Emin, scalar Rmin, scalar Rmini, scalar Rmin_6,
+                            scalar *fx, scalar *fy, scalar *fz, scalar &energy) {
+
+    const scalar core_f = 6 * Emin * Rmini * Rmini;
+    scalar e = 0;
+    #pragma omp simd reduction(+:e)
+    for (int i = 0; i < n; i++) {
+        scalar r2 = dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i];
+        scalar mag_r = std::sqrt(r2);
+
+        // Lennard-Jones tail
+        scalar ri2 = 1 / r2;
+        scalar vdw_fac_6 = Rmin_6 * ri2 * ri2 * ri2;
+        scalar f_lj = 12 * Emin * vdw_fac_6 * (vdw_fac_6 - 1) * ri2;
+        scalar e_lj = Emin * vdw_fac_6 * (vdw_fac_6 - 2);
+
+        // Soft core
+        scalar vdw_fac = mag_r * Rmini;
+        scalar f_core = core_f * (1 - vdw_fac);
+        scalar e_core = Emin * vdw_fac * vdw_fac * (2 * vdw_fac - 3);
+
+        bool core = mag_r < Rmin;
+        scalar f = core ? f_core : f_lj;
+        fx[i] = f * dx[i];
+        fy[i] = f * dy[i];
+        fz[i] = f * dz[i];
+        e += w[i] * (core ? e_core : e_lj);
+    }
+    energy += e;
+}
+
+/** Generalised soft potential (gensoft) */
+inline void ssint_gensoft_kernel(int n, const scalar *dx, const scalar *dy, const scalar *dz, const scalar *w,
+                            scalar Emin, scalar Rmin, scalar Rmin_3, scalar k0,
+                            scalar *fx, scalar *fy, scalar *fz, scalar &energy) {
+
+    const scalar Rmini = 1 / Rmin;
+    const scalar Rmini_2 = Rmini * Rmini;
+    const scalar k0rm = k0 * Rmin;
+    const scalar k0rm2 = k0rm * Rmin;
+    const scalar epsonrm = Emin * Rmini;
+
+    // force_mag / r = a r^2 + b r + k0
+    const scalar a = 2 * (k0rm - 6 * epsonrm) / Rmin_3;
+    const scalar b = 3 * (4 * epsonrm - k0rm) * Rmini_2;
+    // energy = c4 (r/Rmin)^4 + c3 (r/Rmin)^3 + 0.5 k0 r^2 - Emin
+    const scalar c4 = 0.5 * k0rm2 - 3 * Emin;
+    const scalar c3 = 4 * Emin - k0rm2;
+
+    scalar e = 0;
+    #pragma omp simd reduction(+:e)
+    for (int i = 0; i < n; i++) {
+        scalar r2 = dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i];
+        scalar mag_r = std::sqrt(r2);
+        scalar f = a * r2 + b * mag_r + k0;
+        fx[i] = f * dx[i];
+        fy[i] = f * dy[i];
+        fz[i] = f * dz[i];
+
+        scalar gensoftfac_2 = r2 * Rmini_2;
+        scalar gensoftfac_3 = gensoftfac_2 * mag_r * Rmini;
+        e += w[i] * (c4 * gensoftfac_2 * gensoftfac_2 + c3 * gensoftfac_3 + 0.5 * k0 * r2 - Emin);
+    }
+    energy += e;
+}
+
+#endif
@@ -70,6 +70,7 @@ struct PreComp_params
     int inputData;        ///< 1 means read .force and .pot files, while 2 means read .pot and calculate the forces
     scalar dist_to_m;
     scalar E_to_J;
+    scalar spline_tol;    ///< tolerance, relative to the largest value in each table, for the tables to be stored on a coarser spline grid.
 };
 
 class SimulationParams
@@ -124,7 +125,8 @@ public:
     // ! ------------------------
 
     int force_pbc;       ///< Whether or not to apply pbc to surface insteractions
-    int kinetics_update; ///< How often to check for a state change. If rates are ~ >> dt then this can clearly be quite high
+    int kinetics_update; ///< How often (in steps) binding site proximity is re-checked for binding rates. Switches themselves are event driven
+    int kinetics_solver_cache; ///< How many conformations per blob keep a built solver. Others are built when they become active
     int wall_x_1;
     int wall_x_2;
     int wall_y_1;
@@ -139,10 +141,13 @@ public:
     int calc_steric;      ///< Calculate steric interactions?
     scalar steric_factor; ///< Proportionality factor to the Steric repulsion.
     scalar ssint_cutoff;  ///< Cutoff distance for the surface-surface interactions.
-    geoscalar steric_dr;  ///< used to calculate the numerical derivative.
+    scalar ssint_farfield_ratio; ///< Face pairs further apart than this many times their summed radii use one-point quadrature (0: never).
+    geoscalar steric_dr;  ///< no longer used: the steric gradient is analytic.
     int calc_steric_rod;  // ! If the rod and blob steric interactions get integrated, remove this
     int calc_vdw_rod;   // !
     int pbc_rod;          // !
+    string rod_traj_format;    ///< "text": every array of every rod in its .rodtraj each frame; "binary": static data once, then positions in rod_traj_out_fname.
+    int rod_traj_diagnostics;  ///< Also write the steric and vdw energies, forces and site positions to each binary rod frame?
 
     string FFEA_script_filename;
     fs::path FFEA_script_path, FFEA_script_basename;
@@ -153,6 +158,7 @@ public:
     string ssint_in_fname;
     string bsite_in_fname;
     string rod_lj_in_fname;
+    string rod_traj_out_fname;     ///< Binary rod trajectory, used if rod_traj_format is "binary".
     string icheckpoint_fname;      ///< Input Checkpoint file name
     string ocheckpoint_fname;      ///< Output Checkpoint file name
     string ctforces_fname;         ///< Input file containing constant forces onto a list of nodes.
@@ -199,6 +205,7 @@ private:
     int ocheckpoint_fname_set;
     int ssint_in_fname_set;
     int rod_lj_in_fname_set;
+    int rod_traj_out_fname_set;
     int bsite_in_fname_set;
 
     /** Check if the file oFile exists, and if so
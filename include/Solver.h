@@ -49,5 +49,12 @@ public:
     virtual void solve(std::vector<arr3> &x) = 0;
 
     virtual void apply_matrix(const std::vector<scalar> &in, std::vector<scalar> &result) = 0;
+
+    /**
+     * Pins (state = true) or unpins the given nodes, as binding sites bind and unbind, without rebuilding the solver.
+     * By default nothing is done, since the solvers with a mass matrix only take pinned_nodes_list into their matrices;
+     * the Blob zeroes the forces on binding site nodes either way.
+     */
+    virtual void set_nodes_pinned(const set<int> &node_indices, bool state) {}
 };
 #endif
@@ -0,0 +1,167 @@
+// 
+//  This file is part of the FFEA simulation package
+//  
+//  Copyright (c) by the Theory and Development FFEA teams,
+//  as they appear in the README.md file. 
+// 
+//  FFEA is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+// 
+//  FFEA is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+// 
+//  You should have received a copy of the GNU General Public License
+//  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//  To help us fund FFEA development, we humbly ask that you cite 
+//  the research papers on the package.
+//
+
+#ifndef TETRAELEMENTBLOCK_H_INCLUDED
+#define TETRAELEMENTBLOCK_H_INCLUDED
+
+#include <vector>
+#include <array>
+#include <memory>
+#include "mat_vec_types.h"
+#include "SimulationParams.h"
+#include "RngStream.h"
+#include "mesh_node.h"
+#include "tetra_element_linear.h"
+
+/** The (maximum) number of elements processed together by TetraElementBlock::calc_stress_forces() */
+#define TETRA_ELEMENT_BATCH_SIZE 64
+
+/**
+ * Work space for a batch of elements, one array per quantity with one entry per element (lane).
+ */
+struct TetraElementBatch {
+    template <int N>
+    using lanes = std::array<std::array<scalar, TETRA_ELEMENT_BATCH_SIZE>, N>;
+
+    /** The shape function derivatives of each element */
+    lanes<12> dpsi;
+
+    /** The force (with the sign of du) from the internal stress of each element */
+    lanes<12> du;
+
+    /** The uniform random numbers for the fluctuating stress of each element */
+    lanes<7> noise;
+
+    /** Whether each element has inverted since the last step */
+    std::array<int, TETRA_ELEMENT_BATCH_SIZE> inverted;
+
+    void get_dpsi(int lane, vector12 &v) const;
+};
+
+/**
+ * The per-step data of every element in a Blob, stored as a structure of arrays.
+ *
+ * The element loop in Blob::update_internal_forces() only needs the node indices, rest state,
+ * material constants and noise prefactors of each element. Keeping these here, rather than reading
+ * them out of the (much larger) tetra_element_linear structs, means each step only streams through
+ * the data it actually uses. The viscosity matrix, Poisson matrix and other set-up data stay with
+ * the elements.
+ *
+ * The elements are coloured so that no two elements of the same colour share a node, and stored
+ * (in slots) sorted by colour. Each colour is split into batches, so the batches of one colour can
+ * add their forces straight onto the nodes in parallel.
+ */
+class TetraElementBlock {
+public:
+    /** @brief
+     * Colour the given (fully initialised) elements and copy their per-step data into this block.
+     * num_force_nodes is the number of nodes of each element that receive a force, which elements
+     * of the same colour may not share.
+     */
+    void init(std::vector<tetra_element_linear> &elem, int num_force_nodes);
+
+    int size() const { return num_elements; }
+
+    /** @brief The element in slot s */
+    int get_element(int s) const { return element[s]; }
+
+    /** @brief The slot of element e */
+    int get_slot(int e) const { return slot[e]; }
+
+    int get_num_colours() const { return static_cast<int>(colour_start.size()) - 1; }
+
+    /** @brief The first batch of colour c (colour c has batches get_colour_start(c) to get_colour_start(c + 1)) */
+    int get_colour_start(int c) const { return colour_start[c]; }
+
+    int get_num_batches() const { return static_cast<int>(batch_start.size()) - 1; }
+
+    /** @brief The first slot of batch b (batch b has slots get_batch_start(b) to get_batch_start(b + 1)) */
+    int get_batch_start(int b) const { return batch_start[b]; }
+
+    /** @brief
+     * Draws the random numbers for the fluctuating stress of the elements in slots begin to end (one batch),
+     * in the same order as tetra_element_linear::add_fluctuating_stress() does one element at a time.
+     */
+    void draw_noise(int begin, int end, std::shared_ptr<std::vector<RngStream>> &rng, int thread_id, TetraElementBatch &batch) const;
+
+    /** @brief
+     * Vectorised over the elements in slots begin to end (one batch): calculates the jacobian, shape
+     * function derivatives and volume of each element, then its elastic stress (plus the fluctuating
+     * stress, from the random numbers already in the batch, if calc_noise is on) and the force this
+     * stress puts on its nodes. The shape function derivatives and forces are left in the batch.
+     *
+     * If calc_viscous is set the viscous stress, from the velocity gradient over the element, is
+     * included too. This gives the same force as applying the viscosity matrix to the node velocities,
+     * without building the matrix. Otherwise the viscous force is left to the solver.
+     * Returns the number of elements that have inverted.
+     */
+    int calc_stress_forces(int begin, int end, const std::vector<mesh_node> &node, const std::vector<arr3> &vel,
+                           const SimulationParams &params, bool calc_viscous, TetraElementBatch &batch);
+
+    /** @brief Builds the viscosity matrix of the element in slot s */
+    void create_viscosity_matrix(int s, const vector12 &dpsi, matrix12 &V) const;
+
+    /** @brief
+     * Subtracts the forces left in the batch (slots begin to end) from the given (Blob) force array.
+     * Batches of the same colour can do this at the same time.
+     */
+    void add_element_force_vectors(int begin, int end, const TetraElementBatch &batch, std::vector<arr3> &force) const;
+
+    //@{
+    /** Per slot: the current volume, gradient deformation tensor (needed for the strain energy)
+     * and double contraction of the internal stress tensor of each element */
+    std::vector<scalar> vol = {};
+    std::vector<matrix3> F_ij = {};
+    std::vector<scalar> internal_stress_mag = {};
+    //@}
+
+private:
+    int num_elements = 0;
+
+    /** The element in each slot, and the slot of each element */
+    std::vector<int> element = {}, slot = {};
+
+    /** The first batch of each colour, and the first slot of each batch (each with an end entry) */
+    std::vector<int> colour_start = {}, batch_start = {};
+
+    /** Indices of the four linear nodes of each element */
+    std::array<std::vector<int>, NUM_NODES_LINEAR_TET> node_index = {};
+
+    /** Rest state inverse jacobian of each element, one array per matrix entry */
+    std::array<std::vector<scalar>, 9> J_inv_0 = {};
+
+    std::vector<scalar> vol_0 = {};
+    std::vector<scalar> last_det = {};
+
+    //@{
+    /** Material constants */
+    std::vector<scalar> A = {}, B = {}, G = {}, E = {};
+    //@}
+
+    //@{
+    /** Noise prefactors sqrt(A), sqrt(2A) and sqrt(B) */
+    std::vector<scalar> sqrt_A = {}, sqrt_2A = {}, sqrt_B = {};
+    //@}
+};
+
+#endif
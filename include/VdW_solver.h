@@ -29,6 +29,7 @@
 #include "FFEA_return_codes.h"
 #include "NearestNeighbourLinkedListCube.h"
 #include "LJ_matrix.h"
+#include "SSINT_kernels.h"
 #include "Blob.h"
 
 class VdW_solver {
@@ -38,7 +39,7 @@ public:
      */
     virtual ~VdW_solver() = default;
 
-    void init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3 &box_size, SSINT_matrix *ssint_matrix, scalar &steric_factor, int num_blobs, int inc_self_ssint, string ssint_type_string, scalar &steric_dr, int calc_kinetics, bool working_w_static_blobs);
+    void init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3 &box_size, SSINT_matrix *ssint_matrix, scalar &steric_factor, int num_blobs, int inc_self_ssint, string ssint_type_string, int calc_kinetics, bool working_w_static_blobs, scalar ssint_farfield_ratio);
 
     void solve(std::vector<scalar> &blob_corr);
 
@@ -49,6 +50,20 @@ public:
 
     void reset_fieldenergy(); 
 
+    /** Number of tetrahedron pairs reaching each stage of the steric overlap test,
+     *  summed over the whole run */
+    struct steric_filter_counts {
+        long long tested = 0;          ///< pairs handed to steric_overlap
+        long long rejected_bounds = 0; ///< rejected by the bounding box test
+        long long rejected_sat = 0;    ///< rejected by tet_a_tetII
+        long long rejected_volume = 0; ///< passed both, but volumeIntersection found no overlap
+    };
+
+    const steric_filter_counts &get_steric_filter_counts() const { return steric_counts; }
+
+    /** Print the steric_filter_counts to stdout */
+    void print_steric_filter_counts() const;
+
 protected:
 
     int total_num_surface_faces = 0;
@@ -67,7 +82,15 @@ protected:
     };
 
     scalar steric_factor = 0; ///< Proportionality factor to the Steric repulsion.
-    scalar steric_dr = 0; ///< Constant to calculate the numerical derivative.
+    scalar farfield_ratio2 = 0; ///< Square of ssint_farfield_ratio, 0 if one-point quadrature is disabled.
+    steric_filter_counts steric_counts;
+
+    /** Each thread's steric_filter_counts for the current solve (one cache line each, so the
+     *  threads don't contend), added into steric_counts at the end of the solve */
+    struct alignas(64) thread_steric_filter_counts {
+        steric_filter_counts counts;
+    };
+    std::vector<thread_steric_filter_counts> thread_steric_counts;
     // static const scalar phi_f[4]; ///< shape function for the center of the "element"
     static const std::array<adjacent_cell_lookup_table_entry, 27> adjacent_cell_lookup_table;
 
@@ -78,11 +101,20 @@ protected:
     };
     // static const struct tri_gauss_point gauss_pointx[num_tri_gauss_quad_points];
     static const std::array<tri_gauss_point, 3> gauss_points;
+    /** Gauss point pairs (k, l) with l >= k, the ones evaluated for each face pair */
+    static const int num_tri_gauss_quad_pairs = num_tri_gauss_quad_points * (num_tri_gauss_quad_points + 1) / 2;
 
     bool consider_interaction(Face *f1, int l_index_i, int motion_state_i, LinkedListNode<Face> *l_j, std::vector<scalar> &blob_corr);
 
     virtual void do_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr);
 
+    /** Whether the tetrahedra of f1 and f2 overlap. Runs the bounding box test and then
+     *  tet_a_tetII, so that only overlapping pairs go on to the volume intersection. */
+    bool steric_overlap(Face *f1, Face *f2, std::vector<scalar> &blob_corr);
+
+    /** The steric_filter_counts of the calling thread */
+    steric_filter_counts &get_thread_steric_counts();
+
     bool do_steric_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr);
 
     void do_lj_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr); 
@@ -91,27 +123,58 @@ protected:
 
     void do_sticky_xz_interaction(Face *f, bool bottom_wall, scalar dim_y);
 
+    /** Gauss points of both faces, shifted by blob_corr if given */
+    void calc_gauss_points(Face *f1, Face *f2, arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+              std::vector<scalar> &blob_corr);
+
+    /** Whether a face pair is far enough apart, relative to the size of the faces,
+     *  to be integrated with a single centroid-centroid point. */
+    bool is_farfield(Face *f1, Face *f2, arr3 &pc, arr3 &qc, std::vector<scalar> &blob_corr);
+
+    /** Get the surface-surface interaction energy and the forces on the three nodes of each face,
+     *  from either the 3x3 Gauss point rule (near field) or the centroids only (far field) */
+    void calc_nearfield_nodal_forces(int type, arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+              const SSINT_table &ssint, int ip, scalar ApAq, arr3 (&force1)[3], arr3 (&force2)[3], scalar &energy);
+    void calc_farfield_nodal_forces(int type, arr3 &pc, arr3 &qc,
+              const SSINT_table &ssint, int ip, scalar ApAq, arr3 (&force1)[3], arr3 (&force2)[3], scalar &energy);
+
+    /** Shared by the lj and gensoft interactions */
+    void do_ssint_interaction(int type, Face *f1, Face *f2, std::vector<scalar> &blob_corr);
+
+    /** Evaluate n point pairs of the given ssint type with the batched SSINT_kernels */
+    void calc_ssint_point_pairs(int type, int n, const scalar *dx, const scalar *dy, const scalar *dz, const scalar *w,
+              const SSINT_table &ssint, int ip, scalar *fx, scalar *fy, scalar *fz, scalar &energy);
+
+    /** Fill the force pair matrix of a face pair with the batched SSINT_kernels,
+     *  for ssint_type SSINT_TYPE_LJ, SSINT_TYPE_LJSTERIC or SSINT_TYPE_GENSOFT */
+    void calc_ssint_force_pair_matrix(int type,
+              arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
+              arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+              const SSINT_table &ssint, int ip, scalar &energy);
+
+    /* Scalar versions of the above, one point pair at a time. They are the
+     * reference the batched kernels are validated against. */
     void calc_lj_force_pair_matrix(
               arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
               arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points], 
-              scalar &Rmin, scalar &Emin, scalar &energy);
+              const scalar &Rmin_6, const scalar &Emin, scalar &energy);
 
     void calc_ljinterpolated_force_pair_matrix(
               arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
               arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points], 
-              scalar &Rmin, scalar &Emin, scalar &energy);
+              const scalar &Rmin, const scalar &Rmini, const scalar &Rmin_6, const scalar &Emin, scalar &energy);
 
     void calc_gensoft_force_pair_matrix(arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
         arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
-        scalar &Rmin, scalar &Emin, scalar &k0, scalar &energy);
+        const scalar &Rmin, const scalar &Rmin_3, const scalar &Emin, const scalar &k0, scalar &energy);
 
-    void calc_lj_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmin_6,
+    void calc_lj_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmin_6,
                                  scalar &force_mag, scalar &e);
 
-    void calc_ljinterpolated_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmini,
+    void calc_ljinterpolated_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmini,
                                  scalar &force_mag, scalar &e);
 
-    void calc_gensoft_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmin_2, scalar &Rmin_3, scalar &k0, 
+    void calc_gensoft_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmin, const scalar &Rmin_3, const scalar &k0, 
                                  scalar &force_mag, scalar &e);
 
     scalar minimum_image(scalar delta, scalar size);
@@ -32,6 +32,10 @@ template <typename T>
 T volumeIntersection(const std::array<std::array<T,3>, 4> &tetA, const std::array<std::array<T,3>, 4> &tetB, bool calcCM, std::array<T,3> &cm);
 template <typename T>
 T volumeIntersectionII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3, const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3, bool calcCM, std::array<T,3> &cm);
+/** return the the overlapping volume between tetrahedra tetA and tetB, its CM, and its gradient
+ *   dVdB with respect to a rigid translation of tetB */
+template <typename T>
+T volumeIntersectionAndGradientII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3, const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3, std::array<T,3> &dVdB, std::array<T,3> &cm);
 /** return the the overlapping volume between tetrahedra tetA and tetB, and the area enclosing this volume */ 
 template <typename T>
 void volumeAndAreaIntersection(const std::array<std::array<T,3>,4> &tetA, const std::array<std::array<T,3>,4> &tetB, T &vol, T &area);
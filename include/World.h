@@ -32,9 +32,14 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <list>
+#include <queue>
+#include <functional>
 #include <omp.h>
 #include <ctime>
 #include <algorithm>
+#include <limits>
+#include <cmath>
 
 #include <boost/algorithm/string.hpp>
 #include <typeinfo>
@@ -105,7 +110,7 @@ public:
     void run();
 
     /* */
-    void read_and_build_system(const vector<string> &script_vector);
+    void read_and_build_system(const vector<string> &script_vector, int frames_to_delete);
 
     /* */
     void load_kinetic_maps(const vector<string> &map_fnames, const vector<int> &map_from, const vector<int> &map_to, int blob_index);
@@ -149,6 +154,12 @@ private:
     /** @brief 1-D array containing pointers to all rod-blob interfaces */
     rod::Rod_blob_interface **rod_blob_interface_array;
 
+    /** @brief Perturbed rotations of each tetrahedron with a rod attached, rebuilt every step and shared by the interfaces on it */
+    std::vector<rod::Tet_rotation_batch> interface_tet_batches;
+    std::vector<int> interface_batch_index; ///< Entry of interface_tet_batches used by each interface
+    std::vector<std::vector<int>> rod_interface_groups; ///< Interfaces on each rod, in order. Different groups can be stepped concurrently
+    std::vector<std::array<arr3, NUM_NODES_LINEAR_TET>> interface_forces; ///< Forces from each interface, applied to the blobs in order
+
     /** @brief Maps for kinetic switching of conformations */
     std::vector<std::vector<std::vector<std::shared_ptr<SparseMatrixFixedPattern>>>> kinetic_map;
     std::vector<std::vector<std::vector<std::shared_ptr<SparseMatrixFixedPattern>>>> kinetic_return_map;
@@ -160,6 +171,18 @@ private:
     std::vector<std::vector<std::vector<scalar>>> kinetic_base_rate;
     //@}
 
+    //@{
+    /**
+     * @brief Event-driven kinetics. Each blob's next switch is sampled from its total switching rate, as a time in steps,
+     * and queued earliest first. kinetic_event_time holds the live event of each blob; queue entries that have since been
+     * re-sampled no longer match it and are skipped.
+     */
+    std::priority_queue<std::pair<scalar, int>, std::vector<std::pair<scalar, int>>, std::greater<std::pair<scalar, int>>> kinetic_events;
+    std::vector<scalar> kinetic_event_time;
+    std::vector<scalar> kinetic_event_total_rate; ///< Total switching rate each blob's event was sampled from
+    bool kinetic_rates_depend_on_sites = false; ///< Whether any binding rate (and so binding site proximity) has to be re-checked every kinetics_update steps
+    //@}
+
     /** @brief An array of springs which connect nodes if necessary */
     std::vector<Spring> spring_array;
 
@@ -193,6 +216,12 @@ private:
      */
     NearestNeighbourLinkedListCube lookup;
 
+    /** @brief For each blob, the conformations whose solvers are built, most recently used first */
+    std::vector<std::list<int>> conformation_solver_lru;
+
+    /** @brief First pool index and number of faces of each conformation in lookup, as [blob][conformation] */
+    std::vector<std::vector<std::array<int, 2>>> lookup_face_range;
+
     /** @brief Output trajectory file */
     FILE *trajectory_out;
 
@@ -209,6 +238,11 @@ private:
     /** @brief Output file for the trajectory beads. Completely optional. */
     FILE *trajbeads_out;
 
+    /** @brief Binary rod trajectory, if rod_traj_format is "binary". Frames are built in rod_traj_buffer and written in one go */
+    FILE *rod_traj_out;
+    std::vector<float> rod_traj_buffer;
+    long rod_traj_restart_size; ///< Bytes of the binary rod trajectory up to the last complete frame, when restarting
+
     //@{
     /** Energies */
     scalar kineticenergy, strainenergy, springenergy, ssintenergy, preCompenergy;
@@ -257,9 +291,18 @@ private:
     SSINT_matrix ssint_matrix;
     SSINT_matrix rod_lj_matrix;
 
+    /** @brief Candidate pairs of rod elements for steric interactions, and of VDW sites */
+    rod::NbrCellList rod_steric_cells;
+    rod::NbrCellList rod_vdw_cells;
+    std::vector<rod::NbrSphere> rod_nbr_spheres;
+    std::vector<std::array<int, 2>> rod_nbr_ids;  ///< (rod, element or site) of each sphere
+
     /** @brief Binding Interactions matrix */
     BindingSite_matrix binding_matrix;
 
+    /** @brief Binding sites of the active blobs, rebuilt at each kinetics update */
+    BindingSite_hash binding_site_hash;
+
 
     /**
       * @brief stores info within the <precomp> block at the .ffea file.
@@ -281,14 +324,32 @@ private:
 
     rod::Rod* rod_from_block(vector<string> block, int block_id, FFEA_input_reader &systemreader);
 
+    void group_rod_blob_interfaces();
+
+    void do_rod_blob_interface_timestep();
+
+    void update_rod_steric_nbr_lists();
+
     void update_rod_steric_nbr_lists(rod::Rod* rod_a, rod::Rod* rod_b);
 
+    void add_rod_steric_nbrs(rod::Rod *rod_a, int elem_a, rod::Rod *rod_b, int elem_b);
+
+    void update_rod_vdw_nbr_lists(SSINT_matrix *lj_matrix);
+
     void update_rod_vdw_nbr_lists(rod::Rod *rod_a, rod::Rod *rod_b, SSINT_matrix *lj_matrix);
 
+    void add_rod_vdw_nbrs(rod::Rod *rod_a, rod::VDWSite &site_a, rod::Rod *rod_b, rod::VDWSite &site_b, SSINT_matrix *lj_matrix);
+
     void rod_pbc_wrap(rod::Rod* current_rod, std::vector<float> dim);
 
     void rod_box_length_check(rod::Rod *current_rod, std::vector<float> dim);
 
+    void open_rod_binary_trajectory();
+
+    void load_rod_binary_trajectory(int frames_to_delete);
+
+    void write_rod_binary_frame(int step);
+
     void activate_springs();
 
     void apply_springs();
@@ -298,12 +359,33 @@ private:
     /** @brief calculates the kinetic rates as a function of the energy of the system*/
     void calculate_kinetic_rates();
 
-    /** @brief randomly chooses a new kinetic state based upon the kinetic rates / switching probabilitie */
+    /** @brief indexes the binding sites of the active blobs in binding_site_hash */
+    void build_binding_site_hash();
+
+    /** @brief randomly chooses a new kinetic state, with a probability proportional to the rate of switching to it */
     void choose_new_kinetic_state(int blob_index, int *target);
 
+    /** @brief total rate (per step) at which a blob leaves its current state */
+    scalar get_total_kinetic_rate(int blob_index) const;
+
+    /** @brief samples the time of the next kinetic event of a blob, from time now (in steps), and queues it */
+    void schedule_kinetic_event(int blob_index, scalar now);
+
+    /** @brief calculates the initial rates and queues the first kinetic event of every blob */
+    void start_kinetic_events(long long step);
+
+    /** @brief carries out the kinetic events due by this step, and re-samples the blobs whose rates have changed */
+    void do_kinetic_events(long long step);
+
     /** @brief changes the kinetic state based upon the kinetic rates. Maps between conformations and adds/ removes bound sites */
     void change_kinetic_state(int blob_index, int target_state);
 
+    /** @brief builds the solver of a conformation about to become active, freeing the least recently used ones beyond kinetics_solver_cache */
+    void use_conformation_solver(int blob_index, int conformation_index);
+
+    /** @brief (de)activates the faces of a conformation, adding them to or removing them from the face lookup */
+    void set_conformation_faces_active(int blob_index, int conformation_index, bool state);
+
     void get_next_script_tag(FILE *in, char *buf);
 
     void apply_dense_matrix(scalar *y, scalar *M, scalar *x, int N);
@@ -65,4 +65,11 @@ struct ffea_test
     static int rod_steric_lj_potential();
     static int nearest_image_pbc();
     static int rod_vdw_site_placement();
+    static int rod_nbr_cell_list();
+    static int ssint_kernels();
+    static int ssint_farfield_quadrature();
+    static int tetra_element_kernel();
+    static int kinetic_rates();
+    static int binding_site_hash();
+    static int rod_binary_trajectory();
 };
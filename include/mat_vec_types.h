@@ -49,6 +49,16 @@ typedef double geoscalar;
 #endif 
 //typedef long double scalar;
 
+/*
+ * Marks a vectorised kernel to be compiled for AVX-512, AVX2 and the baseline
+ * ISA on GCC/x86. The version matching the CPU is picked when the program loads.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define FFEA_SIMD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FFEA_SIMD_DISPATCH
+#endif
+
 ////////  Constants and scalar functions ///////
 namespace ffea_const {
    const scalar threeErr = 3.0*std::numeric_limits<scalar>::epsilon();
@@ -44,25 +44,27 @@ public:
 
     void print();
 
+    /*
+     * The velocity of, and force on, each node are stored in arrays on the Blob (along with the element
+     * contributions to that force), so that the integrator doesn't pull the rest of the node through the cache.
+     * Fields that are read every step come first.
+     */
+
     /** Position of node */
     arr3 pos = {};
 
-    /** Velocity of node */
-    arr3 vel = {};
-
-    /** Electrostatic potential at this node */
-    scalar phi = 0;
-
-    int num_element_contributors = 0;
-
-    /** An array of pointers to contributions to the total force on this node. There should be one
-     * contribution from each element this node is a part of (so the length will be num_element_contributors).
-     */
-    std::vector<arr3 *> force_contributions = {};
+    /** The drag due to stokes on this node, not including velocity */
+    scalar stokes_drag = 0;
 
     /** Required for some general matrix constructions in which we need to know this node's 'index' in the node vector */
     int index = 0;
 
+    /** Stores whether or not this node is linear (as the order is surface - interior, not linear - secondary) */
+    bool linear = false;
+
+    /** Electrostatic potential at this node */
+    scalar phi = 0;
+
     /** Equilibrium position of nodes (for RMSD calculations) */
     arr3 pos_0 = {};
 
@@ -72,12 +74,6 @@ public:
     /** Stokes radius of this node */
     scalar stokes_radius = 0;
 
-    /** The drag due to stokes on this node, not including velocity */
-    scalar stokes_drag = 0;
-
-    /** Stores whether or not this node is linear (as the order is surface - interior, not linear - secondary) */
-    bool linear = false;
-
     void set_linear();
     bool am_I_linear();
 };
@@ -60,6 +60,32 @@ void equil_attachment_node_from_J(const float9 &J_inv_0, const int3 &face_node_i
 bool points_out_of_tet(const float3 &node1, const float3 &node2, const float3 &node3, const float3 &node4, const float3 &attachment_element, const float3 &attachment_node);
 void get_attachment_node_pos(const float3 &face_node_1, const float3 &face_node_2, const float3 &face_node_3, const float3x3 &edge_vecs, const float3 &node_weighting, const float3 &tet_origin, OUT float3 &face_node_pos);
 
+/**
+ The rotation of an attachment tetrahedron under each of the node
+ perturbations used to get the interface forces (every linear node, moved
+ in +x, +y, +z, -x, -y, -z). It only depends on the tetrahedron, so
+ interfaces that share one can share a batch. The Jacobians and rotations
+ are stored one matrix element per row, so that the gradient deformation
+ and QR decomposition run as vectorisable loops over the perturbations.
+*/
+struct Tet_rotation_batch
+{
+    static constexpr int num_perturbations = NUM_NODES_LINEAR_TET*6;
+
+    tetra_element_linear* tet = nullptr;
+    float displacement = 0;
+    float9 J_inv_0;
+    std::array<std::array<arr3, NUM_NODES_LINEAR_TET>, num_perturbations> perturbed_pos;
+    std::array<std::array<float, num_perturbations>, 9> J;
+    std::array<std::array<float, num_perturbations>, 9> Q;
+
+    void build(const std::array<arr3, NUM_NODES_LINEAR_TET> &tet_pos);
+    void build(const tetra_element_linear *tet);
+    void get_rotation(int perturbation, OUT float9 &rotation) const;
+};
+
+void get_tet_rotation_batch(const float9 &J_inv_0, const std::array<std::array<float, Tet_rotation_batch::num_perturbations>, 9> &J, OUT std::array<std::array<float, Tet_rotation_batch::num_perturbations>, 9> &Q);
+
 // objects go here
 
 struct Rod_blob_interface
@@ -114,9 +140,15 @@ struct Rod_blob_interface
     void select_face_nodes(OUT int3 &face_node_indices);
     int get_element_id(const int3 &nodes);
     void get_node_energy(int node_index, float3 &attachment_node_equil, float3 &attachment_material_axis_equil, float3 &attachment_node, float3 &attachment_material_axis, float displacement, float6 &energy);
+    void get_node_energy(int node_index, const Tet_rotation_batch &batch, float3 &attachment_node_equil, float3 &attachment_material_axis_equil, float3 &attachment_node, float3 &attachment_material_axis, float6 &energy);
+    void get_attachment_node_pos(const std::array<arr3, NUM_NODES_LINEAR_TET> &tet_pos, OUT float3 &attachment_node_pos);
     //void get_rod_energy(float3 &attachment_node_equil, float3 &attachment_material_axis_equil, float displacement, float energy[2][6]);
     void position_rod_ends(float3 &attachment_node_pos);
     void do_connection_timestep();
+    float get_dynamics_displacement();
+    void begin_connection_timestep();
+    void get_connection_forces(const Tet_rotation_batch &batch, OUT std::array<arr3, NUM_NODES_LINEAR_TET> &forces);
+    void apply_connection_forces(const std::array<arr3, NUM_NODES_LINEAR_TET> &forces);
     
 
     // note: maybe a wrapper function for doubles that converts them to floats? see if it works
@@ -85,6 +85,76 @@ namespace rod
         bool elements_intersect() const;
     };
 
+    /**
+     * The neighbour list of a rod. The interactions of all of its elements
+     * are stored in one flat array, grouped by element (compressed sparse row).
+     * Interactions are added in any order, and group() sorts them by element,
+     * keeping the order in which they were added within each element.
+     */
+    class NbrList
+    {
+    public:
+        void resize(int num_elements);
+        void clear();
+        void add(const InteractionData &interaction) { added.push_back(interaction); }
+        void group();
+
+        int num_elements() const { return static_cast<int>(start.size()) - 1; }
+        int num_nbrs(int elem_id) const { return start[elem_id + 1] - start[elem_id]; }
+        const InteractionData &get(int elem_id, int nbr_id) const { return data[start[elem_id] + nbr_id]; }
+
+    private:
+        std::vector<InteractionData> added;  /** Every interaction since the last clear(), in the order they were added **/
+        std::vector<InteractionData> data;   /** The same, grouped by elem_id_self **/
+        std::vector<int> start;              /** The interactions of element e are data[start[e]] to data[start[e + 1] - 1] **/
+        std::vector<int> fill;
+    };
+
+    /** A sphere bounding a rod element or a VDW site, for the neighbour search. */
+    struct NbrSphere
+    {
+        float3 centre;
+        float radius;
+        int rod_id;
+    };
+
+    /**
+     * Finds the pairs of spheres on different rods that are within a skin
+     * distance of touching, with a cell list. The pairs are kept until a
+     * sphere has moved or grown by more than half of the skin since they
+     * were found, so the cells are only rebuilt every so often and every
+     * pair that actually touches is always in the list.
+     */
+    class NbrCellList
+    {
+    public:
+        /** The skin is this fraction of the largest sphere radius. */
+        explicit NbrCellList(float skin_fraction = 0.5) : skin_fraction(skin_fraction) {}
+
+        /**
+         * Update the pairs for the current spheres, which must be given in
+         * the same order on every call. Returns true if the pairs were
+         * searched for again.
+         */
+        bool update(const std::vector<NbrSphere> &spheres, bool periodic, const std::vector<float> &box_dim);
+
+        /** Indices of the sphere pairs, lowest index first, in ascending order. */
+        const std::vector<std::array<int, 2>> &get_pairs() const { return pairs; }
+        int get_num_builds() const { return num_builds; }
+
+    private:
+        void build(const std::vector<NbrSphere> &spheres, bool periodic, const std::vector<float> &box_dim);
+
+        float skin_fraction;
+        float skin = 0;
+        int num_builds = 0;
+        std::vector<NbrSphere> built;  /** The spheres when the pairs were last searched for **/
+        std::vector<std::array<int, 2>> pairs;
+        std::vector<int> cell_start;   /** The spheres in cell c are cell_spheres[cell_start[c]] to cell_spheres[cell_start[c + 1] - 1] **/
+        std::vector<int> cell_spheres;
+        std::vector<int> sphere_cell;
+    };
+
 
     // previously: snap_to_nodes
     void finite_length_correction(
@@ -142,8 +212,8 @@ namespace rod
         float3 &r_b,
         float radius_a,
         float radius_b,
-        std::vector<InteractionData> &neighbours_a,
-        std::vector<InteractionData> &neighbours_b,
+        NbrList &neighbours_a,
+        NbrList &neighbours_b,
         bool periodic,
         const std::vector<float> &box_dim);
 
@@ -176,18 +246,18 @@ namespace rod
         const float3 &c_b,
         float radius_sum);
 
-    std::vector<float> element_steric_energy(
+    float3 element_steric_energy(
         float delta,
         float force_strength,
         float radius_sum,
         const float3 &c_a,
         const float3 &c_b);
 
-    std::vector<float> node_force_interpolation(
+    float6 node_force_interpolation(
         const float3 & contact,
         const float3 & node_1,
         float element_length,
-        const std::vector<float> &element_force);
+        const float3 &element_force);
 
     // ! - should ideally be in their own file
     /*
@@ -224,18 +294,18 @@ namespace rod
     };
 
     void set_vdw_nbrs(
-        VDWSite site_a,
-        VDWSite site_b,
+        const VDWSite &site_a,
+        const VDWSite &site_b,
         const float3 &p_a,
         const float3 &p_b,
         const float3 &r_a,
         const float3 &r_b,
         float radius_a,
         float radius_b,
-        std::vector<InteractionData> &nbr_a,
-        std::vector<InteractionData> &nbr_b,
+        NbrList &nbr_a,
+        NbrList &nbr_b,
         bool periodic,
-        std::vector<float> box_dim,
+        const std::vector<float> &box_dim,
         float vdw_cutoff,
         float epsilon,
         float sigma);
@@ -42,6 +42,7 @@
 #include <stdlib.h>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <vector>
+#include <initializer_list>
 #include <string>
 //#include <fenv.h>
 
@@ -58,6 +59,19 @@ namespace rod
     typedef std::array<float3, 4> float4x3;
     typedef std::array<float4, 4> float4x4;
     typedef std::array<int, 3> int3;
+
+    /**
+     * The energy functions are templates on the scalar type S, so that the same code gives the energies (S = float) and
+     * their derivatives (S = dual numbers, see get_energy_gradient). The equilibrium state is always float.
+     */
+    template <typename S> using vec2 = std::array<S, 2>;
+    template <typename S> using vec3 = std::array<S, 3>;
+    template <typename S> using vec9 = std::array<S, 9>;
+    template <typename S> using vec4x3 = std::array<vec3<S>, 4>;
+
+    /** Keeps a parameter out of template argument deduction, so that e.g. a double angle can go with float vectors */
+    template <typename T> struct non_deduced { typedef T type; };
+
     extern bool dbg_print;
 
     const static bool debug_nan = false;
@@ -96,20 +110,22 @@ namespace rod
     void print_array(std::string array_name, const std::vector<float> &vec, int start, int end);
     void write_vector(FILE *file_ptr, const std::vector<int> &vec, bool new_line);
     void write_vector(FILE *file_ptr, const std::vector<float> &vec, float unit_scale_factor, bool new_line);
+    void append_vector(std::vector<float> &buffer, const std::vector<float> &vec, float unit_scale_factor);
     void print_vector(std::string vector_name, const std::vector<float> &vec);
     void print_vector(std::string vector_name, const std::vector<int> &vec);
     void print_vector(std::string vector_name, std::vector<float>::iterator start, std::vector<float>::iterator end);
     void print_vector(std::string vector_name, const std::vector<float> &vec, int start_ind, int end_ind);
     void print_vector(std::string vector_name, const std::vector<int> &vec, int start_ind, int end_ind);
-    void normalize(const float3 &in, OUT float3 &out);
+    template <typename S> void normalize(const vec3<S> &in, OUT vec3<S> &out);
     void normalize(std::vector<float> in, OUT std::vector<float> out);
-    void normalize_unsafe(const float3 &in, OUT float3 &out);
-    float absolute(const float3 &in);
+    template <typename S> void normalize_unsafe(const vec3<S> &in, OUT vec3<S> &out);
+    template <typename S> S absolute(const vec3<S> &in);
     float absolute(const std::vector<float> &in);
-    void cross_product(const float3 &a, const float3 &b, float3 &out);
-    void cross_product_unsafe(const float3 &a, const float3 &b, float3 &out);
-    void get_rotation_matrix(const float3 &a, const float3 &b, float9 &rotation_matrix);
+    template <typename S> void cross_product(const vec3<S> &a, const vec3<S> &b, vec3<S> &out);
+    template <typename S> void cross_product_unsafe(const vec3<S> &a, const vec3<S> &b, vec3<S> &out);
+    template <typename S> void get_rotation_matrix(const vec3<S> &a, const vec3<S> &b, vec9<S> &rotation_matrix);
     void get_cartesian_rotation_matrix(int dim, float angle, float9 &rotation_matrix);
+    template <typename S> void apply_rotation_matrix(const vec3<S> &vec, const vec9<S> &matrix, OUT vec3<S> &rotated_vec);
     void apply_rotation_matrix(arr3_view<float, float3> vec, const float9 &matrix, OUT float3 &rotated_vec);
     void apply_rotation_matrix_row(arr3_view<float, float3> vec, const float9 &matrix, OUT float3 &rotated_vec);
     void matmul_3x3_3x3(const float9 &a, const float9 &b, OUT float9 &out);
@@ -117,28 +133,28 @@ namespace rod
     // These are utility functions specific to the math for the rods
     void get_p_i(const float3 &curr_r, const float3 &next_r, OUT float3 &p_i);
     void get_element_midpoint(const float3 &p_i, const float3 &r_i, OUT float3 &r_mid);
-    void rodrigues_rotation(const float3 &v, const float3 &k, float theta, OUT float3 &v_rot);
+    template <typename S> void rodrigues_rotation(const vec3<S> &v, const vec3<S> &k, typename non_deduced<S>::type theta, OUT vec3<S> &v_rot);
     float safe_cos(float in);
     float get_l_i(const float3 &p_i, const float3 &p_im1);
-    float get_signed_angle(const float3 &m1, const float3 &m2, const float3 &l);
+    template <typename S> S get_signed_angle(const vec3<S> &m1, const vec3<S> &m2, const vec3<S> &l);
 
     /*-----------------------*/
     /* Update Material Frame */
     /*-----------------------*/
 
-    void perpendicularize(const float3 &m_i, const float3 &p_i, OUT float3 &m_i_prime);
-    void update_m1_matrix(float3 &m_i, const float3 &p_i, const float3 &p_i_prime, float3 &m_i_prime);
+    template <typename S> void perpendicularize(const vec3<S> &m_i, const vec3<S> &p_i, OUT vec3<S> &m_i_prime);
+    template <typename S> void update_m1_matrix(const vec3<S> &m_i, const vec3<S> &p_i, const vec3<S> &p_i_prime, vec3<S> &m_i_prime);
 
     /*------------------*/
     /* Compute Energies */
     /*------------------*/
 
-    float get_stretch_energy(float k, float3 &p_i, float3 &p_i_equil);
-    void parallel_transport(float3 &m, float3 &m_prime, const float3 &p_im1, const float3 &p_i);
-    float get_twist_energy(float beta, float3 &m_i, float3 &m_im1, float3 &m_i_equil, float3 &m_im1_equil, float3 &p_im1, float3 &p_i, float3 &p_im1_equil, float3 &p_i_equil);
-    void get_kb_i(const float3 &p_im1, const float3 &p_i, OUT float3 &kb_i);
-    void get_omega_j_i(const float3 &kb_i, const float3 &n_j, const float3 &m_j, OUT float2 &omega_j_i);
-    float get_bend_energy(const float2 &omega_i_im1, const float2 &omega_i_im1_equil, const float4 &B_equil);
+    template <typename S> S get_stretch_energy(float k, const vec3<S> &p_i, const float3 &p_i_equil);
+    template <typename S> void parallel_transport(const vec3<S> &m, vec3<S> &m_prime, const vec3<S> &p_im1, const vec3<S> &p_i);
+    template <typename S> S get_twist_energy(float beta, const vec3<S> &m_i, const vec3<S> &m_im1, const float3 &m_i_equil, const float3 &m_im1_equil, const vec3<S> &p_im1, const vec3<S> &p_i, const float3 &p_im1_equil, const float3 &p_i_equil);
+    template <typename S> void get_kb_i(const vec3<S> &p_im1, const vec3<S> &p_i, OUT vec3<S> &kb_i);
+    template <typename S> void get_omega_j_i(const vec3<S> &kb_i, const vec3<S> &n_j, const vec3<S> &m_j, OUT vec2<S> &omega_j_i);
+    template <typename S> S get_bend_energy(const vec2<S> &omega_i_im1, const vec2<S> &omega_i_im1_equil, const float4 &B_equil);
 
     float get_bend_energy_from_p(
         const float3 &p_im1,
@@ -156,23 +172,24 @@ namespace rod
         const float4 &B_i_equil,
         const float4 &B_im1_equil);
 
-    float get_weights(const float3 &a, const float3 &b);
-    void get_mutual_element_inverse(const float3 &pim1, const float3 &pi, float weight, OUT float3 &mutual_element);
-    void get_mutual_axes_inverse(const float3 &mim1, const float3 &mi, float weight, OUT float3 &m_mutual);
+    template <typename S> S get_weights(const vec3<S> &a, const vec3<S> &b);
+    template <typename S> void get_mutual_element_inverse(const vec3<S> &pim1, const vec3<S> &pi, S weight, OUT vec3<S> &mutual_element);
+    template <typename S> void get_mutual_axes_inverse(const vec3<S> &mim1, const vec3<S> &mi, S weight, OUT vec3<S> &m_mutual);
 
-    float get_bend_energy_mutual_parallel_transport(
-        const float3 &p_im1,
-        const float3 &p_i,
+    template <typename S>
+    S get_bend_energy_mutual_parallel_transport(
+        const vec3<S> &p_im1,
+        const vec3<S> &p_i,
         const float3 &p_im1_equil,
         const float3 &p_i_equil,
-        const float3 &n_im1,
-        float3 &m_im1,
+        const vec3<S> &n_im1,
+        const vec3<S> &m_im1,
         const float3 &n_im1_equil,
-        float3 &m_im1_equil,
-        const float3 &n_i,
-        float3 &m_i,
+        const float3 &m_im1_equil,
+        const vec3<S> &n_i,
+        const vec3<S> &m_i,
         const float3 &n_i_equil,
-        float3 &m_i_equil,
+        const float3 &m_i_equil,
         const float4 &B_i_equil,
         const float4 &B_im1_equil);
 
@@ -185,8 +202,8 @@ namespace rod
     float get_force(float bend_energy, float stretch_energy, float delta_x);
     float get_torque(float twist_energy, float delta_theta);
     float get_delta_r(float friction, float timestep, float force, float noise, float external_force);
-    float get_delta_r(float friction, float timestep, const std::vector<float> &forces);
-    float get_delta_r(float friction, float timestep, const std::vector<float> &forces, float background_flow);
+    float get_delta_r(float friction, float timestep, std::initializer_list<float> forces);
+    float get_delta_r(float friction, float timestep, std::initializer_list<float> forces, float background_flow);
     float get_noise(float timestep, float kT, float friction, float random_number);
 
     /*------------*/
@@ -195,12 +212,12 @@ namespace rod
 
     void load_p(float4x3 &p, const std::vector<float> &r, int offset);
     void load_m(float4x3 &m_loaded, const std::vector<float> &m, int offset);
-    void normalize_all(float4x3 &p);
+    template <typename S> void normalize_all(vec4x3<S> &p);
     void absolute_all(const float4x3 &p, float4 &absolutes);
-    void cross_all(const float4x3 &p, const float4x3 &m, OUT float4x3 &n);
+    template <typename S> void cross_all(const vec4x3<S> &p, const vec4x3<S> &m, OUT vec4x3<S> &n);
     void delta_e_all(const float4x3 &e, const float4x3 &new_e, OUT float4x3 &delta_e);
     // void update_m1_all(float4x3 &m, float4 &absolutes, float4x3 &t, float4x3 &delta_e, OUT float4x3 &m_out); // This doesn't exist?
-    void update_m1_matrix_all(float4x3 &m, const float4x3 &p, const float4x3 &p_prime, OUT float4x3 &m_prime, int start_cutoff, int end_cutoff);
+    template <typename S> void update_m1_matrix_all(const vec4x3<S> &m, const vec4x3<S> &p, const vec4x3<S> &p_prime, OUT vec4x3<S> &m_prime, int start_cutoff, int end_cutoff);
     void fix_m1_all(float4x3 &m, float4x3 &new_t);
     void update_and_fix_m1_all(float4x3 &old_e, float4x3 &new_e, float4x3 &m);
     void set_cutoff_values(int e_i_node_no, int length, OUT int start_cutoff, int end_cutoff);
@@ -235,5 +252,18 @@ namespace rod
         std::vector<float> &m_all_equil,
         float3 &energies);
 
+    void get_energy_gradient(
+        std::vector<float> &B_matrix,
+        std::vector<float> &material_params,
+        int start_cutoff,
+        int end_cutoff,
+        int p_i_node_no,
+        std::vector<float> &r_all,
+        std::vector<float> &r_all_equil,
+        std::vector<float> &m_all,
+        std::vector<float> &m_all_equil,
+        float3 &energies,
+        float4x3 &gradients);
+
 }
 #endif
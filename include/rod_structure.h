@@ -47,7 +47,7 @@ namespace rod
 {
 
     std::vector<float> stof_vec(std::vector<std::string> vec_in, int length);
-    InteractionData get_interaction_data(int elem_id_self, int elem_id_nbr, const std::vector<std::vector<InteractionData>> &nbr_list);
+    const InteractionData &get_interaction_data(int elem_id_self, int elem_id_nbr, const NbrList &nbr_list);
     struct Rod
     {
         /** Rod metadata **/
@@ -103,14 +103,19 @@ namespace rod
         std::vector<int> num_vdw_nbrs;
         std::vector<float> vdw_site_pos;     // Length = num_vdw_sites * 3. Must be a vector since it has to allow for there being no VDW sites on the rod.
         std::vector<float> applied_forces;              /** Another [x,y,z,x,y,z...] array, this one containing the force vectors acting on each node in the rod. **/
+        std::vector<float> internal_forces;             /** [x,y,z,twist,x,y,z,twist...] forces and torques on each node from the stretch, bend and twist energies. **/
+        std::vector<float> random_draws;                /** [x,y,z,twist,x,y,z,twist...] uniform random numbers for the noise on each node, drawn by draw_noise before the step. **/
+        std::vector<float> delta_r;                     /** [x,y,z,x,y,z...] node displacements for the current step, applied once every frame has been updated. **/
+        std::vector<float> element_forces;              /** [x0,y0,z0,x1,y1,z1...] steric or vdw forces on the two nodes of each element, before they are summed onto the nodes. **/
         std::vector<bool> pinned_nodes;                 /** This array is the length of the number of nodes in the rod, and it contains a boolean stating whether that node is pinned (true) or not (false). **/
 
         bool interface_at_start = false;    /** if this is true, the positioning of the start node is being handled by a rod-blob interface, so its energies will be ignored. **/
         bool interface_at_end = false;      /** if this is true, the positioning of the end node is being handled by a rod-blob interface, so its energies will be ignored. **/
         bool restarting = false;            /** If this is true, the rod will skip writing a frame of the trajectory (this is normally done so that the trajectory starts with correct box positioning) **/
+        bool perturbed_energies_due = true; /** If this is true, do_timestep also fills the internal perturbed energy arrays, which are only used by the text trajectory. **/
 
-        std::vector<std::vector<InteractionData>> steric_nbrs; /** Steric interaction neighbour list **/
-        std::vector<std::vector<InteractionData>> vdw_nbrs;
+        NbrList steric_nbrs; /** Steric interaction neighbour list **/
+        NbrList vdw_nbrs;
         std::vector<VDWSite> vdw_sites;  // Attractive van der Waals binding sites that lie along the rod
 
         /** Unit conversion factors - the input\output files are in SI, but internally it uses FFEA's units as determined in dimensions.h **/
@@ -126,38 +131,45 @@ namespace rod
         int step_no = 0;  // ! - redundant?
         Rod(int length, int set_rod_no);
         Rod(std::string path, int set_rod_no);
-        Rod set_units();
-        Rod compute_rest_energy();
-        Rod do_timestep(std::shared_ptr<std::vector<RngStream>> &rng);
-        Rod add_force(const float4 &force, int node_index);
-        Rod pin_node(bool pin_state, int node_index);
-        Rod load_header(std::string filename);
-        Rod load_contents(std::string filename);
-        Rod load_vdw(const std::string filename);
-        Rod write_frame_to_file();
-        Rod write_mat_params_vector(const std::vector<float> &vec, float stretch_scale_factor, float twist_scale_factor, float length_scale_factor);
-        Rod change_filename(std::string new_filename);
-        Rod equilibrate_rod(std::shared_ptr<std::vector<RngStream>> &rng);
-        Rod translate_rod(std::vector<float> &r, const float3 &translation_vec);
-        Rod rotate_rod(const float3 &euler_angles);
-        Rod scale_rod(float scale);
-        Rod get_centroid(const std::vector<float> &r, float3 &centroid);
-        Rod get_min_max(const std::vector<float> &r, OUT float3 &min, float3 &max);
-        Rod get_p(int index, OUT float3 &p, bool equil);
-        Rod get_r(int node_index, OUT float3 &r, bool equil);
+        Rod &set_units();
+        Rod &compute_rest_energy();
+        Rod &do_timestep(std::shared_ptr<std::vector<RngStream>> &rng);
+        Rod &do_timestep();
+        Rod &draw_noise(RngStream &rng);
+        Rod &add_force(const float4 &force, int node_index);
+        Rod &pin_node(bool pin_state, int node_index);
+        Rod &load_header(std::string filename);
+        Rod &load_contents(std::string filename);
+        Rod &load_vdw(const std::string filename);
+        Rod &write_frame_to_file();
+        Rod &write_mat_params_vector(const std::vector<float> &vec, float stretch_scale_factor, float twist_scale_factor, float length_scale_factor);
+        Rod &append_static_data(std::vector<float> &buffer);
+        Rod &append_frame(std::vector<float> &buffer, bool diagnostics);
+        Rod &load_binary_frame(const float *&frame, bool diagnostics);
+        int get_frame_length(bool diagnostics);
+        Rod &change_filename(std::string new_filename);
+        Rod &equilibrate_rod(std::shared_ptr<std::vector<RngStream>> &rng);
+        Rod &translate_rod(std::vector<float> &r, const float3 &translation_vec);
+        Rod &rotate_rod(const float3 &euler_angles);
+        Rod &scale_rod(float scale);
+        void get_centroid(const std::vector<float> &r, float3 &centroid);
+        void get_min_max(const std::vector<float> &r, OUT float3 &min, float3 &max);
+        void get_p(int index, OUT float3 &p, bool equil);
+        void get_r(int node_index, OUT float3 &r, bool equil);
         float get_radius(int node_index);
         float contour_length();
         float end_to_end_length();
-        int get_num_nbrs(int element_index, const std::vector<std::vector<InteractionData>> &nbr_list);
+        int get_num_nbrs(int element_index, const NbrList &nbr_list);
         int get_num_vdw_sites();
         int get_num_nodes();
-        Rod check_nbr_list_dim(std::vector<std::vector<InteractionData>> &nbr_list);
-        void reset_nbr_list(std::vector<std::vector<InteractionData>> &nbr_list);
-        Rod print_node_positions();
-        std::vector<float> net_steric_force_nbrs(int elem_id);
-        std::vector<float> net_vdw_force_nbrs(int elem_id);
+        Rod &check_nbr_list_dim(const NbrList &nbr_list);
+        void reset_nbr_list(NbrList &nbr_list);
+        Rod &print_node_positions();
+        float6 net_steric_force_nbrs(int elem_id);
+        float6 net_vdw_force_nbrs(int elem_id);
         void do_steric();
         void do_vdw();
+        void gather_element_forces(std::vector<float> &node_force);
     };
 
 } //end namespace
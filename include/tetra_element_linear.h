@@ -154,16 +154,8 @@ public:
     /** @brief The 12-vector containing the shape function derivatives for this element */
     vector12 dpsi;
 
-    /** @brief
-     * The del2 matrix for this element (in upper triangular form, since it's symmetric).
-     * Used in constructing the diffusion matrix and the poisson matrix.
-     */
-    upper_triangular_matrix4 del2;
-
-    PoissonMatrixQuadratic K_alpha;
-
-    /** @brief Store the contribution from this element to the force on each of its four nodes */
-    std::array<arr3, NUM_NODES_QUADRATIC_TET> node_force;
+    /** @brief The element force array of the owning Blob (Blob::elem_force), which add_force_to_node() adds to */
+    arr3 *blob_force;
 
     /** @brief The rest volume of this element */
     scalar vol_0;
@@ -174,9 +166,6 @@ public:
     /** @brief The gradient deformation tensor for this element (needed for potential energy calculation) */
     matrix3 F_ij;
 
-    /** @brief The double contraction of the internal stress tensor, including elastic and thermal stresses */
-    scalar internal_stress_mag;
-
     /** @brief The inverse jacobian of this element at rest */
     matrix3 J_inv_0;
 
@@ -191,19 +180,12 @@ public:
 
     arr3 centroid;
 
-    /** @brief
-     * Get the memory location of the specified element of K_alpha
-     */
-    scalar * get_K_alpha_element_mem_loc(int ni, int nj);
-
     /** @brief Calc the diffusion matrix for this element */
-    void calculate_K_alpha();
+    void calculate_K_alpha(PoissonMatrixQuadratic &K_alpha);
 
     void construct_element_mass_matrix(MassMatrixQuadratic &M_alpha);
     void construct_element_mass_matrix(MassMatrixLinear &M_alpha);
 
-    void add_K_alpha(scalar *K, int num_nodes);
-
     /** @brief Returns the gradient of the potential at the given (s,t,u) position in the element */
     void get_grad_phi_at_stu(arr3 &grad_phi, scalar s, scalar t, scalar u);
 
@@ -236,6 +218,7 @@ public:
      * element whose jacobian this is, which is stored in 'vol'.
      */
     bool calc_shape_function_derivatives_and_volume(matrix3 &J);
+    static bool calc_shape_function_derivatives_and_volume(const matrix3 &J, vector12 &dpsi, scalar &last_det, scalar &vol);
 
     /** @brief
      *  Prints a variety of structural details about the element to analyse it's configuration
@@ -252,16 +235,19 @@ public:
      * viscosity constants, and the element volume
      */
     void create_viscosity_matrix();
+    static void create_viscosity_matrix(const vector12 &dpsi, scalar A, scalar B, scalar vol, matrix12 &V);
 
     /*
      *
      */
     void add_shear_elastic_stress(matrix3 &J, matrix3 &stress);
+    static void add_shear_elastic_stress(const matrix3 &J, const matrix3 &J_inv_0, scalar G, scalar vol_0, scalar vol, matrix3 &F_ij, matrix3 &stress);
 
     /*
      *
      */
     void add_bulk_elastic_stress(matrix3 &stress);
+    static void add_bulk_elastic_stress(scalar G, scalar E, scalar vol_0, scalar vol, matrix3 &stress);
 
     /** @brief
      * Given the shape function derivatives, the element volume and a random number generator, this
@@ -272,22 +258,28 @@ public:
      */
     void add_fluctuating_stress(const SimulationParams &params, std::shared_ptr<std::vector<RngStream>> &rng, matrix3 &stress, int thread_id);
 
+    /** @brief
+     * As above, for an element of volume vol whose noise prefactors sqrt(A), sqrt(2A) and sqrt(B)
+     * have already been worked out.
+     */
+    static void add_fluctuating_stress(const SimulationParams &params, std::shared_ptr<std::vector<RngStream>> &rng, scalar vol, scalar sqrt_A, scalar sqrt_2A, scalar sqrt_B, matrix3 &stress, int thread_id);
+
     /** @brief
      * Applies the given stress tensor to the shape function derivatives to get the contribution to du
      */
     void apply_stress_tensor(matrix3 &stress, vector12 &du);
+    static void apply_stress_tensor(const vector12 &dpsi, scalar vol, const matrix3 &stress, vector12 &du);
 
     /** @brief
      * Sets the given 12-vector to the velocities of this element's four nodes,
+     * looked up in the given (Blob) velocity array
      */
-    void get_element_velocity_vector(vector12 &v);
+    void get_element_velocity_vector(const std::vector<arr3> &vel, vector12 &v);
 
     /** @brief
-     * Add this element's nodal forces to those given in the force 12-vector
+     * Add given force to the specified node of this element (atomically, as other elements
+     * sharing the node may be doing the same)
      */
-    void add_element_force_vector(vector12 &force);
-
-    /** @brief Add given force to the specified node of this element */
     void add_force_to_node(int i, arr3 &f);
 
     /** @brief A roundabout and inefficient way of working out what node (from 0 to 9) this index corresponds to */
@@ -304,8 +296,6 @@ public:
 
     void volume_coord_to_xyz(scalar eta0, scalar eta1, scalar eta2, scalar eta3, arr3 &r);
 
-    void zero_force();
-
     void linearise_element();
 
     void calc_centroid();
@@ -316,17 +306,20 @@ public:
 
 private:
 
+    friend class TetraElementBlock;
+
     /** @brief
      * The last determinant of this element's transformation (used to work out whether it has inverted itself)
      */
     scalar last_det;
 
     /** @brief
-     * Creates del2 matrix from the shape function derivatives
+     * Creates the del2 matrix (in upper triangular form, since it's symmetric) from the shape
+     * function derivatives. Used in constructing the diffusion matrix.
      */
-    void calc_del2_matrix();
+    static void calc_del2_matrix(const vector12 &dpsi, upper_triangular_matrix4 &del2);
 
-    void add_diffusion_matrix(matrix12 &V);
+    static void add_diffusion_matrix(const upper_triangular_matrix4 &del2, scalar A, matrix12 &V);
 
     struct tetrahedron_gauss_point {
         scalar W;
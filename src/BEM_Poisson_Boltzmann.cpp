@@ -55,6 +55,8 @@ BEM_Poisson_Boltzmann::~BEM_Poisson_Boltzmann() {
 
 void BEM_Poisson_Boltzmann::init(NearestNeighbourLinkedListCube *lookup) {
     this->lookup = lookup;
+
+    // The matrices are indexed by pool index, so they cover every face, active or not
     this->num_faces = lookup->get_pool_size();
 
     /* Create and initialise our sparse matrices */
@@ -84,15 +86,20 @@ void BEM_Poisson_Boltzmann::build_BEM_matrices() {
     mat_C->zero();
     mat_D->zero();
 
-    /* For each face, calculate the interaction with all other relevant faces and add the contribution to mat_C and mat_D */
+    /* Matrix C diagonal (self term) for constant element case. Set on every row, so that the rows of inactive faces stay solvable */
     for (int i = 0; i < num_faces; i++) {
+        mat_C->set_diagonal_element(i, -.5 * 4.0 * M_PI);
+    }
 
-        // get the ith face
-        LinkedListNode<Face> *l_i = lookup->get_from_pool(i);
-        Face *f = l_i->obj;
+    /* For each active face, calculate the interaction with all other relevant faces and add the contribution to mat_C and mat_D.
+     * Faces of inactive conformations are not on the lookup grid, so they take no part */
+    int num_active_faces = lookup->get_num_active();
+    for (int n = 0; n < num_active_faces; n++) {
 
-        // Create matrix C diagonal (self term) for constant element case
-        mat_C->set_diagonal_element(i, -.5 * 4.0 * M_PI);
+        // get the nth active face
+        LinkedListNode<Face> *l_i = lookup->get_active_from_pool(n);
+        Face *f = l_i->obj;
+        int i = l_i->index;
 
         // Create matrix D diagonal (self term) for constant element case
         mat_D->set_diagonal_element(i, -(self_term(f->centroid, f->n[1]->pos, f->n[2]->pos, 6) +
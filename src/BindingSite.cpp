@@ -233,3 +233,111 @@ bool BindingSite::sites_in_range(BindingSite a, BindingSite b) {
 		return false;
 	}
 }
+
+void BindingSite_hash::clear() {
+	entries.clear();
+}
+
+/** Sites must be added in order of blob, then site index */
+void BindingSite_hash::add_site(int blob_index, BindingSite *site) {
+	Entry entry;
+	entry.site = site;
+	entry.blob_index = blob_index;
+	site->calculate_characteristic_length();
+	site->calculate_centroid();
+	site->get_centroid(entry.centroid);
+	entry.characteristic_length = site->get_characteristic_length();
+	entries.push_back(entry);
+}
+
+void BindingSite_hash::build(int num_blobs) {
+
+	// Where each blob starts
+	blob_start.assign(num_blobs + 1, 0);
+	for(const Entry &entry : entries) {
+		blob_start[entry.blob_index + 1]++;
+	}
+	for(int i = 0; i < num_blobs; ++i) {
+		blob_start[i + 1] += blob_start[i];
+	}
+
+	// Cells big enough to hold the largest binding range
+	scalar max_length = 0.0;
+	for(const Entry &entry : entries) {
+		max_length = max(max_length, entry.characteristic_length);
+	}
+	cell_size = 2 * max_length;
+	if(cell_size <= 0) {
+		cell_size = 1;
+	}
+
+	// Bucket the entries, counting sort style
+	int num_buckets = 1;
+	while(num_buckets < 2 * (int)entries.size()) {
+		num_buckets *= 2;
+	}
+	bucket_start.assign(num_buckets + 1, 0);
+	vector<int> entry_bucket(entries.size());
+	for(int i = 0; i < entries.size(); ++i) {
+		entries[i].cell = get_cell(entries[i].centroid);
+		entry_bucket[i] = get_bucket(entries[i].cell);
+		bucket_start[entry_bucket[i] + 1]++;
+	}
+	for(int b = 0; b < num_buckets; ++b) {
+		bucket_start[b + 1] += bucket_start[b];
+	}
+	bucket_entries.resize(entries.size());
+	vector<int> fill(bucket_start.begin(), bucket_start.end() - 1);
+	for(int i = 0; i < entries.size(); ++i) {
+		bucket_entries[fill[entry_bucket[i]]++] = i;
+	}
+}
+
+std::array<long long, 3> BindingSite_hash::get_cell(const arr3 &pos) {
+	return {(long long)floor(pos[0] / cell_size), (long long)floor(pos[1] / cell_size), (long long)floor(pos[2] / cell_size)};
+}
+
+int BindingSite_hash::get_bucket(const std::array<long long, 3> &cell) {
+	unsigned long long h = (unsigned long long)cell[0] * 73856093ULL ^ (unsigned long long)cell[1] * 19349663ULL ^ (unsigned long long)cell[2] * 83492791ULL;
+	return (int)(h & (bucket_start.size() - 2));
+}
+
+/**
+ * Find the first site (lowest blob index, then lowest site index) of type
+ * target_type on another blob that is in range of the given site, using the
+ * same test as BindingSite::sites_in_range. Returns the entry, or -1 if
+ * there are none.
+ */
+int BindingSite_hash::find_first_in_range(int blob_index, int site_index, int target_type) {
+	const Entry &base = entries[blob_start[blob_index] + site_index];
+	int first = -1;
+	for(long long dx = -1; dx <= 1; ++dx) {
+		for(long long dy = -1; dy <= 1; ++dy) {
+			for(long long dz = -1; dz <= 1; ++dz) {
+				std::array<long long, 3> cell = {base.cell[0] + dx, base.cell[1] + dy, base.cell[2] + dz};
+				int b = get_bucket(cell);
+				for(int k = bucket_start[b]; k < bucket_start[b + 1]; ++k) {
+					int i = bucket_entries[k];
+					const Entry &target = entries[i];
+
+					// Buckets can be shared, so skip other cells and anything already beaten
+					if(target.cell != cell || (first != -1 && i >= first)) {
+						continue;
+					}
+					if(target.blob_index == blob_index || target.site->get_type() != target_type) {
+						continue;
+					}
+					scalar separation = sqrt(pow(base.centroid[0] - target.centroid[0], 2) + pow(base.centroid[1] - target.centroid[1], 2) + pow(base.centroid[2] - target.centroid[2], 2));
+					if(separation < base.characteristic_length + target.characteristic_length) {
+						first = i;
+					}
+				}
+			}
+		}
+	}
+	return first;
+}
+
+BindingSite* BindingSite_hash::get_site(int entry) {
+	return entries[entry].site;
+}
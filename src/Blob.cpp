@@ -158,7 +158,7 @@ void Blob::config(const int _blob_index, const int _conformation_index, const st
     this->linear_solver = _linear_solver;
 }
 
-void Blob::init(){
+void Blob::init(bool with_solver){
     //Load the node, topology, surface, materials and stokes parameter files.
     load_nodes(s_node_filename.c_str(), scale);
 
@@ -199,21 +199,28 @@ void Blob::init(){
         pinned_nodes_list.clear();
     }
 
-    // Linearise all the elements
+    // Linearise all the elements, and note which two linear nodes each second order node sits between
+    const int edge_nodes[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}}; // as in linearise_element()
+    midpoint_parents = std::vector<std::array<int, 2>>(node.size(), {-1, -1});
     for (auto &elem_i : elem) {
         elem_i.linearise_element();
+        for (int j = NUM_NODES_LINEAR_TET; j < NUM_NODES_QUADRATIC_TET; ++j) {
+            if (!elem_i.n[j]->am_I_linear()) {
+                midpoint_parents[elem_i.n[j]->index] = {elem_i.n[edge_nodes[j - NUM_NODES_LINEAR_TET][0]]->index,
+                                                        elem_i.n[edge_nodes[j - NUM_NODES_LINEAR_TET][1]]->index};
+            }
+        }
     }
 
     // Get the rest jacobian, rest volume etc. of this Blob and store it for later use
     calc_rest_state_info();
 
-    // Calculate the connectivity of the mesh, giving each node a list of pointers to elements
-    // it is a member of. The pointers will be to the exact memory location in that element's struct
-    // in which can be found the contribution to the force on that node.
+    // Colour the elements and copy their per-step data into the element block. Only the linear
+    // nodes receive a force from the element loop unless electrostatics are on.
     if (blob_state == FFEA_BLOB_IS_DYNAMIC) {
-        printf("\t\tCalculating node-element connectivity...");
-        calculate_node_element_connectivity();
-        printf("\t\tdone\n");
+        printf("\t\tColouring elements...");
+        elem_block.init(elem, (params.calc_es == 1) ? NUM_NODES_QUADRATIC_TET : NUM_NODES_LINEAR_TET);
+        printf("\t\tdone (%d colours)\n", elem_block.get_num_colours());
 
         // Run a check on parameters that are dependent upon the solver type
         if((params.calc_stokes == 0 && params.calc_noise == 0) && (params.calc_springs == 1 || params.calc_ctforces == 1)) {
@@ -222,34 +229,28 @@ void Blob::init(){
             }
         }
 
-    // Create the chosen linear equation Solver for this Blob
-	// Only initialise for dynamic blobs. Static don not need to be mechanically solved
-	if (blob_state == FFEA_BLOB_IS_DYNAMIC) {
-		if (linear_solver == FFEA_DIRECT_SOLVER) {
-		    solver = std::make_unique<SparseSubstitutionSolver>();
-		    mass_in_blob = true;
-		} else if (linear_solver == FFEA_ITERATIVE_SOLVER) {
-		    solver = std::make_unique<ConjugateGradientSolver>();
-		    mass_in_blob = true;
-		} else if (linear_solver == FFEA_MASSLUMPED_SOLVER) {
-		    solver = std::make_unique<MassLumpedSolver>();
-		    mass_in_blob = true;
-		} else if (linear_solver == FFEA_NOMASS_CG_SOLVER) {
-		    solver = std::make_unique<NoMassCGSolver>();
-		} else {
-		    throw FFEAException("Error in Blob initialisation: linear_solver=%d is not a valid solver choice\n", linear_solver);
-		}
-		if (!solver) throw FFEAException("No solver to work with");
-	}
+        // Check the solver choice now, even if the Solver itself is built later
+        if (linear_solver == FFEA_DIRECT_SOLVER || linear_solver == FFEA_ITERATIVE_SOLVER || linear_solver == FFEA_MASSLUMPED_SOLVER) {
+            mass_in_blob = true;
+        } else if (linear_solver != FFEA_NOMASS_CG_SOLVER) {
+            throw FFEAException("Error in Blob initialisation: linear_solver=%d is not a valid solver choice\n", linear_solver);
+        }
 
-        // Initialise the Solver (whatever it may be)
-        printf("\t\tBuilding solver:\n");
-        solver->init(node, elem, params, pinned_nodes_list, bsite_pinned_nodes_list);
+        // Create and initialise the chosen linear equation Solver for this Blob,
+        // unless that has been left until this conformation is first used
+        if (with_solver) {
+            printf("\t\tBuilding solver:\n");
+            build_solver();
+        }
     }
 
 
-    // Allocate the force vector array for the whole Blob
+    // Allocate the force vector array for the whole Blob, and the one the elements add their forces to
     force = std::vector<arr3>(node.size(), { 0,0,0 });
+    elem_force = std::vector<arr3>(node.size(), { 0,0,0 });
+    for (auto &elem_i : elem) {
+        elem_i.blob_force = elem_force.data();
+    }
 
     // Calculate how many faces each surface node is a part of
     num_contributing_faces = std::vector<int>(num_surface_nodes, 0);
@@ -282,14 +283,15 @@ void Blob::init(){
         sparsity_pattern_knowns.init(num_interior_nodes);
         sparsity_pattern_unknowns.init(num_interior_nodes);
 
-        for (auto &el : elem) {
+        K_alpha = std::vector<PoissonMatrixQuadratic>(elem.size());
+        for (int el = 0; el < elem.size(); ++el) {
             for (int ni = 0; ni < 10; ++ni) {
                 for (int nj = 0; nj < 10; ++nj) {
 
-                    const int ni_index = el.n[ni]->index;
-                    const int nj_index = el.n[nj]->index;
+                    const int ni_index = elem[el].n[ni]->index;
+                    const int nj_index = elem[el].n[nj]->index;
 
-                    scalar *mem_loc = el.get_K_alpha_element_mem_loc(ni, nj);
+                    scalar *mem_loc = K_alpha[el].get_K_alpha_mem_loc(ni, nj);
 
                     /* We don't care about rows of the matrix before row num_surface_nodes */
                     if (ni_index >= num_surface_nodes) {
@@ -410,15 +412,16 @@ void Blob::update_internal_forces() {
         apply_ctforces();
 
     /* some "work" variables */
-    matrix3 J; // Holds the Jacobian calculated for the *current* element being processed
-    matrix3 stress; // Holds the current stress tensor (elastic stress, with thermal fluctuations)
-    vector12 du; // Holds the force change for the current element
+    TetraElementBatch batch; // Holds the shape function derivatives, stress forces etc. of the *current* batch of elements
+    vector12 dpsi; // Holds the shape function derivatives of the current element
     int tid; // Holds the current thread id (in parallel regions)
     int num_inversions = 0; // Counts the number of elements that have inverted (if > 0 then simulation has failed)
 
-    // Element loop
+    // Element loop, over batches of elements. This only reads the element block; the elements themselves
+    // are only touched to write the viscosity matrices referenced by the CG_nomass solver, and for electrostatics.
+    // The batches of each colour share no nodes, so they add their forces straight onto elem_force.
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
-    #pragma omp parallel default(none) private(J, stress, du, tid) reduction(+:num_inversions)
+    #pragma omp parallel default(none) private(batch, dpsi, tid) reduction(+:num_inversions)
     {
 #endif
 #ifdef USE_OPENMP
@@ -427,53 +430,47 @@ void Blob::update_internal_forces() {
         tid = 0;
 #endif
 
+        for (int c = 0; c < elem_block.get_num_colours(); c++) {
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
-        #pragma omp for schedule(guided)
+            #pragma omp for schedule(guided)
 #endif
-        for (int n = 0; n < elem.size(); n++) {
+            for (int b = elem_block.get_colour_start(c); b < elem_block.get_colour_start(c + 1); b++) {
+                const int begin = elem_block.get_batch_start(b);
+                const int end = elem_block.get_batch_start(b + 1);
 
-            // calculate jacobian for this element
-            elem[n].calculate_jacobian(J);
-
-            // get the 12 derivatives of the shape functions (by inverting the jacobian)
-            // and also get the element volume. The function returns an error in the
-            // case of an element inverting itself (determinant changing sign since last step)
-            if (elem[n].calc_shape_function_derivatives_and_volume(J)) {
-                FFEA_error_text();
-                printf("Element %d has inverted during update\n", n);
-	            num_inversions++;
-            }
-
-            // create viscosity matrix
-            elem[n].create_viscosity_matrix();
-
-            // Now build the stress tensor from the shear elastic, bulk elastic and fluctuating stress contributions
-            initialise(stress);
-            elem[n].add_shear_elastic_stress(J, stress);
-            elem[n].add_bulk_elastic_stress(stress);
-
-            if (params.calc_noise == 1) {
-                elem[n].add_fluctuating_stress(params, rng, stress, tid);
-            }
+                if (params.calc_noise == 1) {
+                    elem_block.draw_noise(begin, end, rng, tid, batch);
+                }
 
-            elem[n].internal_stress_mag = sqrt(mat3_double_contraction_symmetric(stress));
+                // get the jacobians, the 12 derivatives of the shape functions and the volumes of the whole
+                // batch, then its elastic, fluctuating and (unless the solver handles it) viscous stresses and
+                // the force from them. This also finds any elements that have inverted themselves (determinant
+                // changing sign since last step)
+                if (elem_block.calc_stress_forces(begin, end, node, vel, params, linear_solver != FFEA_NOMASS_CG_SOLVER, batch) != 0) {
+                    for (int s = begin; s < end; s++) {
+                        if (batch.inverted[s - begin]) {
+                            FFEA_error_text();
+                            printf("Element %d has inverted during update\n", elem_block.get_element(s));
+                            num_inversions++;
+                        }
+                    }
+                }
 
-            // Calculate internal forces of current element (or don't, depending on solver)
-            if (linear_solver != FFEA_NOMASS_CG_SOLVER) {
-                elem[n].get_element_velocity_vector(du);
-                mat12_apply(elem[n].viscosity_matrix, du);
-            } else {
-                initialise(du);
-            }
+                elem_block.add_element_force_vectors(begin, end, batch, elem_force);
 
-            elem[n].apply_stress_tensor(stress, du);
+                for (int s = begin; s < end; s++) {
+                    const int n = elem_block.get_element(s);
 
-            // Store the contributions to the force on each of this element's nodes (Store them on
-            // the element - they will be aggregated on the actual nodes outside of this parallel region)
-            elem[n].add_element_force_vector(du);
+                    // The CG_nomass solver applies the viscosity matrices itself, so it needs them rebuilt
+                    if (linear_solver == FFEA_NOMASS_CG_SOLVER) {
+                        batch.get_dpsi(s - begin, dpsi);
+                        elem_block.create_viscosity_matrix(s, dpsi, elem[n].viscosity_matrix);
+                    }
 
-            if (params.calc_es == 1) {
-                elem[n].calculate_electrostatic_forces();
+                    if (params.calc_es == 1) {
+                        elem[n].calculate_electrostatic_forces();
+                    }
+                }
             }
         }
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
@@ -491,9 +488,11 @@ void Blob::update_internal_forces() {
 }
 
 void Blob::update_positions() {
-    // Aggregate forces on nodes from all elements (if not static)
+    // Forces are zeroed as they are used up, so a Blob that doesn't move simply discards them
     if (get_motion_state() != FFEA_BLOB_IS_DYNAMIC) {
-	    return;
+        zero_force();
+        set_forces_to_zero();
+        return;
     }
 
     aggregate_forces_and_solve();
@@ -501,10 +500,37 @@ void Blob::update_positions() {
     // Update node velocities and positions
     euler_integrate();
 
-    // Linearise the 2nd order elements
-    for (int n = 0; n < elem.size(); n++) {
-        elem[n].linearise_element();
+    // Linearise the 2nd order elements, and get the centroid and bounds for the start of the next step
+    calc_centroid_and_bounds(true);
+}
+
+void Blob::build_solver() {
+    // Only dynamic blobs are mechanically solved, and there is nothing to do if the Solver is already built
+    if (blob_state != FFEA_BLOB_IS_DYNAMIC || solver) {
+        return;
+    }
+
+    if (linear_solver == FFEA_DIRECT_SOLVER) {
+        solver = std::make_unique<SparseSubstitutionSolver>();
+    } else if (linear_solver == FFEA_ITERATIVE_SOLVER) {
+        solver = std::make_unique<ConjugateGradientSolver>();
+    } else if (linear_solver == FFEA_MASSLUMPED_SOLVER) {
+        solver = std::make_unique<MassLumpedSolver>();
+    } else {
+        solver = std::make_unique<NoMassCGSolver>();
     }
+    if (!solver) throw FFEAException("No solver to work with");
+
+    // Initialise the Solver (whatever it may be). This can happen mid-run, on a kinetic switch, so it is not announced here
+    solver->init(node, elem, params, pinned_nodes_list, bsite_pinned_nodes_list);
+}
+
+void Blob::release_solver() {
+    solver.reset();
+}
+
+bool Blob::has_solver() const {
+    return solver != nullptr;
 }
 
 void Blob::reset_solver() {
@@ -524,6 +550,7 @@ void Blob::translate_linear(const std::vector<arr3> &vec) {
     }
 
     // Translate linear nodes
+    node_bounds_valid = false;
     for(int i = 0; i < num_linear_nodes; ++i) {
         node[map[i]].pos[0] += vec[i][0];
         node[map[i]].pos[1] += vec[i][1];
@@ -566,6 +593,7 @@ void Blob::rotate(const scalar r11, const scalar r12, const scalar r13, const sc
     scalar z;
 
     get_centroid(com);
+    node_bounds_valid = false;
 
     // Move all nodes to the origin:
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
@@ -637,6 +665,7 @@ arr3 Blob::position(const scalar x, const scalar y, const scalar z) {
     v[2] = z - centroid_z;
 
     // Move all nodes in mesh by displacement vector
+    node_bounds_valid = false;
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
     #pragma omp parallel for default(none) shared(v)
 #endif
@@ -659,6 +688,7 @@ void Blob::position_beads(const scalar x, const scalar y, const scalar z) {
 }
 
 void Blob::move(const scalar dx, const scalar dy, const scalar dz) {
+    node_bounds_valid = false;
     for (auto& n : node) {
         n.pos[0] += dx;
         n.pos[1] += dy;
@@ -705,11 +735,38 @@ void Blob::get_centroid(arr3 &com) {
 }
 
 void Blob::calc_and_store_centroid(arr3 &com) {
-    get_centroid(com);
+    if (!node_bounds_valid) {
+        calc_centroid_and_bounds(false);
+    }
+    store(CoG, com);
+}
 
-    CoG[0] = com[0];
-    CoG[1] = com[1];
-    CoG[2] = com[2];
+void Blob::calc_centroid_and_bounds(bool linearise) {
+    arr3 sum = {0, 0, 0};
+    surface_min.fill(std::numeric_limits<scalar>::max());
+    surface_max.fill(std::numeric_limits<scalar>::lowest());
+    for (int i = 0; i < node.size(); ++i) {
+        arr3 &pos = node[i].pos;
+        if (linearise && midpoint_parents[i][0] != -1) {
+            const arr3 &pos_a = node[midpoint_parents[i][0]].pos, &pos_b = node[midpoint_parents[i][1]].pos;
+            pos[0] = .5 * (pos_a[0] + pos_b[0]);
+            pos[1] = .5 * (pos_a[1] + pos_b[1]);
+            pos[2] = .5 * (pos_a[2] + pos_b[2]);
+        }
+        sum[0] += pos[0];
+        sum[1] += pos[1];
+        sum[2] += pos[2];
+        if (i < num_surface_nodes) {
+            for (int j = 0; j < 3; ++j) {
+                surface_min[j] = std::min(surface_min[j], pos[j]);
+                surface_max[j] = std::max(surface_max[j], pos[j]);
+            }
+        }
+    }
+    CoG[0] = sum[0] / node.size();
+    CoG[1] = sum[1] / node.size();
+    CoG[2] = sum[2] / node.size();
+    node_bounds_valid = true;
 }
 
 // This one returns an array rather than arsing about with pointers
@@ -730,6 +787,8 @@ arr3 Blob::calc_centroid() const {
 }
 
 std::vector<arr3 *> &Blob::get_actual_node_positions() {
+    // The caller can move the nodes through these pointers
+    node_bounds_valid = false;
     return node_position;
 }
 
@@ -742,6 +801,7 @@ void Blob::copy_node_positions(std::vector<arr3*> &nodes) {
 }
 
 void Blob::set_node_positions(const std::vector<arr3*> &node_pos) {
+    node_bounds_valid = false;
     for (size_t i = 0; i < node.size(); ++i) {
         node[i].pos[0] = (*node_pos[i])[0];
         node[i].pos[1] = (*node_pos[i])[1];
@@ -867,7 +927,7 @@ void Blob::write_nodes_to_file(FILE *trajectory_out) const {
         for (size_t i = 0; i < node.size(); i++) {
             fprintf(trajectory_out, "%e %e %e %e %e %e %e %e %e %e\n",
                     node[i].pos[0]*mesoDimensions::length, node[i].pos[1]*mesoDimensions::length, node[i].pos[2]*mesoDimensions::length,
-                    node[i].vel[0]*mesoDimensions::velocity, node[i].vel[1]*mesoDimensions::velocity, node[i].vel[2]*mesoDimensions::velocity,
+                    vel[i][0]*mesoDimensions::velocity, vel[i][1]*mesoDimensions::velocity, vel[i][2]*mesoDimensions::velocity,
                     node[i].phi,
                     force[i][0]*mesoDimensions::force, force[i][1]*mesoDimensions::force, force[i][2]*mesoDimensions::force);
         }
@@ -945,9 +1005,9 @@ void Blob::pre_print() {
             toBePrinted_nodes[10*i   ] = node[i].pos[0]*mesoDimensions::length;
             toBePrinted_nodes[10*i +1] = node[i].pos[1]*mesoDimensions::length;
             toBePrinted_nodes[10*i +2] = node[i].pos[2]*mesoDimensions::length;
-            toBePrinted_nodes[10*i +3] = node[i].vel[0]*mesoDimensions::velocity;
-            toBePrinted_nodes[10*i +4] = node[i].vel[1]*mesoDimensions::velocity;
-            toBePrinted_nodes[10*i +5] = node[i].vel[2]*mesoDimensions::velocity;
+            toBePrinted_nodes[10*i +3] = vel[i][0]*mesoDimensions::velocity;
+            toBePrinted_nodes[10*i +4] = vel[i][1]*mesoDimensions::velocity;
+            toBePrinted_nodes[10*i +5] = vel[i][2]*mesoDimensions::velocity;
             toBePrinted_nodes[10*i +6] = node[i].phi;
             toBePrinted_nodes[10*i +7] = force[i][0]*mesoDimensions::force;
             toBePrinted_nodes[10*i +8] = force[i][1]*mesoDimensions::force;
@@ -999,21 +1059,25 @@ void Blob::read_nodes_from_file(FILE *trajectory_out) {
     }
 
     for (int i = 0; i < node.size(); i++) {
-        if (fscanf(trajectory_out, "%le %le %le %le %le %le %le %le %le %le\n", &node[i].pos[0], &node[i].pos[1], &node[i].pos[2], &node[i].vel[0], &node[i].vel[1], &node[i].vel[2], &node[i].phi, &force[i][0], &force[i][1], &force[i][2]) != 10) {
+        if (fscanf(trajectory_out, "%le %le %le %le %le %le %le %le %le %le\n", &node[i].pos[0], &node[i].pos[1], &node[i].pos[2], &vel[i][0], &vel[i][1], &vel[i][2], &node[i].phi, &force[i][0], &force[i][1], &force[i][2]) != 10) {
             throw FFEAException("(When restarting) Error reading from trajectory file, for node %d", i);
         } else {
             node[i].pos[0] /= mesoDimensions::length;
             node[i].pos[1] /= mesoDimensions::length;
             node[i].pos[2] /= mesoDimensions::length;
-            node[i].vel[0] /= mesoDimensions::velocity;
-            node[i].vel[1] /= mesoDimensions::velocity;
-            node[i].vel[2] /= mesoDimensions::velocity;
+            vel[i][0] /= mesoDimensions::velocity;
+            vel[i][1] /= mesoDimensions::velocity;
+            vel[i][2] /= mesoDimensions::velocity;
             force[i][0] /= mesoDimensions::force;
             force[i][1] /= mesoDimensions::force;
             force[i][2] /= mesoDimensions::force;
         }
 
     }
+
+    // The forces are only read for the record: each step starts from zero force
+    set_forces_to_zero();
+    node_bounds_valid = false;
 }
 
 void Blob::calculate_deformation() {
@@ -1082,24 +1146,24 @@ void Blob::make_measurements() {
              */
             vector12 vec;
             // Read the u vector for this element
-            elem[n].get_element_velocity_vector(vec);
+            elem[n].get_element_velocity_vector(vel, vec);
 
             // Apply the mass matrix
             elem[n].apply_element_mass_matrix(vec);
 
             // Dot u with M.u to get the contribution to the kinetic energy
-            kenergy += elem[n].n[0]->vel[0] * vec[0] +
-                       elem[n].n[1]->vel[0] * vec[1] +
-                       elem[n].n[2]->vel[0] * vec[2] +
-                       elem[n].n[3]->vel[0] * vec[3] +
-                       elem[n].n[0]->vel[1] * vec[4] +
-                       elem[n].n[1]->vel[1] * vec[5] +
-                       elem[n].n[2]->vel[1] * vec[6] +
-                       elem[n].n[3]->vel[1] * vec[7] +
-                       elem[n].n[0]->vel[2] * vec[8] +
-                       elem[n].n[1]->vel[2] * vec[9] +
-                       elem[n].n[2]->vel[2] * vec[10] +
-                       elem[n].n[3]->vel[2] * vec[11];
+            kenergy += vel[elem[n].n[0]->index][0] * vec[0] +
+                       vel[elem[n].n[1]->index][0] * vec[1] +
+                       vel[elem[n].n[2]->index][0] * vec[2] +
+                       vel[elem[n].n[3]->index][0] * vec[3] +
+                       vel[elem[n].n[0]->index][1] * vec[4] +
+                       vel[elem[n].n[1]->index][1] * vec[5] +
+                       vel[elem[n].n[2]->index][1] * vec[6] +
+                       vel[elem[n].n[3]->index][1] * vec[7] +
+                       vel[elem[n].n[0]->index][2] * vec[8] +
+                       vel[elem[n].n[1]->index][2] * vec[9] +
+                       vel[elem[n].n[2]->index][2] * vec[10] +
+                       vel[elem[n].n[3]->index][2] * vec[11];
         }
 
         /*
@@ -1107,8 +1171,9 @@ void Blob::make_measurements() {
          */
 
         const scalar C = elem[n].E - (2.0 / 3.0) * elem[n].G;
-        const scalar temp1 = elem[n].vol / elem[n].vol_0;
-        senergy += elem[n].vol_0 * (elem[n].G * (mat3_double_contraction(elem[n].F_ij) - 3) + 0.5 * C * (temp1*temp1 - 1) - (C + 2 * elem[n].G) * log(temp1));
+        const int s = elem_block.get_slot(n);
+        const scalar temp1 = elem_block.vol[s] / elem[n].vol_0;
+        senergy += elem[n].vol_0 * (elem[n].G * (mat3_double_contraction(elem_block.F_ij[s]) - 3) + 0.5 * C * (temp1*temp1 - 1) - (C + 2 * elem[n].G) * log(temp1));
     }
 
     // And don't forget to multiply by a half
@@ -1146,9 +1211,9 @@ void Blob::make_measurements() {
             scalar temp3 = 0;
             for (int i = 0; i < 4; i++) {
                 for (int j = 0; j < 4; j++) {
-                    temp1 += MM[i][j] * (r[j][1] * elem[n].n[i]->vel[2] - r[j][2] * elem[n].n[i]->vel[1]);
-                    temp2 += MM[i][j] * (r[j][2] * elem[n].n[i]->vel[0] - r[j][0] * elem[n].n[i]->vel[2]);
-                    temp3 += MM[i][j] * (r[j][0] * elem[n].n[i]->vel[1] - r[j][1] * elem[n].n[i]->vel[0]);
+                    temp1 += MM[i][j] * (r[j][1] * vel[elem[n].n[i]->index][2] - r[j][2] * vel[elem[n].n[i]->index][1]);
+                    temp2 += MM[i][j] * (r[j][2] * vel[elem[n].n[i]->index][0] - r[j][0] * vel[elem[n].n[i]->index][2]);
+                    temp3 += MM[i][j] * (r[j][0] * vel[elem[n].n[i]->index][1] - r[j][1] * vel[elem[n].n[i]->index][0]);
                 }
             }
 
@@ -1217,7 +1282,7 @@ void Blob::make_stress_measurements(FILE *stress_out, int blob_number) {
     if (stress_out != nullptr) {
         fprintf(stress_out, "blob\t%d\n", blob_number);
         for (n = 0; n < elem.size(); n++) {
-            fprintf(stress_out, "%e\n", elem[n].internal_stress_mag);
+            fprintf(stress_out, "%e\n", elem_block.internal_stress_mag[elem_block.get_slot(n)]);
         }
         fprintf(stress_out, "\n");
     }
@@ -1743,12 +1808,12 @@ void Blob::apply_ctforces() {
 /*
  */
 void Blob::zero_force() {
-    for (int i = 0; i < elem.size(); i++) {
-        elem[i].zero_force();
-    }
     for (int i = 0; i < surface.size(); i++) {
         surface[i].zero_force();
     }
+    for (auto &f : elem_force) {
+        f.fill(0);
+    }
 }
 
 void Blob::set_forces_to_zero() {
@@ -1774,10 +1839,10 @@ void Blob::add_force_to_node(const arr3& f, int index) {
 }
 
 void Blob::velocity_all(scalar vel_x, scalar vel_y, scalar vel_z) {
-    for (auto &node_i : node) {
-        node_i.vel[0] = vel_x;
-        node_i.vel[1] = vel_y;
-        node_i.vel[2] = vel_z;
+    for (auto &vel_i : vel) {
+        vel_i[0] = vel_x;
+        vel_i[1] = vel_y;
+        vel_i[2] = vel_z;
     }
 }
 
@@ -1785,7 +1850,7 @@ void Blob::build_poisson_matrices() {
     if (num_interior_nodes > 0) {
         /* Calculate the K_alpha matrices for each element (the diffusion matrix * epsilon * volume) */
         for (int n = 0; n < elem.size(); n++) {
-            elem[n].calculate_K_alpha();
+            elem[n].calculate_K_alpha(K_alpha[n]);
         }
         /* Construct the poisson matrices for the current blob (based on diffusion matrices of elements) */
         poisson_surface_matrix->build();
@@ -1798,45 +1863,45 @@ scalar Blob::get_mass() const {
 }
 
 void Blob::enforce_box_boundaries(arr3 &box_dim) {
-    if (params.wall_x_1 == WALL_TYPE_HARD) {
+    if (params.wall_x_1 == WALL_TYPE_HARD && (!node_bounds_valid || surface_min[0] < 0)) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[0] < 0 && node[i].vel[0] < 0) {
-                node[i].vel[0] = 0;
+            if (node[i].pos[0] < 0 && vel[i][0] < 0) {
+                vel[i][0] = 0;
             }
         }
     }
-    if (params.wall_x_2 == WALL_TYPE_HARD) {
+    if (params.wall_x_2 == WALL_TYPE_HARD && (!node_bounds_valid || surface_max[0] > box_dim[0])) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[0] > box_dim[0] && node[i].vel[0] > 0) {
-                node[i].vel[0] = 0;
+            if (node[i].pos[0] > box_dim[0] && vel[i][0] > 0) {
+                vel[i][0] = 0;
             }
         }
     }
-    if (params.wall_y_1 == WALL_TYPE_HARD) {
+    if (params.wall_y_1 == WALL_TYPE_HARD && (!node_bounds_valid || surface_min[1] < 0)) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[1] < 0 && node[i].vel[1] < 0) {
-                node[i].vel[1] = 0;
+            if (node[i].pos[1] < 0 && vel[i][1] < 0) {
+                vel[i][1] = 0;
             }
         }
     }
-    if (params.wall_y_2 == WALL_TYPE_HARD) {
+    if (params.wall_y_2 == WALL_TYPE_HARD && (!node_bounds_valid || surface_max[1] > box_dim[1])) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[1] > box_dim[1] && node[i].vel[1] > 0) {
-                node[i].vel[1] = 0;
+            if (node[i].pos[1] > box_dim[1] && vel[i][1] > 0) {
+                vel[i][1] = 0;
             }
         }
     }
-    if (params.wall_z_1 == WALL_TYPE_HARD) {
+    if (params.wall_z_1 == WALL_TYPE_HARD && (!node_bounds_valid || surface_min[2] < 0)) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[2] < 0 && node[i].vel[2] < 0) {
-                node[i].vel[2] = 0;
+            if (node[i].pos[2] < 0 && vel[i][2] < 0) {
+                vel[i][2] = 0;
             }
         }
     }
-    if (params.wall_z_2 == WALL_TYPE_HARD) {
+    if (params.wall_z_2 == WALL_TYPE_HARD && (!node_bounds_valid || surface_max[2] > box_dim[2])) {
         for (int i = 0; i < num_surface_nodes; i++) {
-            if (node[i].pos[2] > box_dim[2] && node[i].vel[2] > 0) {
-                node[i].vel[2] = 0;
+            if (node[i].pos[2] > box_dim[2] && vel[i][2] > 0) {
+                vel[i][2] = 0;
             }
         }
     }
@@ -1949,6 +2014,7 @@ void Blob::load_nodes(const char *node_filename, scalar load_scale) {
     // Allocate the memory for all these nodes
     node = std::vector<mesh_node>(num_nodes);
     node_position = std::vector<arr3*>(num_nodes, nullptr);
+    vel = std::vector<arr3>(num_nodes, { 0,0,0 });
 
     // Check for "surface nodes:" line
     if (!fgets(line, max_line_size, in)) {
@@ -1979,9 +2045,6 @@ void Blob::load_nodes(const char *node_filename, scalar load_scale) {
             node[i].pos[1] = load_scale * y;
             node[i].pos[2] = load_scale * z;
             node_position[i] = &node[i].pos;
-            node[i].vel[0] = 0;
-            node[i].vel[1] = 0;
-            node[i].vel[2] = 0;
 
             node[i].index = i;
         }
@@ -3145,19 +3208,18 @@ void Blob::calc_rest_state_info() {
 /*
  */
 void Blob::aggregate_forces_and_solve() {
-    // Aggregate the forces on each node by summing the contributions from each element.
+    // Add in the element forces (from update_internal_forces() and PreComp), zeroing them for the next step
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
-    #pragma omp parallel for default(none) schedule(guided)
+    #pragma omp parallel for default(none) schedule(static)
 #endif
-    for (int n = 0; n < node.size(); ++n) {
-        for (int m = 0; m < node[n].num_element_contributors; m++) {
-            force[n][0] += (*node[n].force_contributions[m])[0];
-            force[n][1] += (*node[n].force_contributions[m])[1];
-            force[n][2] += (*node[n].force_contributions[m])[2];
-        }
+    for (int i = 0; i < node.size(); ++i) {
+        force[i][0] += elem_force[i][0];
+        force[i][1] += elem_force[i][1];
+        force[i][2] += elem_force[i][2];
+        elem_force[i].fill(0);
     }
 
-    // Aggregate surface forces onto nodes
+    // Aggregate surface forces onto nodes (zeroing them for the next step)
     for (int n = 0; n < surface.size(); ++n) {
         for (int i = 0; i < 4; i++) {
             int sni = surface[n].n[i]->index;
@@ -3167,6 +3229,7 @@ void Blob::aggregate_forces_and_solve() {
 
             //			printf("force on %d from face %d = %e %e %e\n", sni, n, force[sni][0], force[sni][1], force[sni][2]);
         }
+        surface[n].zero_force();
     }
     //	printf("----\n\n");
     if (params.calc_stokes == 1) {
@@ -3184,9 +3247,9 @@ void Blob::aggregate_forces_and_solve() {
                 #pragma omp for schedule(guided)
 #endif
                 for (int i = 0; i < node.size(); ++i) {
-                    force[i][0] -= node[i].vel[0] * node[i].stokes_drag;
-                    force[i][1] -= node[i].vel[1] * node[i].stokes_drag;
-                    force[i][2] -= node[i].vel[2] * node[i].stokes_drag;
+                    force[i][0] -= vel[i][0] * node[i].stokes_drag;
+                    force[i][1] -= vel[i][1] * node[i].stokes_drag;
+                    force[i][2] -= vel[i][2] * node[i].stokes_drag;
                     if (params.calc_noise == 1) {
                         force[i][0] -= RAND(-.5, .5) * sqrt((24 * params.kT * node[i].stokes_drag) / (params.dt));
                         force[i][1] -= RAND(-.5, .5) * sqrt((24 * params.kT * node[i].stokes_drag) / (params.dt));
@@ -3253,13 +3316,15 @@ void Blob::euler_integrate() {
         #pragma omp parallel for default(none) schedule(static)
 #endif
         for (int i = 0; i < node.size(); ++i) {
-            node[i].vel[0] = force[i][0];
-            node[i].vel[1] = force[i][1];
-            node[i].vel[2] = force[i][2];
+            vel[i][0] = force[i][0];
+            vel[i][1] = force[i][1];
+            vel[i][2] = force[i][2];
 
             node[i].pos[0] += force[i][0] * params.dt; // really meaning v * dt
             node[i].pos[1] += force[i][1] * params.dt;
             node[i].pos[2] += force[i][2] * params.dt;
+
+            force[i].fill(0);
         }
 
     } else {
@@ -3267,50 +3332,17 @@ void Blob::euler_integrate() {
         #pragma omp parallel for default(none) schedule(static)
 #endif
         for (int i = 0; i < node.size(); ++i) {
-            node[i].vel[0] += force[i][0] * params.dt;
-            node[i].vel[1] += force[i][1] * params.dt;
-            node[i].vel[2] += force[i][2] * params.dt;
+            vel[i][0] += force[i][0] * params.dt;
+            vel[i][1] += force[i][1] * params.dt;
+            vel[i][2] += force[i][2] * params.dt;
 
-            node[i].pos[0] += node[i].vel[0] * params.dt;
-            node[i].pos[1] += node[i].vel[1] * params.dt;
-            node[i].pos[2] += node[i].vel[2] * params.dt;
-        }
-    }
-}
-
-/*
- *
- */
-void Blob::calculate_node_element_connectivity() {
-    // initialise num_element_contributors to zero
-    for(auto &node_i : node)
-        node_i.num_element_contributors = 0;
+            node[i].pos[0] += vel[i][0] * params.dt;
+            node[i].pos[1] += vel[i][1] * params.dt;
+            node[i].pos[2] += vel[i][2] * params.dt;
 
-    // count how many times each node is referenced in the list of elements
-    for (int i = 0; i < elem.size(); ++i)
-        for (int j = 0; j < NUM_NODES_QUADRATIC_TET; ++j)
-            node[elem[i].n[j]->index].num_element_contributors++;
-
-    // allocate the contributions array for each node to the length given by num_element_contributors
-    for (int i = 0; i < node.size(); ++i) {
-        try {
-            node[i].force_contributions = std::vector<arr3*>(node[i].num_element_contributors, nullptr);
-        } catch (std::bad_alloc &) {
-            throw FFEAException("Failed to allocate memory for 'force_contributions' array (on node %d)\n", i);
+            force[i].fill(0);
         }
     }
-
-    // create an array of counters keeping track of how full each contributions array is on each node
-    std::vector node_counter(node.size(), 0);
-
-    // go back through the elements array and fill the contributions arrays with pointers to the
-    // appropriate force contributions in the elements
-    for (int i = 0; i < elem.size(); i++)
-        for (int j = 0; j < NUM_NODES_QUADRATIC_TET; j++) {
-            const int node_index = elem[i].n[j]->index;
-            node[node_index].force_contributions[node_counter[node_index]] = &elem[i].node_force[j];
-            node_counter[node_index]++;
-        }
 }
 
 void Blob::pin_binding_site(set<int> node_indices) {
@@ -3318,6 +3350,9 @@ void Blob::pin_binding_site(set<int> node_indices) {
     for(it = node_indices.begin(); it != node_indices.end(); ++it) {
         bsite_pinned_nodes_list.insert(*it);
     }
+    if (solver) {
+        solver->set_nodes_pinned(node_indices, true);
+    }
 }
 
 void Blob::unpin_binding_site(set<int> node_indices) {
@@ -3325,6 +3360,9 @@ void Blob::unpin_binding_site(set<int> node_indices) {
     for(it = node_indices.begin(); it != node_indices.end(); ++it) {
         bsite_pinned_nodes_list.erase(*it);
     }
+    if (solver) {
+        solver->set_nodes_pinned(node_indices, false);
+    }
 }
 
 void Blob::create_pinned_nodes(set<int> list) {
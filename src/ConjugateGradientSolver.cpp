@@ -25,8 +25,10 @@
 
 ConjugateGradientSolver::ConjugateGradientSolver() {
     num_rows = 0;
+    num_nodes = 0;
     epsilon2 = 0;
     i_max = 0;
+    v = {};
     d = {};
     r = {};
     q = {};
@@ -38,12 +40,16 @@ ConjugateGradientSolver::~ConjugateGradientSolver() {
     key.clear();
     entry.clear();
     preconditioner.clear();
+    free_node.clear();
+    reduced_index.clear();
+    v.clear();
     d.clear();
     r.clear();
     q.clear();
     s.clear();
     f.clear();
     num_rows = 0;
+    num_nodes = 0;
     epsilon2 = 0;
     i_max = 0;
 }
@@ -51,28 +57,31 @@ ConjugateGradientSolver::~ConjugateGradientSolver() {
 void ConjugateGradientSolver::init(std::vector<mesh_node>& node, std::vector<tetra_element_linear>& elem, const SimulationParams& params, const std::vector<int>& pinned_nodes_list, const set<int>& bsite_pinned_node_list) {
     int ni, nj;
 
-    // Store the number of rows, error threshold (stopping criterion for solver) and max
+    // Store the number of nodes, error threshold (stopping criterion for solver) and max
     // number of iterations, on this Solver (these quantities will be used a lot)
-    this->num_rows = node.size();
+    this->num_nodes = node.size();
     this->epsilon2 = params.epsilon2;
     this->i_max = params.max_iterations_cg;
 
+    // Pinned nodes never move, so they are left out of the system altogether.
+    // Only the free nodes get a row, and solve() gathers from (and scatters back to) the full node arrays.
+    reduced_index = std::vector<int>(num_nodes, 0);
+    for (int i = 0; i < pinned_nodes_list.size(); i++) {
+        reduced_index[pinned_nodes_list[i]] = -1;
+    }
+    free_node.clear();
+    for (int i = 0; i < num_nodes; i++) {
+        if (reduced_index[i] != -1) {
+            reduced_index[i] = free_node.size();
+            free_node.push_back(i);
+        }
+    }
+    this->num_rows = free_node.size();
+
     printf("\t\tAttempting to allocate and zero %d scalars for mass_LU...\n", num_rows * num_rows);
     std::vector<scalar> mass_LU = std::vector<scalar>(num_rows * num_rows, 0);
     printf("\t\t...success.\n");
 
-    // Create a temporary lookup for checking if a node is 'pinned' or not.
-    // if it is, then only a 1 on the diagonal corresponding to that node should
-    // be placed (no off diagonal), effectively taking this node out of the equation
-    // and therefore meaning the force on it should always be zero.
-    std::vector<int> is_pinned(node.size());
-    for (int i = 0; i < node.size(); i++) {
-        is_pinned[i] = 0;
-    }
-    for (int i = 0; i < pinned_nodes_list.size(); i++) {
-        is_pinned[pinned_nodes_list[i]] = 1;
-    }
-
     // build the matrix
     scalar sum1 = 0.0, sum2 = 0.0;
     printf("\t\tBuilding the mass matrix...\n");
@@ -80,29 +89,23 @@ void ConjugateGradientSolver::init(std::vector<mesh_node>& node, std::vector<tet
         // add mass matrix for this element
         for (int i = 0; i < 10; i++) {
             for (int j = 0; j < 10; j++) {
+                ni = reduced_index[elem[n].n[i]->index];
+                nj = reduced_index[elem[n].n[j]->index];
+                if (ni == -1 || nj == -1) {
+                    continue;
+                }
                 if (i < 4 && j < 4) {
-                    ni = elem[n].n[i]->index;
-                    nj = elem[n].n[j]->index;
-                    if (is_pinned[ni] == 0 && is_pinned[nj] == 0) {
-                        if (i == j) {
-                            mass_LU[ni * num_rows + nj] += .1 * elem[n].rho * elem[n].vol_0;
-                            sum1 += .1 * elem[n].rho * elem[n].vol_0;
-                        }
-                        else {
-                            mass_LU[ni * num_rows + nj] += .05 * elem[n].rho * elem[n].vol_0;
-                            sum1 += .05 * elem[n].rho * elem[n].vol_0;
-                        }
+                    if (i == j) {
+                        mass_LU[ni * num_rows + nj] += .1 * elem[n].rho * elem[n].vol_0;
+                        sum1 += .1 * elem[n].rho * elem[n].vol_0;
                     }
                     else {
-                        if (i == j) {
-                            mass_LU[ni * num_rows + nj] = 1;
-                        }
+                        mass_LU[ni * num_rows + nj] += .05 * elem[n].rho * elem[n].vol_0;
+                        sum1 += .05 * elem[n].rho * elem[n].vol_0;
                     }
                 }
                 else {
                     if (i == j) {
-                        ni = elem[n].n[i]->index;
-                        nj = elem[n].n[j]->index;
                         mass_LU[ni * num_rows + nj] = 1;
                     }
                 }
@@ -180,6 +183,7 @@ void ConjugateGradientSolver::init(std::vector<mesh_node>& node, std::vector<tet
 
     // create the work vectors necessary for use by the conjugate gradient solver
     try {
+        v = std::vector<arr3>(num_rows);
         d = std::vector<arr3>(num_rows);
         r = std::vector<arr3>(num_rows);
         q = std::vector<arr3>(num_rows);
@@ -197,13 +201,14 @@ void ConjugateGradientSolver::solve(std::vector<arr3> &x) {
 
         // Once convergence is achieved, return
         if (residual2() < epsilon2) {
+            scatter_solution(x);
             return;
         }
 
         dTq = parallel_sparse_matrix_apply();
 
         alpha = delta_new / dTq;
-        parallel_vector_add_self(x, alpha, d, num_rows);
+        parallel_vector_add_self(v, alpha, d, num_rows);
         parallel_vector_add_self(r, -alpha, q, num_rows);
 
         delta_old = delta_new;
@@ -217,11 +222,18 @@ void ConjugateGradientSolver::solve(std::vector<arr3> &x) {
 }
 
 void ConjugateGradientSolver::apply_matrix(const std::vector<scalar> &in, std::vector<scalar> &result) {
+    // Pinned nodes are not in the matrix, and act as if they had a 1 on the diagonal
+    for (int i = 0; i < num_nodes; i++) {
+        if (reduced_index[i] == -1) {
+            result[i] = in[i];
+        }
+    }
     for (int i = 0; i < num_rows; i++) {
-        result[i] = 0;
+        scalar sum = 0;
         for (int j = key[i]; j < key[i + 1]; j++) {
-            result[i] += entry[j].val * in[entry[j].column_index];
+            sum += entry[j].val * in[free_node[entry[j].column_index]];
         }
+        result[free_node[i]] = sum;
     }
 }
 
@@ -233,15 +245,16 @@ scalar ConjugateGradientSolver::conjugate_gradient_residual_assume_x_zero(std::v
 // //#pragma omp parallel for default(none) private(i) shared(b) reduction(+:delta_new)
 #endif
     for (i = 0; i < num_rows; i++) {
-        r[i][0] = b[i][0];
-        r[i][1] = b[i][1];
-        r[i][2] = b[i][2];
-        f[i][0] = b[i][0];
-        f[i][1] = b[i][1];
-        f[i][2] = b[i][2];
-        b[i][0] = 0;
-        b[i][1] = 0;
-        b[i][2] = 0;
+        const arr3 &b_i = b[free_node[i]];
+        r[i][0] = b_i[0];
+        r[i][1] = b_i[1];
+        r[i][2] = b_i[2];
+        f[i][0] = b_i[0];
+        f[i][1] = b_i[1];
+        f[i][2] = b_i[2];
+        v[i][0] = 0;
+        v[i][1] = 0;
+        v[i][2] = 0;
         d[i][0] = preconditioner[i] * r[i][0];
         d[i][1] = preconditioner[i] * r[i][1];
         d[i][2] = preconditioner[i] * r[i][2];
@@ -251,6 +264,17 @@ scalar ConjugateGradientSolver::conjugate_gradient_residual_assume_x_zero(std::v
     return delta_new;
 }
 
+/* */
+void ConjugateGradientSolver::scatter_solution(std::vector<arr3> &x) {
+    // Pinned nodes are not in the system, and are never accelerated
+    for (int i = 0; i < num_nodes; i++) {
+        x[i].fill(0);
+    }
+    for (int i = 0; i < num_rows; i++) {
+        x[free_node[i]] = v[i];
+    }
+}
+
 /* */
 scalar ConjugateGradientSolver::parallel_sparse_matrix_apply() {
     int i, j;
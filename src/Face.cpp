@@ -331,89 +331,78 @@ bool Face::checkTetraIntersection(const Face *f2, const std::vector<scalar> &blo
 }
 
 
-bool Face::getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, geoscalar dr, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2) {
+bool Face::checkTetraBoundsOverlap(const Face *f2) const {
+    static const arr3 no_shift = {0, 0, 0};
+    return tetraBoundsOverlap(f2, no_shift);
+}
+
+bool Face::checkTetraBoundsOverlap(const Face *f2, const std::vector<scalar> &blob_corr,int f1_daddy_blob_index,int f2_daddy_blob_index) const {
+    const int k = f1_daddy_blob_index*(this->num_blobs)*3 + f2_daddy_blob_index*3;
+    const arr3 shift = {blob_corr[k], blob_corr[k+1], blob_corr[k+2]};
+    return tetraBoundsOverlap(f2, shift);
+}
+
+bool Face::tetraBoundsOverlap(const Face *f2, const arr3 &f2_shift) const {
+    for (int j=0; j<3; j++) {
+        scalar min1 = n[0]->pos[j], max1 = min1;
+        scalar min2 = f2->n[0]->pos[j], max2 = min2;
+        for (int i=1; i<4; i++) {
+            min1 = std::min(min1, n[i]->pos[j]);
+            max1 = std::max(max1, n[i]->pos[j]);
+            min2 = std::min(min2, f2->n[i]->pos[j]);
+            max2 = std::max(max2, f2->n[i]->pos[j]);
+        }
+        min2 -= f2_shift[j];
+        max2 -= f2_shift[j];
+        if (max1 < min2 || max2 < min1) return false;
+    }
+    return true;
+}
 
-    std::array<grr3, 4> tetA, tetB;
-    grr3 ap1, ap2, cm;
-    geoscalar vol_m, vol_M;
 
-    // GET THE VOLUME AND THE DIRECTION OF THE GRADIENT:
+bool Face::getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2) {
 
-    // GET THE VOLUME, the CM for the intersection, and the direction of the gradient:
-    vol = volumeIntersectionII(n[0]->pos, n[1]->pos,
+    grr3 cm;
+
+    // GET THE VOLUME, the CM for the intersection, and the gradient:
+    vol = volumeIntersectionAndGradientII(n[0]->pos, n[1]->pos,
             n[2]->pos, n[3]->pos,
             f2->n[0]->pos, f2->n[1]->pos,
-            f2->n[2]->pos, f2->n[3]->pos, true, cm);
+            f2->n[2]->pos, f2->n[3]->pos, dVdr, cm);
     if (vol == 0) return false;  // Zero check floating point is considered unsafe, consider an epsilon
 
     // GET THE LOCAL COORDINATES where the force will be applied.
     getLocalCoordinatesForLinTet(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, cm, phi1);
     getLocalCoordinatesForLinTet(f2->n[0]->pos, f2->n[1]->pos, f2->n[2]->pos, f2->n[3]->pos, cm, phi2);
 
-
-    // GET THE GRADIENT
-    // 1st Order:
-    grr3 dx;
-    for (int dir=0; dir<3; dir++) {
-        initialise(dx);
-        dx[dir] = dr;
-        for (int i=0; i<4; i++) {
-            for (int j=0; j<3; j++) {
-                tetA[i][j] = n[i]->pos[j] + dx[j];
-                tetB[i][j] = f2->n[i]->pos[j] + dx[j];
-            }
-        }
-
-        vol_M = volumeIntersectionII(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, tetB[0], tetB[1], tetB[2], tetB[3], false, cm);
-        dVdr[dir] = (vol_M - vol)/dr;
-        vol_M = volumeIntersectionII(f2->n[0]->pos, f2->n[1]->pos, f2->n[2]->pos, f2->n[3]->pos, tetA[0], tetA[1], tetA[2], tetA[3], false, cm);
-        dVdr[dir] -= (vol_M - vol)/dr;
-    }
+    // Moving f2 by dr changes the volume by dVdr*dr, and moving this face by dr by -dVdr*dr.
+    //   The total gradient is the difference of the two.
+    resize(geoscalar(2), dVdr);
 
     return true;
 
 }
 
 
-bool Face::getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, geoscalar dr, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2, const std::vector<scalar> &blob_corr, int f1_daddy_blob_index, int f2_daddy_blob_index) {
-    std::array<grr3, 4> tetB, tetC, tetD;
-    grr3 ap1, ap2, cm;
-    geoscalar vol_m, vol_M;
+bool Face::getTetraIntersectionVolumeTotalGradientAndShapeFunctions(const Face *f2, grr3 &dVdr, geoscalar &vol, grr4 &phi1, grr4 &phi2, const std::vector<scalar> &blob_corr, int f1_daddy_blob_index, int f2_daddy_blob_index) {
+    std::array<grr3, 4> tetB;
+    grr3 cm;
 
-    // GET THE VOLUME AND THE DIRECTION OF THE GRADIENT:
     for (int i=0; i<4; i++) {
         for (int j=0; j<3; j++) {
             tetB[i][j] = f2->n[i]->pos[j]-blob_corr[f1_daddy_blob_index*(this->num_blobs)*3 + f2_daddy_blob_index*3 + j];
         }
     }
 
-    // get the volume, the CM for the intersection, and the direction of the gradient:
-    vol = volumeIntersectionII(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, tetB[0], tetB[1], tetB[2], tetB[3], true, cm);
+    // get the volume, the CM for the intersection, and the gradient:
+    vol = volumeIntersectionAndGradientII(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, tetB[0], tetB[1], tetB[2], tetB[3], dVdr, cm);
     if (vol == 0) return false;
 
     // GET THE LOCAL COORDINATES where the force will be applied.
     getLocalCoordinatesForLinTet(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, cm, phi1);
     getLocalCoordinatesForLinTet(tetB[0], tetB[1], tetB[2], tetB[3], cm, phi2);
 
-
-    // GET THE GRADIENT
-    // 1st Order:
-    grr3 dx;
-    for (int dir=0; dir<3; dir++) {
-        initialise(dx);
-        dx[dir] = dr;
-        for (int i=0; i<4; i++) {
-            for (int j=0; j<3; j++) {
-                tetD[i][j] = tetB[i][j] + dx[j];
-
-                tetC[i][j] = n[i]->pos[j] + dx[j];
-            }
-        }
-        vol_M = volumeIntersectionII(n[0]->pos, n[1]->pos, n[2]->pos, n[3]->pos, tetD[0], tetD[1], tetD[2], tetD[3], false, cm);
-        dVdr[dir] = (vol_M - vol)/dr;
-        vol_M = volumeIntersection(tetB, tetC, false, cm);
-        dVdr[dir] -= (vol_M - vol)/dr;
-    }
+    resize(geoscalar(2), dVdr);
 
     return true;
 }
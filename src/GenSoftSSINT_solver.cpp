@@ -27,15 +27,7 @@
     /**Calculates GenSoftSSINT forces modified with periodic boundary correction in distance calculation*/
 void GenSoftSSINT_solver::do_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr){
     bool gensoft = true;
-    bool intersection; 
-    if (blob_corr.empty()) {
-       intersection = f1->checkTetraIntersection(f2);
-    } else {
-       intersection = f1->checkTetraIntersection(f2,
-            blob_corr,f1->daddy_blob->blob_index, f2->daddy_blob->blob_index);
-    }
-
-    if (intersection) {
+    if (steric_overlap(f1, f2, blob_corr)) {
       if (do_steric_interaction(f1, f2, blob_corr))
           gensoft = false; 
     } 
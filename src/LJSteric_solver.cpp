@@ -32,15 +32,7 @@
     /**Calculates LJSteric forces modified with periodic boundary correction in distance calculation*/
 void LJSteric_solver::do_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr){
     bool lj = true;
-    bool intersection; 
-    if (blob_corr.empty()) {
-       intersection = f1->checkTetraIntersection(f2);
-    } else {
-       intersection = f1->checkTetraIntersection(f2,
-            blob_corr,f1->daddy_blob->blob_index, f2->daddy_blob->blob_index);
-    }
-
-    if (intersection) {
+    if (steric_overlap(f1, f2, blob_corr)) {
       if (do_steric_interaction(f1, f2, blob_corr))
           lj = false; 
     } 
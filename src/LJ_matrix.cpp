@@ -31,6 +31,7 @@ void SSINT_matrix::init(const string &ssint_params_fname, const string &ssint_ty
     } else {
         init_ssint(ssint_params_fname, ssint_type, ssint_cutoff);
     }
+    build_table();
 }
 
 void SSINT_matrix::init_steric() {
@@ -44,6 +45,7 @@ void SSINT_matrix::init_steric() {
     }
     params[LJI(0, 0)]["Emin"] = 0;
     params[LJI(0, 0)]["Rmin"] = 0;
+    params[LJI(0, 0)]["k0"] = 0;
 }
 
 
@@ -148,7 +150,31 @@ void SSINT_matrix::init_ssint(const string &ssint_params_fname, const string &ss
     printf("\t\tRead %d VDW forcefield parameter entries from %s\n", num_ssint_face_types * num_ssint_face_types, ssint_params_fname.c_str());
 }
 
-map<string, scalar> SSINT_matrix::get_SSINT_params(int type1, int type2) {
+void SSINT_matrix::build_table() {
+    const int num_pairs = num_ssint_face_types * num_ssint_face_types;
+    try {
+        table.Emin.assign(num_pairs, 0);
+        table.Rmin.assign(num_pairs, 0);
+        table.Rmin_3.assign(num_pairs, 0);
+        table.Rmin_6.assign(num_pairs, 0);
+        table.Rmini.assign(num_pairs, 0);
+        table.k0.assign(num_pairs, 0);
+    } catch (std::bad_alloc &) {
+        throw FFEAException("Unable to allocate memory for SSINT parameter table.");
+    }
+
+    for (int i = 0; i < num_pairs; i++) {
+        scalar Rmin = params[i]["Rmin"];
+        table.Emin[i] = params[i]["Emin"];
+        table.Rmin[i] = Rmin;
+        table.Rmin_3[i] = Rmin * Rmin * Rmin;
+        table.Rmin_6[i] = table.Rmin_3[i] * table.Rmin_3[i];
+        table.Rmini[i] = (Rmin > 0) ? 1.0 / Rmin : 0;
+        table.k0[i] = params[i]["k0"];
+    }
+}
+
+const map<string, scalar> &SSINT_matrix::get_SSINT_params(int type1, int type2) {
     if (type1 < 0 || type1 > num_ssint_face_types - 1) {
         printf("Frog1 %d %d\n", type1, num_ssint_face_types - 1);
     }
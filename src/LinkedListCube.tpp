@@ -116,6 +116,8 @@ void LinkedListCube<T>::add_to_pool(T *t) {
     // Give object its own representant LinkedListNode in the pool
     pool[add_index].obj = t;
     pool[add_index].index = add_index;
+    pool_active.push_back(true);
+    active_pool.push_back(add_index);
     add_index++;
 
     num_nodes_in_pool++;
@@ -134,6 +136,8 @@ void LinkedListCube<T>::add_to_pool_dual(T *t) {
     pool1[add_index].index = add_index;
     pool2[add_index].obj = t;
     pool2[add_index].index = add_index;
+    pool_active.push_back(true);
+    active_pool.push_back(add_index);
     add_index++;
 
     num_nodes_in_pool++;
@@ -145,6 +149,44 @@ LinkedListNode<T> * LinkedListCube<T>::get_from_pool(int i) {
     return &pool[i];
 }
 
+/* */
+template <class T>
+void LinkedListCube<T>::set_pool_range_active(int first, int count, bool state) {
+    if (first < 0 || count < 0 || first + count > num_nodes_in_pool) {
+        throw FFEAException("In LinkedListCube, attempt to (de)activate pool nodes [%d, %d) outside of the pool (size %d).", first, first + count, num_nodes_in_pool);
+    }
+
+    bool changed = false;
+    for (int i = first; i < first + count; i++) {
+        if (pool_active[i] != state) {
+            pool_active[i] = state;
+            changed = true;
+        }
+    }
+
+    // Changes are rare (conformation changes), so just rebuild the list in pool order
+    if (changed) {
+        active_pool.clear();
+        for (int i = 0; i < num_nodes_in_pool; i++) {
+            if (pool_active[i]) {
+                active_pool.push_back(i);
+            }
+        }
+    }
+}
+
+/* */
+template <class T>
+LinkedListNode<T> * LinkedListCube<T>::get_active_from_pool(int i) {
+    return &pool[active_pool[i]];
+}
+
+/* */
+template <class T>
+int LinkedListCube<T>::get_num_active() {
+    return static_cast<int>(active_pool.size());
+}
+
 /* */
 template <class T>
 void LinkedListCube<T>::clear() {
@@ -28,15 +28,12 @@ void NearestNeighbourLinkedListCube::build_nearest_neighbour_lookup(scalar h) {
     // Clear the grid
     clear();
 
-    // Loop through each Face in the pool, calculate which cell of the
+    // Loop through each active Face in the pool (faces of inactive
+    // conformations are left out entirely), calculate which cell of the
     // grid it belongs in based on its centroid position, and add it to
     // the linked list stack on that cell
-    for (int i = 0; i < num_nodes_in_pool; i++) {
+    for (int i : active_pool) {
         // calculate which cell the face belongs in
-	    if (!pool[i].obj->kinetically_active) {
-		    continue;
-	    }
-
 	    // Do we have the correct centroid?? We do now!
         //pool[i].obj->calc_area_normal_centroid();
         int x = (int) floor(pool[i].obj->centroid[0] / h);
@@ -75,16 +72,13 @@ void NearestNeighbourLinkedListCube::prebuild_nearest_neighbour_lookup_and_swap(
     // Clear the grid
     clear_layer(shadow_layer);
 
-    // Loop through each Face in the pool, calculate which cell of the
+    // Loop through each active Face in the pool (faces of inactive
+    // conformations are left out entirely), calculate which cell of the
     // grid it belongs in based on its centroid position, and add it to
     // the linked list stack on that cell
-    for (int i = 0; i < num_nodes_in_pool; i++) {
+    for (int i : active_pool) {
 
         // calculate which cell the face belongs in
-        if (!pool[i].obj->kinetically_active) {
-          continue;
-        }
-
        // Do we have the correct centroid?? We do now!
        // pool[i].obj->calc_area_normal_centroid();
 
@@ -103,16 +97,13 @@ void NearestNeighbourLinkedListCube::prebuild_nearest_neighbour_lookup(scalar h)
     clear_layer(shadow_layer);
     can_swap = false;
 
-    // Loop through each Face in the pool, calculate which cell of the
+    // Loop through each active Face in the pool (faces of inactive
+    // conformations are left out entirely), calculate which cell of the
     // grid it belongs in based on its centroid position, and add it to
     // the linked list stack on that cell
-    for (int i = 0; i < num_nodes_in_pool; i++) {
+    for (int i : active_pool) {
 
         // calculate which cell the face belongs in
-        if (!pool[i].obj->kinetically_active) {
-          continue;
-        }
-
        // Do we have the correct centroid?? We do now!
        // pool[i].obj->calc_area_normal_centroid();
 
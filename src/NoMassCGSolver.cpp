@@ -26,9 +26,11 @@
 NoMassCGSolver::NoMassCGSolver() {
     num_rows = 0;
     num_nodes = 0;
+    num_free_nodes = 0;
     epsilon2 = 0;
     i_max = 0;
     preconditioner = {};
+    v = {};
     r = {};
     p = {};
     z = {};
@@ -44,9 +46,13 @@ NoMassCGSolver::~NoMassCGSolver() {
     z.clear();
     q.clear();
     f.clear();
+    v.clear();
     preconditioner.clear();
+    free_node.clear();
+    reduced_index.clear();
     num_rows = 0;
     num_nodes = 0;
+    num_free_nodes = 0;
     epsilon2 = 0;
     i_max = 0;
     V.reset();
@@ -54,11 +60,31 @@ NoMassCGSolver::~NoMassCGSolver() {
 
 /* */
 void NoMassCGSolver::init(std::vector<mesh_node> &node, std::vector<tetra_element_linear> &elem, const SimulationParams &params, const std::vector<int> &pinned_nodes_list, const set<int> &bsite_pinned_node_list) {
-    this->num_rows = 3 * node.size();
     this->num_nodes = node.size();
     this->epsilon2 = params.epsilon2;
     this->i_max = params.max_iterations_cg;
     this->one = 1;
+
+    // Pinned nodes never move, so they are left out of the system altogether.
+    // The matrix and work vectors only cover the free nodes, which are gathered from
+    // (and scattered back to) the full node arrays in solve().
+    // Binding site nodes come and go, so they are masked in solve() rather than taken out of the system.
+    reduced_index = vector<int>(num_nodes, 0);
+    for (int i = 0; i < pinned_nodes_list.size(); ++i) {
+        reduced_index[pinned_nodes_list[i]] = -1;
+    }
+    free_node.clear();
+    for (int i = 0; i < num_nodes; ++i) {
+        if (reduced_index[i] != -1) {
+            reduced_index[i] = free_node.size();
+            free_node.push_back(i);
+        }
+    }
+    this->num_free_nodes = free_node.size();
+    this->num_rows = 3 * num_free_nodes;
+    masked_nodes.clear();
+    set_nodes_pinned(bsite_pinned_node_list, true);
+
     //printf("\t\t\tCalculating Sparsity Pattern for a 1st Order Viscosity Matrix\n");
     SparsityPattern sparsity_pattern_viscosity_matrix;
     sparsity_pattern_viscosity_matrix.init(num_rows);
@@ -66,50 +92,32 @@ void NoMassCGSolver::init(std::vector<mesh_node> &node, std::vector<tetra_elemen
     scalar *mem_loc;
     matrix3 J;
 
-    // Create a temporary lookup for checking if a node is 'pinned' or not.
-    // if it is, then only a 1 on the diagonal corresponding to that node should
-    // be placed (no off diagonal), effectively taking this node out of the equation
-    // and therefore meaning the force on it should always be zero.
-    vector<int> is_pinned(node.size(), 0);
-    for (int i = 0; i < pinned_nodes_list.size(); ++i) {
-        is_pinned[pinned_nodes_list[i]] = 1;
-    }
-    for(set<int>::iterator it = bsite_pinned_node_list.begin(); it != bsite_pinned_node_list.end(); ++it) {
-        is_pinned[*it] = 1;
-    }
-
     for (int n = 0; n < elem.size(); n++) {
         elem[n].calculate_jacobian(J);
         elem[n].calc_shape_function_derivatives_and_volume(J);
         elem[n].create_viscosity_matrix();
         for (int ni = 0; ni < 10; ++ni) {
             for (int nj = 0; nj < 10; ++nj) {
-                int ni_index = elem[n].n[ni]->index;
-                int nj_index = elem[n].n[nj]->index;
+                int ni_index = reduced_index[elem[n].n[ni]->index];
+                int nj_index = reduced_index[elem[n].n[nj]->index];
+                if (ni_index == -1 || nj_index == -1) {
+                    continue;
+                }
                 int ni_row = ni_index * 3;
                 int nj_row = nj_index * 3;
                 for (int i = 0; i < 3; ++i) {
                     for (int j = 0; j < 3; ++j) {
-			            if(is_pinned[ni_index] == 0 && is_pinned[nj_index] == 0) {
-		                    if (ni < 4 && nj < 4) {
-		                        mem_loc = &elem[n].viscosity_matrix[ni + 4 * i][nj + 4 * j];
-		                        sparsity_pattern_viscosity_matrix.register_contribution(ni_row + i, nj_row + j, mem_loc);
-		                    } else {
-		                        if (ni == nj && i == j) {
-		                            if (sparsity_pattern_viscosity_matrix.check_for_contribution(ni_row + i, nj_row + j) == false) {
-		                                mem_loc = &one;
-		                                sparsity_pattern_viscosity_matrix.register_contribution(ni_row + i, nj_row + j, mem_loc);
-		                            }
-		                        }
-		                    }
-			            } else {
-			                if (ni == nj && i == j) {
-		                        if (sparsity_pattern_viscosity_matrix.check_for_contribution(ni_row + i, nj_row + j) == false) {
-		                            mem_loc = &one;
-		                            sparsity_pattern_viscosity_matrix.register_contribution(ni_row + i, nj_row + j, mem_loc);
-		                        }
-		                    }
-			            }
+                        if (ni < 4 && nj < 4) {
+                            mem_loc = &elem[n].viscosity_matrix[ni + 4 * i][nj + 4 * j];
+                            sparsity_pattern_viscosity_matrix.register_contribution(ni_row + i, nj_row + j, mem_loc);
+                        } else {
+                            if (ni == nj && i == j) {
+                                if (sparsity_pattern_viscosity_matrix.check_for_contribution(ni_row + i, nj_row + j) == false) {
+                                    mem_loc = &one;
+                                    sparsity_pattern_viscosity_matrix.register_contribution(ni_row + i, nj_row + j, mem_loc);
+                                }
+                            }
+                        }
                     }
                 }
             }
@@ -117,12 +125,10 @@ void NoMassCGSolver::init(std::vector<mesh_node> &node, std::vector<tetra_elemen
     }
 
     if (params.calc_stokes == 1) {
-        for (int ni = 0; ni < num_nodes; ++ni) {
-	    if(is_pinned[ni] == 0) {
-                for (int nj = 0; nj < 3; ++nj) {
-                    sparsity_pattern_viscosity_matrix.register_contribution(3 * ni + nj, 3 * ni + nj, &node[ni].stokes_drag);
-                }
-	    }
+        for (int ni = 0; ni < num_free_nodes; ++ni) {
+            for (int nj = 0; nj < 3; ++nj) {
+                sparsity_pattern_viscosity_matrix.register_contribution(3 * ni + nj, 3 * ni + nj, &node[free_node[ni]].stokes_drag);
+            }
         }
     }
 
@@ -142,11 +148,12 @@ void NoMassCGSolver::init(std::vector<mesh_node> &node, std::vector<tetra_elemen
 
     // create the work vectors necessary for use by the conjugate gradient solver in 'solve'
     try {
-        r = std::vector<arr3>(num_nodes);
-        p = std::vector<arr3>(num_nodes);
-        z = std::vector<arr3>(num_nodes);
-        q = std::vector<arr3>(num_nodes);
-        f = std::vector<arr3>(num_nodes);
+        v = std::vector<arr3>(num_free_nodes);
+        r = std::vector<arr3>(num_free_nodes);
+        p = std::vector<arr3>(num_free_nodes);
+        z = std::vector<arr3>(num_free_nodes);
+        q = std::vector<arr3>(num_free_nodes);
+        f = std::vector<arr3>(num_free_nodes);
     } catch(std::bad_alloc &) {
         throw FFEAException(" Failed to create the work vectors necessary for NoMassCGSolver\n");
     }
@@ -168,7 +175,7 @@ void NoMassCGSolver::solve(std::vector<arr3> &x) {
         alpha = delta_new / pTq;
 
         // Update solution and residual
-        vec3_add_to_scaled(x, p, alpha);
+        vec3_add_to_scaled(v, p, alpha);
         vec3_add_to_scaled(r, q, -alpha);
 
         // Once convergence is achieved, return
@@ -176,6 +183,7 @@ void NoMassCGSolver::solve(std::vector<arr3> &x) {
 	    //cout << residual2() << " " << epsilon2 << endl;
 	    //exit(0);
             //std::cout << "NoMassCG_solver: Convergence reached on iteration " << i << "\n"; // DEBUGGO
+            scatter_solution(x);
             return;
         }
 	//cout << residual2() << " " << epsilon2 << endl;
@@ -198,16 +206,17 @@ scalar NoMassCGSolver::conjugate_gradient_residual_assume_x_zero(std::vector<arr
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
 #pragma omp parallel for default(none) shared(b) reduction(+:delta_new)
 #endif
-    for (int i = 0; i < num_nodes; i++) {
-        r[i][0] = b[i][0];
-        r[i][1] = b[i][1];
-        r[i][2] = b[i][2];
-        f[i][0] = b[i][0];
-        f[i][1] = b[i][1];
-        f[i][2] = b[i][2];
-        b[i][0] = 0;
-        b[i][1] = 0;
-        b[i][2] = 0;
+    for (int i = 0; i < num_free_nodes; i++) {
+        const arr3 &b_i = b[free_node[i]];
+        r[i][0] = b_i[0];
+        r[i][1] = b_i[1];
+        r[i][2] = b_i[2];
+        f[i][0] = b_i[0];
+        f[i][1] = b_i[1];
+        f[i][2] = b_i[2];
+        v[i][0] = 0;
+        v[i][1] = 0;
+        v[i][2] = 0;
         z[i][0] = preconditioner[(3 * i)] * r[i][0];
         z[i][1] = preconditioner[(3 * i) + 1] * r[i][1];
         z[i][2] = preconditioner[(3 * i) + 2] * r[i][2];
@@ -219,13 +228,30 @@ scalar NoMassCGSolver::conjugate_gradient_residual_assume_x_zero(std::vector<arr
     return delta_new;
 }
 
+/* */
+void NoMassCGSolver::scatter_solution(std::vector<arr3> &x) {
+    // Pinned nodes are not in the system, and never move
+#ifdef FFEA_PARALLEL_WITHIN_BLOB
+#pragma omp parallel for default(none) shared(x)
+#endif
+    for (int i = 0; i < num_nodes; i++) {
+        x[i].fill(0);
+    }
+#ifdef FFEA_PARALLEL_WITHIN_BLOB
+#pragma omp parallel for default(none) shared(x)
+#endif
+    for (int i = 0; i < num_free_nodes; i++) {
+        x[free_node[i]] = v[i];
+    }
+}
+
 /* */
 scalar NoMassCGSolver::residual2() {
     scalar r2 = 0, f2 = 0;
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
 #pragma omp parallel for default(none) reduction(+:r2, f2)
 #endif
-    for (int i = 0; i < num_nodes; i++) {
+    for (int i = 0; i < num_free_nodes; i++) {
         r2 += r[i][0] * r[i][0] + r[i][1] * r[i][1] + r[i][2] * r[i][2];
         f2 += f[i][0] * f[i][0] + f[i][1] * f[i][1] + f[i][2] * f[i][2];
     }
@@ -248,16 +274,37 @@ scalar NoMassCGSolver::modx(const std::vector<arr3> &x) {
     return r2;
 }
 
+void NoMassCGSolver::set_nodes_pinned(const set<int> &node_indices, bool state) {
+    for (int n : node_indices) {
+        // Nodes that are pinned anyway are not in the system to be masked
+        const int rn = reduced_index[n];
+        if (rn == -1) {
+            continue;
+        }
+        if (state) {
+            masked_nodes.insert(rn);
+        } else {
+            masked_nodes.erase(rn);
+        }
+    }
+}
+
 scalar NoMassCGSolver::get_alpha_denominator() {
     // A * p
     V->apply(p, q);
+
+    // Masked nodes have zero force, so p is zero on them and their columns drop out.
+    // Zeroing their rows too leaves their velocities at zero, as if they were not in the matrix.
+    for (int n : masked_nodes) {
+        q[n].fill(0);
+    }
     scalar pTq = 0;
 
     // p^T * A * p
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
 #pragma omp parallel for default(none) reduction(+:pTq)
 #endif
-    for (int i = 0; i < num_nodes; ++i) {
+    for (int i = 0; i < num_free_nodes; ++i) {
         pTq += p[i][0] * q[i][0] + p[i][1] * q[i][1] + p[i][2] * q[i][2];
     }
 
@@ -270,7 +317,7 @@ scalar NoMassCGSolver::parallel_apply_preconditioner() {
 #ifdef FFEA_PARALLEL_WITHIN_BLOB
 #pragma omp parallel for default(none) reduction(+:delta_new)
 #endif
-    for (int i = 0; i < num_nodes; i++) {
+    for (int i = 0; i < num_free_nodes; i++) {
         z[i][0] = preconditioner[(3 * i)] * r[i][0];
         z[i][1] = preconditioner[(3 * i) + 1] * r[i][1];
         z[i][2] = preconditioner[(3 * i) + 2] * r[i][2];
@@ -286,11 +333,15 @@ void NoMassCGSolver::check(const std::vector<arr3> &x) {
     fout2 = fopen("/localhome/py09bh/output/nomass/cube_viscosity_no_mass.csv", "a");
     int i;
     double temp = 0, temp2 = 0;
-    std::vector<arr3> temp_vec = std::vector<arr3>(num_nodes);
-    V->apply(x, temp_vec);
-    for (i = 0; i < num_nodes; ++i) {
-        temp += x[i][0] * temp_vec[i][0] + x[i][1] * temp_vec[i][1] + x[i][2] * temp_vec[i][2];
-        temp2 += x[i][0] * f[i][0] + x[i][1] * f[i][1] + x[i][2] * f[i][2];
+    std::vector<arr3> x_free = std::vector<arr3>(num_free_nodes);
+    std::vector<arr3> temp_vec = std::vector<arr3>(num_free_nodes);
+    for (i = 0; i < num_free_nodes; ++i) {
+        x_free[i] = x[free_node[i]];
+    }
+    V->apply(x_free, temp_vec);
+    for (i = 0; i < num_free_nodes; ++i) {
+        temp += x_free[i][0] * temp_vec[i][0] + x_free[i][1] * temp_vec[i][1] + x_free[i][2] * temp_vec[i][2];
+        temp2 += x_free[i][0] * f[i][0] + x_free[i][1] * f[i][1] + x_free[i][2] * f[i][2];
     }
     fprintf(fout2, "%e,%e\n", temp2, fabs(temp - temp2));
     fclose(fout2);
@@ -191,17 +191,20 @@ void PreComp_solver::init(const PreComp_params *pc_params, const SimulationParam
      // scalar F_to_Jm = pc_params->E_to_J / pc_params->dist_to_m;
      scalar F_scale = ( pc_params->E_to_J / pc_params->dist_to_m ) / mesoDimensions::force;
      read_tabulated_values(*pc_params, "force", F, F_scale);
-   } else if (pc_params->inputData == 2) {
-        calc_force_from_pot();
-   } else {
+   } else if (pc_params->inputData != 2) {
         throw FFEAException("--- PreComp: invalid value for precomp->inputData");
    }
    Dx = Dx * pc_params->dist_to_m / mesoDimensions::length ;
+   // the forces have to be computed once Dx is in mesoDimensions:
+   if (pc_params->inputData == 2) calc_force_from_pot();
    x_range[0] = x_range[0] * pc_params->dist_to_m / mesoDimensions::length; 
    x_range[1] = x_range[0] + Dx * n_values;
    x_range2[0] = x_range[0]*x_range[0]; 
    x_range2[1] = x_range[1]*x_range[1]; 
 
+   // and turn the tables into splines:
+   build_splines(*pc_params);
+
 
 
    /*------------ THIRDLY --------*/
@@ -390,6 +393,7 @@ void PreComp_solver::init(const PreComp_params *pc_params, const SimulationParam
        b_forces = std::vector<scalar>(3 * n_beads);
        map_e_to_b = std::vector<int>(2 * num_diff_elems);
        b_unq_elems = std::vector<TELPtr>(num_diff_elems);
+       unq_elem_forces = std::vector<arr3>(4 * num_diff_elems);
    } catch (std::bad_alloc &) {
        throw FFEAException("Failed to allocate memory for supplementary array beads in PreComp_solver::init.");
    }
@@ -438,6 +442,30 @@ void PreComp_solver::init(const PreComp_params *pc_params, const SimulationParam
 
    num_blobs = params->num_blobs;
 
+   // the offsets of the tables of every pair of types, 
+   //   and the cell sorted bead arrays:
+   try {
+       pair_table = std::vector<int>(ntypes * ntypes);
+       slot_bead = std::vector<int>(n_beads);
+       s_type = std::vector<int>(n_beads);
+       s_daddy = std::vector<int>(n_beads);
+       s_x = std::vector<scalar>(n_beads);
+       s_y = std::vector<scalar>(n_beads);
+       s_z = std::vector<scalar>(n_beads);
+       t_forces = std::vector<scalar>(3 * n_beads * num_threads);
+       t_u = std::vector<scalar>(n_beads * num_threads);
+       no_corr = std::vector<scalar>(3 * num_blobs * num_blobs);
+   } catch (std::bad_alloc &) {
+       throw FFEAException("Failed to allocate memory for the cell sorted bead arrays in PreComp_solver::init.");
+   }
+   for (int i=0; i<ntypes; i++) {
+     for (int j=0; j<ntypes; j++) {
+       int ti = std::min(i, j), tj = std::max(i, j);
+       int index = ti * ntypes - (ti*ti - ti)/2 + (tj - ti);
+       pair_table[i*ntypes + j] = isPairActive[i*ntypes + j] ? 4 * index * n_intervals : -1;
+     }
+   }
+
 
    /*------------ FIFTHLY ---:)---*/
    // Set up the linkedlist:
@@ -509,102 +537,91 @@ void PreComp_solver::init(const PreComp_params *pc_params, const SimulationParam
 }
 
 void PreComp_solver::solve_using_neighbours_non_critical(const std::vector<scalar> &blob_corr){
-    scalar d, f_ij; //, f_ijk_i, f_ijk_j; 
-    arr3 dx, dxik;
-    int type_i; 
     std::array<scalar, 4> phi_i; 
+    arr3 dxik;
     tetra_element_linear* e_i;
 
     // 0 - clear fieldenery:
     reset_fieldenergy(); 
-    //   - and reset b_forces!
-    for (int i=0; i<3*n_beads; i++) {
-      b_forces[i] = 0.;
-    }
 
-    // 1 - Compute the position of the beads:
+    // 1 - Compute the position of the beads, and gather them in cell order:
     compute_bead_positions();
+    if (cells_stale) build_cell_arrays();
+    for (int s=0; s<n_beads; s++) {
+      int b = slot_bead[s];
+      s_x[s] = b_pos[3*b  ];
+      s_y[s] = b_pos[3*b+1];
+      s_z[s] = b_pos[3*b+2];
+    }
+    const scalar *corr = blob_corr.empty() ? no_corr.data() : blob_corr.data();
+    const int num_occupied = occupied_cells.size();
 
-    // 2 - Compute all the i-j forces:
-    LinkedListNode<int> *b_i, *b_j;
-    int b_index_i, b_index_j; 
-    int daddy_i, daddy_j;
+    // 2 - Compute all the i-j forces, once per pair:
 #ifdef USE_OPENMP
-#pragma omp parallel default(none) shared(blob_corr) private(type_i,phi_i,e_i,dx,dxik,d,f_ij,b_i,b_j,b_index_i,b_index_j,daddy_i, daddy_j)
+#pragma omp parallel default(none) shared(corr, num_occupied) private(phi_i, dxik, e_i)
     {
     int thread_id = omp_get_thread_num(); 
-    #pragma omp for
 #else
     int thread_id = 0;
 #endif
-    for (int i=0; i<n_beads; i++){
-      b_i = pcLookUp.get_from_pool(i); 
-      b_index_i = b_i->index; 
-
-      type_i = b_types[b_index_i]; 
-      e_i = b_elems[b_index_i];  
-      daddy_i = b_daddyblob[b_index_i];
-
-      for (int c=0; c<27; c++) {
-        b_j = pcLookUp.get_top_of_stack(b_i->x + adjacent_cells[c][0], 
-                                        b_i->y + adjacent_cells[c][1],
-                                        b_i->z + adjacent_cells[c][2]);
-  
-        while (b_j != nullptr) {
-           b_index_j = b_j->index;
-           if (b_index_j == b_index_i) {
-             b_j = b_j->next; 
-             continue; 
-           } 
-
-           if (!isPairActive[type_i*ntypes+b_types[b_index_j]]) {
-             b_j = b_j->next; 
-             continue; 
-           }
-
-           daddy_j = b_daddyblob[b_index_j];
-           if (blob_corr.empty()) {
-             dx[0] = (b_pos[3*b_index_j  ] - b_pos[3*b_index_i  ]);
-             dx[1] = (b_pos[3*b_index_j+1] - b_pos[3*b_index_i+1]);
-             dx[2] = (b_pos[3*b_index_j+2] - b_pos[3*b_index_i+2]);
-           } else {
-             dx[0] = (b_pos[3*b_index_j  ] - blob_corr[3*(daddy_i*num_blobs + daddy_j)   ] - b_pos[3*b_index_i  ]);
-             dx[1] = (b_pos[3*b_index_j+1] - blob_corr[3*(daddy_i*num_blobs + daddy_j) +1] - b_pos[3*b_index_i+1]);
-             dx[2] = (b_pos[3*b_index_j+2] - blob_corr[3*(daddy_i*num_blobs + daddy_j) +2] - b_pos[3*b_index_i+2]);
-           }
-           d = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2]; 
-           if (d > x_range2[1]) {
-             b_j = b_j->next; 
-             continue; 
-           }
-           else if (d < x_range2[0]) {
-             b_j = b_j->next; 
-             continue; 
-           }
-           d = sqrt(d);
-           dx[0] = dx[0] / d;
-           dx[1] = dx[1] / d;
-           dx[2] = dx[2] / d;
- 
-           f_ij = get_F(d, type_i, b_types[b_index_j]); 
-           // += the force: 
-           resize3(f_ij, dx, arr_view<scalar,3>(b_forces, 3*b_index_i) );
+    scalar *fx = &t_forces[3*n_beads*thread_id];
+    scalar *fy = fx + n_beads;
+    scalar *fz = fy + n_beads;
+    scalar *u = &t_u[n_beads*thread_id];
+    scalar *fe = &fieldenergy[thread_id*num_blobs*num_blobs];
+    std::fill(fx, fx + 3*n_beads, 0.);
 
-           // e_j = b_elems[b_index_j];
-           // fieldenergy[(thread_id*num_blobs + e_i->daddy_blob->blob_index) * num_blobs + e_j->daddy_blob->blob_index] += 0.5*get_U(d, type_i, b_types[b_index_j]);
-           fieldenergy[(thread_id*num_blobs + daddy_i) * num_blobs + daddy_j] += 0.5*get_U(d, type_i, b_types[b_index_j]);
-
-           b_j = b_j->next; 
-        } // close b_j, beads in neighbour voxel loop 
-      } // close c, 27 voxels loop 
-    }  // close i, n_beads loop
+#ifdef USE_OPENMP
+    #pragma omp for schedule(dynamic, 1)
+#endif
+    for (int oc=0; oc<num_occupied; oc++) {
+      int c = occupied_cells[oc];
+      int cx = c / (pcVoxelsInBox[1]*pcVoxelsInBox[2]);
+      int cy = (c / pcVoxelsInBox[2]) % pcVoxelsInBox[1];
+      int cz = c % pcVoxelsInBox[2];
+      for (int h=0; h<14; h++) {
+        int nx = (cx + half_shell_cells[h][0] + pcVoxelsInBox[0]) % pcVoxelsInBox[0];
+        int ny = (cy + half_shell_cells[h][1] + pcVoxelsInBox[1]) % pcVoxelsInBox[1];
+        int nz = (cz + half_shell_cells[h][2] + pcVoxelsInBox[2]) % pcVoxelsInBox[2];
+        int cn = (nx*pcVoxelsInBox[1] + ny)*pcVoxelsInBox[2] + nz;
+        if (cell_start[cn] == cell_start[cn+1]) continue;
+        for (int i=cell_start[c]; i<cell_start[c+1]; i++) {
+          // within the own cell take j > i. For a neighbour cell that wraps 
+          //   onto the own cell (boxes 1 or 2 cells wide), all j != i,
+          //   so pairs are counted as often as with the full 27 cell stencil.
+          int j0 = (h == 0) ? i + 1 : cell_start[cn];
+          calc_slot_interactions(i, j0, cell_start[cn+1], corr, fx, fy, fz, u, fe);
+        }
+      }
+    }
 
+    // 3 - Add up the forces of all the threads:
+#ifdef USE_OPENMP
+    #pragma omp for
+#endif
+    for (int s=0; s<n_beads; s++) {
+      scalar f[3] = {0, 0, 0};
+      for (int t=0; t<num_threads; t++) {
+        for (int k=0; k<3; k++) {
+          f[k] += t_forces[3*n_beads*t + k*n_beads + s];
+        }
+      }
+      int b = slot_bead[s];
+      b_forces[3*b  ] = f[0];
+      b_forces[3*b+1] = f[1];
+      b_forces[3*b+2] = f[2];
+    }
 
+    // 4 - and work out the force on the nodes of each element (elements share nodes,
+    //       so these are staged and added to the nodes afterwards, in a fixed order):
+#ifdef USE_OPENMP
     #pragma omp for
+#endif
     for (int i=0; i<num_diff_elems; i++) {
-      e_i = b_unq_elems[i]; 
+      arr3 *f_i = &unq_elem_forces[4*i];
+      for (int k=0; k<4; k++) f_i[k].fill(0);
       for (int j=map_e_to_b[2*i]; j<=map_e_to_b[2*i+1]; j++) {
-        b_index_i = j; 
+        int b_index_i = j; 
 
         phi_i[1] = b_rel_pos[3*b_index_i  ];
         phi_i[2] = b_rel_pos[3*b_index_i+1];
@@ -614,13 +631,98 @@ void PreComp_solver::solve_using_neighbours_non_critical(const std::vector<scala
         // fix input force:
         for (int k=0; k<4; k++) {
           resize2(-phi_i[k], arr_view<scalar,3>(b_forces, 3*b_index_i), dxik); 
-          e_i->add_force_to_node(k, dxik);
+          for (int l=0; l<3; l++) f_i[k][l] += dxik[l];
         } // close k, nodes for the elements.
       }
     } 
 #ifdef USE_OPENMP
     }
 #endif
+
+    // 5 - apply them to the nodes:
+    for (int i=0; i<num_diff_elems; i++) {
+      e_i = b_unq_elems[i];
+      for (int k=0; k<4; k++) {
+        e_i->add_force_to_node(k, unq_elem_forces[4*i+k]);
+      }
+    }
+}
+
+void PreComp_solver::calc_slot_interactions(int i, int j0, int j1, const scalar *corr,
+                                            scalar *fx, scalar *fy, scalar *fz, scalar *u, scalar *fe) {
+    const scalar xi = s_x[i], yi = s_y[i], zi = s_z[i];
+    const int *pt = &pair_table[s_type[i]*ntypes];
+    const int daddy_i = s_daddy[i];
+    const scalar *ci = &corr[3*daddy_i*num_blobs];
+    const scalar iDxs = 1 / Dxs;
+    const scalar xmax = n_intervals;
+    const scalar *S = spline.data();
+    const int *sd = s_daddy.data(), *st = s_type.data();
+    const scalar *sx = s_x.data(), *sy = s_y.data(), *sz = s_z.data();
+
+    scalar fxi = 0, fyi = 0, fzi = 0;
+    #pragma omp simd reduction(+:fxi,fyi,fzi)
+    for (int j=j0; j<j1; j++) {
+      const int daddy_j = sd[j];
+      scalar dx = sx[j] - ci[3*daddy_j  ] - xi;
+      scalar dy = sy[j] - ci[3*daddy_j+1] - yi;
+      scalar dz = sz[j] - ci[3*daddy_j+2] - zi;
+      scalar r2 = dx*dx + dy*dy + dz*dz;
+      scalar d = std::sqrt(r2);
+      scalar xl = std::min(d * iDxs, xmax);
+      int k = (int) xl;
+      int off = pt[st[j]];
+      bool valid = (j != i) && (off >= 0) && (r2 <= x_range2[1]) && (r2 >= x_range2[0]) && (k < n_intervals);
+      int idx = valid ? off + 4*k : 0;
+      scalar t = xl - k;
+      scalar c0 = S[idx], c1 = S[idx+1], c2 = S[idx+2], c3 = S[idx+3];
+      scalar e = c0 + t*(c1 + t*(c2 + t*c3));
+      scalar f = -(c1 + t*(2*c2 + 3*t*c3)) * iDxs;
+      f = valid ? f / d : 0;
+      u[j] = valid ? e : 0;
+      fxi += f*dx;
+      fyi += f*dy;
+      fzi += f*dz;
+      fx[j] -= f*dx;
+      fy[j] -= f*dy;
+      fz[j] -= f*dz;
+    }
+    fx[i] += fxi;
+    fy[i] += fyi;
+    fz[i] += fzi;
+
+    for (int j=j0; j<j1; j++) {
+      if (u[j] != 0) fe[daddy_i*num_blobs + sd[j]] += u[j];
+    }
+}
+
+void PreComp_solver::build_cell_arrays() {
+   occupied_cells.clear();
+   cell_start.assign(pcVoxelsInBox[0]*pcVoxelsInBox[1]*pcVoxelsInBox[2] + 1, 0);
+   int slot = 0;
+   for (int x=0; x<pcVoxelsInBox[0]; x++) {
+     for (int y=0; y<pcVoxelsInBox[1]; y++) {
+       for (int z=0; z<pcVoxelsInBox[2]; z++) {
+         int c = (x*pcVoxelsInBox[1] + y)*pcVoxelsInBox[2] + z;
+         cell_start[c] = slot;
+         for (LinkedListNode<int> *b = pcLookUp.get_top_of_stack(x, y, z); b != nullptr; b = b->next) {
+           if (slot == n_beads) {
+             throw FFEAException("More beads than expected in the PreComp linked list.");
+           }
+           slot_bead[slot] = b->index;
+           s_type[slot] = b_types[b->index];
+           s_daddy[slot] = b_daddyblob[b->index];
+           slot += 1;
+         }
+         if (slot > cell_start[c]) occupied_cells.push_back(c);
+       }
+     }
+   }
+   cell_start.back() = slot;
+   if (slot != n_beads) {
+     throw FFEAException("Found %d beads in the PreComp linked list, but there are %d beads.", slot, n_beads);
+   }
+   cells_stale = false;
 }
 
 
@@ -959,7 +1061,9 @@ void PreComp_solver::read_tabulated_values(const PreComp_params &pc_params, stri
  * in the future.
  */
 scalar PreComp_solver::get_U(scalar x, int typei, int typej) { 
-  return finterpolate(U, x, typei, typej);
+  scalar u, f;
+  finterpolate(x, typei, typej, u, f);
+  return u;
 }
 
 
@@ -971,53 +1075,108 @@ scalar PreComp_solver::get_U(scalar x, int typei, int typej) {
  * in the future.
  */
 scalar PreComp_solver::get_F(scalar x, int typei, int typej) { 
-  return finterpolate(F, x, typei, typej);
+  scalar u, f;
+  finterpolate(x, typei, typej, u, f);
+  return f;
 }
 
-/** @brief Get the value Z value (either U or F) at x between types typei and typej.
+/** @brief Get the potential u and the force f at x between types typei and typej.
   * @details The function is currently private and accessed through get_U and get_F.
-  * For production purposes it may be reasonable to move it to public, and 
-  * remove get_U and get_F
+  * The batched version of this lives in calc_slot_interactions.
   */
-scalar PreComp_solver::finterpolate(std::vector<scalar> &Z, scalar x, int typei, int typej){
-   //scalar y0, y1;
-   scalar x0, x1;
-   int index = 0;
-   int index_l = x/Dx;
-#ifdef DEBUG
-   if (index_l < 0) 
-     cout << "WTF?!" << endl; 
-#endif
-
+void PreComp_solver::finterpolate(scalar x, int typei, int typej, scalar &u, scalar &f){
+   u = 0;
+   f = 0;
+   int k = x/Dxs;
    // check that the index is not too high (all the tables are equally long): 
-   if (index_l > n_values -2) {
-      // cout << "returned zero for x: " << x << endl; 
-      return 0.; 
-   } 
+   if (k < 0 || k >= n_intervals) return; 
 
-   // sort so that typei <= typej
-   if (typei > typej){
-     int tmp = typei;
-     typei = typej;
-     typej = tmp;
-   } 
+   int off = pair_table[typei*ntypes + typej];
+   if (off < 0) return;
 
-   // get the index to read from:
-   index = typei * ntypes;
-   if (typei > 1) {
-     index -= (typei*typei - typei)/2;
-   }
-   index += (typej - typei);
+   const scalar *c = &spline[off + 4*k];
+   scalar t = x/Dxs - k;
+   u = c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+   f = -(c[1] + t*(2*c[2] + 3*t*c[3])) / Dxs;
+}  
 
-   index = index*n_values;
-   index += index_l;
+/** Convert U and F into cubic Hermite splines. The knots are taken every 
+  *   stride points of the input tables, with stride the largest divisor of 
+  *   n_values - 1 (up to 32) for which the splines reproduce every input 
+  *   value of U and F within spline_tol times the largest value in that table.
+  *   The slopes at the knots are -F, either read or from calc_force_from_pot.
+  */
+void PreComp_solver::build_splines(const PreComp_params &pc_params) {
+
+   // dU/dx at every input point, times Dx:
+   std::vector<scalar> dU(n_values * nint);
+   for (int i=0; i<n_values * nint; i++) dU[i] = -F[i]*Dx;
+
+   // coefficients of the spline for the interval starting at input point i, with knots every s points:
+   auto coefficients = [&](int o, int i, int s, scalar *c) {
+       scalar u0 = U[o+i], u1 = U[o+i+s];
+       scalar m0 = s*dU[o+i], m1 = s*dU[o+i+s];
+       c[0] = u0;
+       c[1] = m0;
+       c[2] = 3*(u1 - u0) - 2*m0 - m1;
+       c[3] = 2*(u0 - u1) + m0 + m1;
+   };
+
+   // worst relative error of the splines at the input points, with knots every s points:
+   auto max_error = [&](int s) {
+       scalar err = 0;
+       scalar c[4] = {};
+       for (int p=0; p<nint; p++) {
+         int o = p*n_values;
+         scalar maxU = 0, maxF = 0;
+         for (int i=0; i<n_values; i++) {
+           maxU = std::max(maxU, fabs(U[o+i]));
+           maxF = std::max(maxF, fabs(dU[o+i]));
+         }
+         if (maxU == 0 || maxF == 0) continue;
+         for (int i=0; i<n_values-1; i++) {
+           int i0 = (i/s)*s;
+           if (i == i0) coefficients(o, i0, s, c);
+           scalar t = scalar(i - i0)/s;
+           scalar u = c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+           scalar du = (c[1] + t*(2*c[2] + 3*t*c[3])) / s;
+           err = std::max(err, fabs(u - U[o+i]) / maxU);
+           err = std::max(err, fabs(du - dU[o+i]) / maxF);
+         }
+       }
+       return err;
+   };
+
+   int stride = 1;
+   if (pc_params.spline_tol > 0) {
+     for (int s=std::min(32, n_values-1); s>1; s--) {
+       if ((n_values - 1) % s != 0) continue;
+       if (max_error(s) <= pc_params.spline_tol) {
+         stride = s;
+         break;
+       }
+     }
+   }
 
+   n_intervals = (n_values - 1) / stride;
+   Dxs = Dx * stride;
+   try {
+       spline = std::vector<scalar>(4 * n_intervals * nint);
+   } catch (std::bad_alloc &) {
+       throw FFEAException("Failed to allocate memory for the splines in PreComp_solver::init.");
+   }
+   for (int p=0; p<nint; p++) {
+     for (int k=0; k<n_intervals; k++) {
+       coefficients(p*n_values, k*stride, stride, &spline[4*(p*n_intervals + k)]);
+     }
+   }
+   printf("PreComp tables stored as cubic splines with knots every %d input points (%d values per table instead of %d)\n",
+          stride, 4*n_intervals, 2*n_values);
 
-   // interpolate:
-   x0 = index_l * Dx; 
-   x1 = x0 + Dx; 
-   return Z[index] + (Z[index +1] - Z[index])*(x - x0)/Dx;
-}  
+   // the input tables are not needed any more:
+   U = std::vector<scalar>();
+   F = std::vector<scalar>();
+}
 
 scalar PreComp_solver::get_field_energy(int index0, int index1) {
 	// Sum over all field
@@ -1045,6 +1204,7 @@ scalar PreComp_solver::get_field_energy(int index0, int index1) {
 
 
 void PreComp_solver::build_pc_nearest_neighbour_lookup() {
+   cells_stale = true;
    pcLookUp.clear(); 
    int x, y, z; 
    for (int i=0; i<n_beads; i++) {
@@ -1068,6 +1228,7 @@ void PreComp_solver::prebuild_pc_nearest_neighbour_lookup_and_swap() {
      pcLookUp.add_node_to_stack_shadow(i, x, y, z); 
    }
    pcLookUp.safely_swap_layers();
+   cells_stale = true;
 }
 
 
@@ -1088,6 +1249,7 @@ void PreComp_solver::prebuild_pc_nearest_neighbour_lookup() {
 
 void PreComp_solver::safely_swap_pc_layers() {
    pcLookUp.safely_swap_layers();
+   cells_stale = true;
 }
   
 void PreComp_solver::write_beads_to_file(FILE *fout, int timestep){
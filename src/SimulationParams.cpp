@@ -41,10 +41,13 @@ SimulationParams::SimulationParams()
     sticky_wall_xz = 0;
     ssint_type = "ljsteric";
     ssint_cutoff = 3e-9 / mesoDimensions::length;
+    ssint_farfield_ratio = 0;
     calc_steric = 1;
     calc_steric_rod = 0;
     calc_vdw_rod = 0;
     pbc_rod = 0;
+    rod_traj_format = "text";
+    rod_traj_diagnostics = 0;
     steric_factor = 1;
     steric_dr = 5e-3;
     move_into_box = 1;
@@ -60,6 +63,7 @@ SimulationParams::SimulationParams()
     stokes_visc = 1e-3 / (mesoDimensions::pressure * mesoDimensions::time);
     calc_kinetics = 0;
     kinetics_update = 0;
+    kinetics_solver_cache = 2;
     calc_preComp = 0;
     force_pbc = 0;
     calc_springs = 0;
@@ -100,6 +104,7 @@ SimulationParams::SimulationParams()
     bsite_in_fname_set = 0;
     ssint_in_fname_set = 0;
     rod_lj_in_fname_set = 0;
+    rod_traj_out_fname_set = 0;
     trajbeads_fname_set = 0;
 
     trajectory_out_fname = "\n";
@@ -108,6 +113,7 @@ SimulationParams::SimulationParams()
     ssint_in_fname = "\n";
     bsite_in_fname = "\n";
     rod_lj_in_fname = "\n";
+    rod_traj_out_fname = "\n";
     icheckpoint_fname = "\n";
     ocheckpoint_fname = "\n";
     detailed_meas_out_fname = "\n";
@@ -134,6 +140,7 @@ SimulationParams::~SimulationParams()
     epsilon2 = 0;
     es_update = 0;
     kinetics_update = 0;
+    kinetics_solver_cache = 2;
     es_N_x = -1;
     es_N_y = -1;
     es_N_z = -1;
@@ -147,11 +154,14 @@ SimulationParams::~SimulationParams()
     inc_self_ssint = 0;
     ssint_type = "";
     ssint_cutoff = 0;
+    ssint_farfield_ratio = 0;
     calc_steric = 0;
     // ! please merge rod and blob parameters
     calc_steric_rod = 0;
     calc_vdw_rod = 0;
     pbc_rod = 0;
+    rod_traj_format = "text";
+    rod_traj_diagnostics = 0;
     // --------------------------------------
     calc_es = 0;
     calc_noise = 0;
@@ -187,6 +197,7 @@ SimulationParams::~SimulationParams()
     bsite_in_fname_set = 0;
     ssint_in_fname_set = 0;
     rod_lj_in_fname_set = 0;
+    rod_traj_out_fname_set = 0;
 
     trajectory_out_fname = "\n";
     measurement_out_fname = "\n";
@@ -196,6 +207,7 @@ SimulationParams::~SimulationParams()
     bsite_in_fname = "\n";
     ssint_in_fname = "\n";
     rod_lj_in_fname = "\n";
+    rod_traj_out_fname = "\n";
     detailed_meas_out_fname = "\n";
     ctforces_fname = "\n";
     springs_fname = "\n";
@@ -363,6 +375,12 @@ void SimulationParams::assign(string lvalue, string rvalue)
         if (userInfo::verblevel > 1)
             cout << "\tSetting " << lvalue << " = " << kinetics_update << endl;
     }
+    else if (lvalue == "kinetics_solver_cache")
+    {
+        kinetics_solver_cache = atoi(rvalue.c_str());
+        if (userInfo::verblevel > 1)
+            cout << "\tSetting " << lvalue << " = " << kinetics_solver_cache << endl;
+    }
     else if (lvalue == "es_N_x")
     {
         es_N_x = atoi(rvalue.c_str());
@@ -468,6 +486,18 @@ void SimulationParams::assign(string lvalue, string rvalue)
         if (userInfo::verblevel > 1)
             cout << "\tSetting " << lvalue << " = " << pbc_rod << endl;
     }
+    else if (lvalue == "rod_traj_format")
+    {
+        rod_traj_format = rvalue;
+        if (userInfo::verblevel > 1)
+            cout << "\tSetting " << lvalue << " = " << rod_traj_format << endl;
+    }
+    else if (lvalue == "rod_traj_diagnostics")
+    {
+        rod_traj_diagnostics = atoi(rvalue.c_str());
+        if (userInfo::verblevel > 1)
+            cout << "\tSetting " << lvalue << " = " << rod_traj_diagnostics << endl;
+    }
     else if (lvalue == "inc_self_ssint" || lvalue == "inc_self_vdw")
     {
         inc_self_ssint = atoi(rvalue.c_str());
@@ -542,6 +572,12 @@ void SimulationParams::assign(string lvalue, string rvalue)
             cout << "\tSetting " << lvalue << " = " << ssint_cutoff << endl;
         ssint_cutoff /= mesoDimensions::length;
     }
+    else if (lvalue == "ssint_farfield_ratio")
+    {
+        ssint_farfield_ratio = atof(rvalue.c_str());
+        if (userInfo::verblevel > 1)
+            cout << "\tSetting " << lvalue << " = " << ssint_farfield_ratio << endl;
+    }
     else if (lvalue == "steric_factor" || lvalue == "vdw_steric_factor")
     {
         steric_factor = atof(rvalue.c_str());
@@ -732,6 +768,14 @@ void SimulationParams::assign(string lvalue, string rvalue)
         if (userInfo::verblevel > 1)
             cout << "\tSetting " << lvalue << " = " << rod_lj_in_fname << endl;
     }
+    else if (lvalue == "rod_traj_out_fname")
+    {
+        fs::path auxpath = FFEA_script_path / rvalue;
+        rod_traj_out_fname = auxpath.string();
+        rod_traj_out_fname_set = 1;
+        if (userInfo::verblevel > 1)
+            cout << "\tSetting " << lvalue << " = " << rod_traj_out_fname << endl;
+    }
     else if (lvalue == "checkpoint_in")
     {
         fs::path auxpath = FFEA_script_path / rvalue;
@@ -851,6 +895,14 @@ void SimulationParams::validate(int sim_mode) {
         throw FFEAException("Required: 'calc_steric_rod', must be 0 (no) or 1 (yes).");
     }
 
+    if (rod_traj_format != "text" && rod_traj_format != "binary") {
+        throw FFEAException("Required: 'rod_traj_format' must be set to 'text' or 'binary'.");
+    }
+
+    if (rod_traj_diagnostics != 0 && rod_traj_diagnostics != 1) {
+        throw FFEAException("Required: 'rod_traj_diagnostics', must be 0 (no) or 1 (yes).");
+    }
+
     if (flow_profile != "none" && flow_profile != "uniform" && flow_profile != "shear") {
         throw FFEAException("Required: 'flow_profile' must be set to 'none', 'uniform' or 'shear'.");
     } else if (flow_profile == "none") {
@@ -887,6 +939,10 @@ void SimulationParams::validate(int sim_mode) {
         throw FFEAException("'ssint_cutoff' must be positive and larger than zero.");
     }
 
+    if (ssint_farfield_ratio < 0) {
+        throw FFEAException("'ssint_farfield_ratio' must be 0 (always use the 3x3 point rule) or positive.");
+    }
+
     if (calc_ssint == 1) {
 
         // Steric is now separate
@@ -979,6 +1035,12 @@ void SimulationParams::validate(int sim_mode) {
         measurement_out_fname = auxpath.string();
     }
 
+    if (rod_traj_out_fname_set == 0) {
+        fs::path auxpath = trajectory_out_fname;
+        auxpath.replace_extension(".rodbin");
+        rod_traj_out_fname = auxpath.string();
+    }
+
     // Three checkings for checkpoint files:
     // CPT.1 - If we don't have a name for checkpoint_out we're assigning one.
     if (ocheckpoint_fname_set == 0) {
@@ -1037,6 +1099,10 @@ void SimulationParams::validate(int sim_mode) {
         //throw FFEAException("\t'kinetics_update' < 'check'. A kinetic switch therefore maybe missed i.e. not printed to the output files.")
         //}
 
+        if (kinetics_solver_cache < 1) {
+            throw FFEAException("\tRequired: 'kinetics_solver_cache' must be at least 1 (the active conformation).");
+        }
+
         // num_conformations[i] can be > num_states[i], so long as none of the states reference an out of bounds conformation
     } else {
         if (num_conformations.empty()) {
@@ -1165,6 +1231,7 @@ void SimulationParams::write_to_file(FILE *fout, PreComp_params &pc_params)
         fprintf(fout, "\tssint_type = %s\n", ssint_type.c_str());
         fprintf(fout, "\tinc_self_ssint = %d\n", inc_self_ssint);
         fprintf(fout, "\tssint_cutoff = %e\n", ssint_cutoff * mesoDimensions::length);
+        fprintf(fout, "\tssint_farfield_ratio = %e\n", ssint_farfield_ratio);
 
         fprintf(fout, "\tssint_in_fname = %s\n", ssint_in_fname.c_str());
         if (calc_steric == 1)
@@ -1184,6 +1251,15 @@ void SimulationParams::write_to_file(FILE *fout, PreComp_params &pc_params)
     fprintf(fout, "\tforce_pbc = %d\n", force_pbc);
     fprintf(fout, "\tmove_into_box = %d\n", move_into_box);
     fprintf(fout, "\tpbc_rod = %d\n", pbc_rod);
+    if (num_rods > 0)
+    {
+        fprintf(fout, "\trod_traj_format = %s\n", rod_traj_format.c_str());
+        if (rod_traj_format == "binary")
+        {
+            fprintf(fout, "\trod_traj_out_fname = %s\n", rod_traj_out_fname.c_str());
+            fprintf(fout, "\trod_traj_diagnostics = %d\n", rod_traj_diagnostics);
+        }
+    }
 
     if (calc_preComp == 1)
     {
@@ -1192,6 +1268,7 @@ void SimulationParams::write_to_file(FILE *fout, PreComp_params &pc_params)
         fprintf(fout, "\tfolder = %s\n", pc_params.folder.c_str());
         fprintf(fout, "\tdist_to_m = %e\n", pc_params.dist_to_m);
         fprintf(fout, "\tE_to_J = %e\n", pc_params.E_to_J);
+        fprintf(fout, "\tspline_tol = %e\n", pc_params.spline_tol);
         fprintf(fout, "\n");
     }
 
@@ -1217,6 +1294,7 @@ void SimulationParams::write_to_file(FILE *fout, PreComp_params &pc_params)
             fprintf(fout, "\tbsite_in_fname = %s\n", bsite_in_fname.c_str());
         }
         fprintf(fout, "\tkinetics_update = %d\n", kinetics_update);
+        fprintf(fout, "\tkinetics_solver_cache = %d\n", kinetics_solver_cache);
         fprintf(fout, "\n");
     }
 
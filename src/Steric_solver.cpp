@@ -26,13 +26,7 @@
 
 /** do_volumeExclusion calculates the force (and not the energy, yet) of two tetrahedra */
 void Steric_solver::do_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr){
-    if (blob_corr.empty()) {
-       if (! f1->checkTetraIntersection(f2))
-           return;
-    } else {
-       if (! f1->checkTetraIntersection(f2,
-            blob_corr,f1->daddy_blob->blob_index, f2->daddy_blob->blob_index))
-           return;
-    } 
+    if (! steric_overlap(f1, f2, blob_corr))
+        return;
     do_steric_interaction(f1, f2, blob_corr); 
 }
@@ -0,0 +1,314 @@
+// 
+//  This file is part of the FFEA simulation package
+//  
+//  Copyright (c) by the Theory and Development FFEA teams,
+//  as they appear in the README.md file. 
+// 
+//  FFEA is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+// 
+//  FFEA is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+// 
+//  You should have received a copy of the GNU General Public License
+//  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//  To help us fund FFEA development, we humbly ask that you cite 
+//  the research papers on the package.
+//
+
+#include "TetraElementBlock.h"
+
+#include <algorithm>
+
+#include "mat_vec_fns_II.h"
+
+void TetraElementBlock::init(std::vector<tetra_element_linear> &elem, int num_force_nodes) {
+    num_elements = static_cast<int>(elem.size());
+
+    // Colour the elements greedily, in order, so that no two elements of the same colour share
+    // any of the num_force_nodes nodes that they put a force on
+    int num_nodes = 0;
+    for (auto &elem_i : elem) {
+        for (int i = 0; i < num_force_nodes; ++i) {
+            num_nodes = std::max(num_nodes, elem_i.n[i]->index + 1);
+        }
+    }
+    std::vector<std::vector<int>> node_colours(num_nodes);
+    std::vector<int> colour(num_elements);
+    std::vector<int> taken; // taken[c] == e if colour c is already used by a neighbour of element e
+    int num_colours = 0;
+    for (int e = 0; e < num_elements; ++e) {
+        for (int i = 0; i < num_force_nodes; ++i) {
+            for (int c : node_colours[elem[e].n[i]->index]) {
+                taken[c] = e;
+            }
+        }
+        int c = 0;
+        while (c < num_colours && taken[c] == e) {
+            c++;
+        }
+        if (c == num_colours) {
+            taken.push_back(-1);
+            num_colours++;
+        }
+        colour[e] = c;
+        for (int i = 0; i < num_force_nodes; ++i) {
+            node_colours[elem[e].n[i]->index].push_back(c);
+        }
+    }
+
+    // Sort the elements by colour (keeping their order within each colour) into their slots
+    std::vector<int> colour_slot_start(num_colours + 1, 0);
+    for (int e = 0; e < num_elements; ++e) {
+        colour_slot_start[colour[e] + 1]++;
+    }
+    for (int c = 0; c < num_colours; ++c) {
+        colour_slot_start[c + 1] += colour_slot_start[c];
+    }
+    element = std::vector<int>(num_elements);
+    slot = std::vector<int>(num_elements);
+    std::vector<int> next_slot(colour_slot_start.begin(), colour_slot_start.end() - 1);
+    for (int e = 0; e < num_elements; ++e) {
+        slot[e] = next_slot[colour[e]]++;
+        element[slot[e]] = e;
+    }
+
+    // Split each colour into batches
+    batch_start = std::vector<int>(1, 0);
+    colour_start = std::vector<int>(1, 0);
+    for (int c = 0; c < num_colours; ++c) {
+        for (int s = colour_slot_start[c]; s < colour_slot_start[c + 1]; s += TETRA_ELEMENT_BATCH_SIZE) {
+            batch_start.push_back(std::min(s + TETRA_ELEMENT_BATCH_SIZE, colour_slot_start[c + 1]));
+        }
+        colour_start.push_back(static_cast<int>(batch_start.size()) - 1);
+    }
+
+    for (auto &index : node_index) {
+        index = std::vector<int>(num_elements);
+    }
+    for (auto &J_inv_0_ij : J_inv_0) {
+        J_inv_0_ij = std::vector<scalar>(num_elements);
+    }
+    vol_0 = std::vector<scalar>(num_elements);
+    vol = std::vector<scalar>(num_elements);
+    last_det = std::vector<scalar>(num_elements);
+    A = std::vector<scalar>(num_elements);
+    B = std::vector<scalar>(num_elements);
+    G = std::vector<scalar>(num_elements);
+    E = std::vector<scalar>(num_elements);
+    sqrt_A = std::vector<scalar>(num_elements);
+    sqrt_2A = std::vector<scalar>(num_elements);
+    sqrt_B = std::vector<scalar>(num_elements);
+    F_ij = std::vector<matrix3>(num_elements);
+    internal_stress_mag = std::vector<scalar>(num_elements, 0);
+
+    for (int s = 0; s < num_elements; ++s) {
+        const tetra_element_linear &elem_s = elem[element[s]];
+        for (int i = 0; i < NUM_NODES_LINEAR_TET; ++i) {
+            node_index[i][s] = elem_s.n[i]->index;
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                J_inv_0[3 * i + j][s] = elem_s.J_inv_0[i][j];
+            }
+        }
+        vol_0[s] = elem_s.vol_0;
+        vol[s] = elem_s.vol;
+        last_det[s] = elem_s.last_det;
+        A[s] = elem_s.A;
+        B[s] = elem_s.B;
+        G[s] = elem_s.G;
+        E[s] = elem_s.E;
+        sqrt_A[s] = sqrt(elem_s.A);
+        sqrt_2A[s] = sqrt(2 * elem_s.A);
+        sqrt_B[s] = sqrt(elem_s.B);
+        F_ij[s] = elem_s.F_ij;
+    }
+}
+
+void TetraElementBlock::draw_noise(int begin, int end, std::shared_ptr<std::vector<RngStream>> &rng, int thread_id, TetraElementBatch &batch) const {
+    for (int e = begin; e < end; ++e) {
+        for (int k = 0; k < 7; ++k) {
+            batch.noise[k][e - begin] = RAND(-.5, .5);
+        }
+    }
+}
+
+/*
+ * This is calculate_jacobian(), calc_shape_function_derivatives_and_volume(), add_shear_elastic_stress(),
+ * add_bulk_elastic_stress(), add_fluctuating_stress() and apply_stress_tensor() of tetra_element_linear,
+ * written out for one element per SIMD lane so that everything stays in registers.
+ */
+FFEA_SIMD_DISPATCH
+int TetraElementBlock::calc_stress_forces(int begin, int end, const std::vector<mesh_node> &node, const std::vector<arr3> &vel,
+                                          const SimulationParams &params, bool calc_viscous, TetraElementBatch &batch) {
+    const mesh_node *nd = node.data();
+    const arr3 *vl = vel.data();
+    const int *n0 = &node_index[0][begin], *n1 = &node_index[1][begin], *n2 = &node_index[2][begin], *n3 = &node_index[3][begin];
+    const scalar *J_inv_0_00 = &J_inv_0[0][begin], *J_inv_0_01 = &J_inv_0[1][begin], *J_inv_0_02 = &J_inv_0[2][begin];
+    const scalar *J_inv_0_10 = &J_inv_0[3][begin], *J_inv_0_11 = &J_inv_0[4][begin], *J_inv_0_12 = &J_inv_0[5][begin];
+    const scalar *J_inv_0_20 = &J_inv_0[6][begin], *J_inv_0_21 = &J_inv_0[7][begin], *J_inv_0_22 = &J_inv_0[8][begin];
+    const scalar *vol_0_b = &vol_0[begin], *A_b = &A[begin], *B_b = &B[begin], *G_b = &G[begin], *E_b = &E[begin];
+    const scalar *sqrt_A_b = &sqrt_A[begin], *sqrt_2A_b = &sqrt_2A[begin], *sqrt_B_b = &sqrt_B[begin];
+    scalar *vol_b = &vol[begin], *last_det_b = &last_det[begin], *stress_mag_b = &internal_stress_mag[begin];
+    scalar *F_b = &F_ij[begin][0][0];
+    const bool calc_noise = (params.calc_noise == 1);
+    const scalar noise_scale = 24 * params.kT;
+    const int n = end - begin;
+
+    int num_inversions = 0;
+    #pragma omp simd reduction(+:num_inversions)
+    for (int l = 0; l < n; l++) {
+        const arr3 &p0 = nd[n0[l]].pos, &p1 = nd[n1[l]].pos, &p2 = nd[n2[l]].pos, &p3 = nd[n3[l]].pos;
+
+        // Jacobian
+        const scalar J00 = p1[0] - p0[0], J01 = p1[1] - p0[1], J02 = p1[2] - p0[2];
+        const scalar J10 = p2[0] - p0[0], J11 = p2[1] - p0[1], J12 = p2[2] - p0[2];
+        const scalar J20 = p3[0] - p0[0], J21 = p3[1] - p0[1], J22 = p3[2] - p0[2];
+
+        // Shape function derivatives (for nodes 2 to 4, scaled by det below) and the determinant
+        scalar d2x = J22 * J11 - J21 * J12;
+        scalar d3x = J21 * J02 - J22 * J01;
+        scalar d4x = J12 * J01 - J11 * J02;
+        scalar d2y = J20 * J12 - J22 * J10;
+        scalar d3y = J22 * J00 - J20 * J02;
+        scalar d4y = J10 * J02 - J12 * J00;
+        scalar d2z = J21 * J10 - J20 * J11;
+        scalar d3z = J20 * J01 - J21 * J00;
+        scalar d4z = J11 * J00 - J10 * J01;
+        const scalar det = J00 * d2x + J10 * d3x + J20 * d4x;
+
+        // Check if element has inverted itself (determinant changed sign), otherwise update the volume
+        const bool inverted = last_det_b[l] * det < 0;
+        batch.inverted[l] = inverted;
+        num_inversions += inverted;
+        const scalar vol_l = inverted ? vol_b[l] : (1.0 / 6.0) * fabs(det);
+        last_det_b[l] = inverted ? last_det_b[l] : det;
+        vol_b[l] = vol_l;
+
+        const scalar det_inv = 1.0 / det;
+        d2x *= det_inv; d3x *= det_inv; d4x *= det_inv;
+        d2y *= det_inv; d3y *= det_inv; d4y *= det_inv;
+        d2z *= det_inv; d3z *= det_inv; d4z *= det_inv;
+        const scalar d1x = -(d2x + d3x + d4x);
+        const scalar d1y = -(d2y + d3y + d4y);
+        const scalar d1z = -(d2z + d3z + d4z);
+
+        // Deformation gradient (F_ij transpose is the current jacobian times the rest state jacobian inverse)
+        const scalar F00 = J00 * J_inv_0_00[l] + J10 * J_inv_0_01[l] + J20 * J_inv_0_02[l];
+        const scalar F01 = J00 * J_inv_0_10[l] + J10 * J_inv_0_11[l] + J20 * J_inv_0_12[l];
+        const scalar F02 = J00 * J_inv_0_20[l] + J10 * J_inv_0_21[l] + J20 * J_inv_0_22[l];
+        const scalar F10 = J01 * J_inv_0_00[l] + J11 * J_inv_0_01[l] + J21 * J_inv_0_02[l];
+        const scalar F11 = J01 * J_inv_0_10[l] + J11 * J_inv_0_11[l] + J21 * J_inv_0_12[l];
+        const scalar F12 = J01 * J_inv_0_20[l] + J11 * J_inv_0_21[l] + J21 * J_inv_0_22[l];
+        const scalar F20 = J02 * J_inv_0_00[l] + J12 * J_inv_0_01[l] + J22 * J_inv_0_02[l];
+        const scalar F21 = J02 * J_inv_0_10[l] + J12 * J_inv_0_11[l] + J22 * J_inv_0_12[l];
+        const scalar F22 = J02 * J_inv_0_20[l] + J12 * J_inv_0_21[l] + J22 * J_inv_0_22[l];
+        scalar *F = F_b + 9 * l;
+        F[0] = F00; F[1] = F01; F[2] = F02;
+        F[3] = F10; F[4] = F11; F[5] = F12;
+        F[6] = F20; F[7] = F21; F[8] = F22;
+
+        // Shear elastic stress
+        const scalar G_l = G_b[l], vol_0_l = vol_0_b[l];
+        const scalar shear = G_l * vol_0_l / vol_l;
+        scalar s00 = (F00 * F00 + F01 * F01 + F02 * F02) * shear - G_l;
+        scalar s11 = (F10 * F10 + F11 * F11 + F12 * F12) * shear - G_l;
+        scalar s22 = (F20 * F20 + F21 * F21 + F22 * F22) * shear - G_l;
+        scalar s01 = (F00 * F10 + F01 * F11 + F02 * F12) * shear;
+        scalar s02 = (F00 * F20 + F01 * F21 + F02 * F22) * shear;
+        scalar s12 = (F10 * F20 + F11 * F21 + F12 * F22) * shear;
+
+        // Bulk elastic stress
+        const scalar c_2 = E_b[l] - G_l * 2.0 / 3.0;
+        const scalar c = G_l * (1.0 - (vol_0_l / vol_l)) + 0.5 * c_2 * ((vol_l / vol_0_l) - (vol_0_l / vol_l));
+        s00 += c;
+        s11 += c;
+        s22 += c;
+
+        // Fluctuating stress
+        if (calc_noise) {
+            const scalar c_noise = sqrt(noise_scale / (vol_l * params.dt));
+            const scalar bf = sqrt_B_b[l] * batch.noise[0][l];
+            s00 += c_noise * (sqrt_2A_b[l] * batch.noise[1][l] + bf);
+            s11 += c_noise * (sqrt_2A_b[l] * batch.noise[2][l] + bf);
+            s22 += c_noise * (sqrt_2A_b[l] * batch.noise[3][l] + bf);
+            s01 += c_noise * sqrt_A_b[l] * batch.noise[4][l];
+            s02 += c_noise * sqrt_A_b[l] * batch.noise[5][l];
+            s12 += c_noise * sqrt_A_b[l] * batch.noise[6][l];
+        }
+
+        stress_mag_b[l] = sqrt(s00 * s00 + s11 * s11 + s22 * s22 + 2 * (s01 * s01 + s02 * s02 + s12 * s12));
+
+        // Viscous stress A (L + L^T) + B tr(L) I, from the velocity gradient L_ij = dv_i/dx_j
+        if (calc_viscous) {
+            const arr3 &v0 = vl[n0[l]], &v1 = vl[n1[l]], &v2 = vl[n2[l]], &v3 = vl[n3[l]];
+            const scalar L00 = v0[0] * d1x + v1[0] * d2x + v2[0] * d3x + v3[0] * d4x;
+            const scalar L01 = v0[0] * d1y + v1[0] * d2y + v2[0] * d3y + v3[0] * d4y;
+            const scalar L02 = v0[0] * d1z + v1[0] * d2z + v2[0] * d3z + v3[0] * d4z;
+            const scalar L10 = v0[1] * d1x + v1[1] * d2x + v2[1] * d3x + v3[1] * d4x;
+            const scalar L11 = v0[1] * d1y + v1[1] * d2y + v2[1] * d3y + v3[1] * d4y;
+            const scalar L12 = v0[1] * d1z + v1[1] * d2z + v2[1] * d3z + v3[1] * d4z;
+            const scalar L20 = v0[2] * d1x + v1[2] * d2x + v2[2] * d3x + v3[2] * d4x;
+            const scalar L21 = v0[2] * d1y + v1[2] * d2y + v2[2] * d3y + v3[2] * d4y;
+            const scalar L22 = v0[2] * d1z + v1[2] * d2z + v2[2] * d3z + v3[2] * d4z;
+
+            const scalar A_l = A_b[l];
+            const scalar bulk = B_b[l] * (L00 + L11 + L22);
+            s00 += 2 * A_l * L00 + bulk;
+            s11 += 2 * A_l * L11 + bulk;
+            s22 += 2 * A_l * L22 + bulk;
+            s01 += A_l * (L01 + L10);
+            s02 += A_l * (L02 + L20);
+            s12 += A_l * (L12 + L21);
+        }
+
+        // Apply the (symmetric) stress tensor to the shape function derivatives
+        batch.du[0][l] = vol_l * (d1x * s00 + d1y * s01 + d1z * s02);
+        batch.du[1][l] = vol_l * (d2x * s00 + d2y * s01 + d2z * s02);
+        batch.du[2][l] = vol_l * (d3x * s00 + d3y * s01 + d3z * s02);
+        batch.du[3][l] = vol_l * (d4x * s00 + d4y * s01 + d4z * s02);
+        batch.du[4][l] = vol_l * (d1x * s01 + d1y * s11 + d1z * s12);
+        batch.du[5][l] = vol_l * (d2x * s01 + d2y * s11 + d2z * s12);
+        batch.du[6][l] = vol_l * (d3x * s01 + d3y * s11 + d3z * s12);
+        batch.du[7][l] = vol_l * (d4x * s01 + d4y * s11 + d4z * s12);
+        batch.du[8][l] = vol_l * (d1x * s02 + d1y * s12 + d1z * s22);
+        batch.du[9][l] = vol_l * (d2x * s02 + d2y * s12 + d2z * s22);
+        batch.du[10][l] = vol_l * (d3x * s02 + d3y * s12 + d3z * s22);
+        batch.du[11][l] = vol_l * (d4x * s02 + d4y * s12 + d4z * s22);
+
+        batch.dpsi[0][l] = d1x; batch.dpsi[1][l] = d2x; batch.dpsi[2][l] = d3x; batch.dpsi[3][l] = d4x;
+        batch.dpsi[4][l] = d1y; batch.dpsi[5][l] = d2y; batch.dpsi[6][l] = d3y; batch.dpsi[7][l] = d4y;
+        batch.dpsi[8][l] = d1z; batch.dpsi[9][l] = d2z; batch.dpsi[10][l] = d3z; batch.dpsi[11][l] = d4z;
+    }
+    return num_inversions;
+}
+
+void TetraElementBlock::create_viscosity_matrix(int s, const vector12 &dpsi, matrix12 &V) const {
+    tetra_element_linear::create_viscosity_matrix(dpsi, A[s], B[s], vol[s], V);
+}
+
+void TetraElementBlock::add_element_force_vectors(int begin, int end, const TetraElementBatch &batch, std::vector<arr3> &force) const {
+    arr3 *f = force.data();
+    // The elements of a batch are all the same colour, so they never write to the same node
+    for (int i = 0; i < NUM_NODES_LINEAR_TET; ++i) {
+        const int *n_i = &node_index[i][begin];
+        #pragma omp simd
+        for (int l = 0; l < end - begin; ++l) {
+            f[n_i[l]][0] -= batch.du[i][l];
+            f[n_i[l]][1] -= batch.du[i + 4][l];
+            f[n_i[l]][2] -= batch.du[i + 8][l];
+        }
+    }
+}
+
+void TetraElementBatch::get_dpsi(int lane, vector12 &v) const {
+    for (int i = 0; i < 12; ++i) {
+        v[i] = dpsi[i][lane];
+    }
+}
@@ -74,7 +74,7 @@ const std::array<VdW_solver::tri_gauss_point, 3> VdW_solver::gauss_points = {
     }
 };
 
-void VdW_solver::init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3 &box_size, SSINT_matrix *ssint_matrix, scalar &steric_factor, int num_blobs, int inc_self_ssint, string ssint_type_string, scalar &steric_dr, int calc_kinetics, bool working_w_static_blobs) {
+void VdW_solver::init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3 &box_size, SSINT_matrix *ssint_matrix, scalar &steric_factor, int num_blobs, int inc_self_ssint, string ssint_type_string, int calc_kinetics, bool working_w_static_blobs, scalar ssint_farfield_ratio) {
     this->surface_face_lookup = surface_face_lookup;
     this->box_size[0] = box_size[0];
     this->box_size[1] = box_size[1];
@@ -84,7 +84,7 @@ void VdW_solver::init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3
 
     this->inc_self_ssint = inc_self_ssint;
     this->steric_factor = steric_factor;
-    this->steric_dr = steric_dr;
+    this->farfield_ratio2 = ssint_farfield_ratio * ssint_farfield_ratio;
     if (ssint_type_string == "lennard-jones")
         ssint_type = SSINT_TYPE_LJ;
     else if (ssint_type_string == "steric")
@@ -111,6 +111,11 @@ void VdW_solver::init(NearestNeighbourLinkedListCube *surface_face_lookup, arr3
             throw FFEAException("Failed to allocate fieldenergy[%d] in VdW_solver::init\n", i);
         }
     }
+#ifdef USE_OPENMP
+    thread_steric_counts = std::vector<thread_steric_filter_counts>(omp_get_max_threads());
+#else
+    thread_steric_counts = std::vector<thread_steric_filter_counts>(1);
+#endif
 }
 
 /**  Zero measurement stuff, AKA fieldenergy */
@@ -128,8 +133,8 @@ void VdW_solver::solve(std::vector<scalar> &blob_corr) {
     LinkedListNode<Face> *l_j = nullptr;
     Face *f_i, *f_j;
     int c;
-    total_num_surface_faces = surface_face_lookup->get_pool_size();
-    //total_num_surface_faces = surface_face_lookup->get_stack_size();
+    // Faces of inactive conformations are not in the active set, so they are never visited here
+    total_num_surface_faces = surface_face_lookup->get_num_active();
 
     reset_fieldenergy();
     int motion_state_i;
@@ -141,10 +146,7 @@ void VdW_solver::solve(std::vector<scalar> &blob_corr) {
     for (int i = 0; i < total_num_surface_faces; i++) {
 
         // get the ith face
-        l_i = surface_face_lookup->get_from_pool(i);
-        if ((calc_kinetics == 1) && (!l_i->obj->is_kinetic_active()) ) {
-            continue;
-        }
+        l_i = surface_face_lookup->get_active_from_pool(i);
         f_i = l_i->obj;
         if (working_w_static_blobs) motion_state_i = f_i->daddy_blob->get_motion_state();
         int l_index_i = l_i->index;
@@ -164,6 +166,15 @@ void VdW_solver::solve(std::vector<scalar> &blob_corr) {
             }
         }
     }
+
+    // Add up the steric filter counts of all the threads
+    for (auto &thread_counts : thread_steric_counts) {
+        steric_counts.tested += thread_counts.counts.tested;
+        steric_counts.rejected_bounds += thread_counts.counts.rejected_bounds;
+        steric_counts.rejected_sat += thread_counts.counts.rejected_sat;
+        steric_counts.rejected_volume += thread_counts.counts.rejected_volume;
+        thread_counts.counts = steric_filter_counts();
+    }
 }
 
 
@@ -189,16 +200,42 @@ void VdW_solver::solve_sticky_wall(scalar h) {
 }
 
 void VdW_solver::do_lj_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr) {
+    do_ssint_interaction(ssint_type, f1, f2, blob_corr);
+}
+
+void VdW_solver::do_ssint_interaction(int type, Face *f1, Face *f2, std::vector<scalar> &blob_corr) {
 
     int f1_daddy_blob_index = f1->daddy_blob->blob_index;
     int f2_daddy_blob_index = f2->daddy_blob->blob_index;
 
-    // Get the interaction LJ parameters for these two face types
-    //scalar Emin = 0.0, Rmin = 0.0;
-    map<string, scalar> pmap;
-    pmap = ssint_matrix->get_SSINT_params(f1->ssint_interaction_type, f2->ssint_interaction_type);
-    arr3 p[num_tri_gauss_quad_points], q[num_tri_gauss_quad_points];
-    arr3 force_pair_matrix[num_tri_gauss_quad_points][num_tri_gauss_quad_points];
+    // Get the interaction parameters for these two face types
+    const SSINT_table &ssint = ssint_matrix->get_SSINT_table();
+    const int ip = ssint_matrix->get_SSINT_index(f1->ssint_interaction_type, f2->ssint_interaction_type);
+
+    scalar ApAq = f1->area * f2->area;
+    scalar energy = 0.0;
+    arr3 force1[3], force2[3];
+    arr3 pc, qc;
+    if (is_farfield(f1, f2, pc, qc, blob_corr)) {
+        calc_farfield_nodal_forces(type, pc, qc, ssint, ip, ApAq, force1, force2, energy);
+    } else {
+        arr3 p[num_tri_gauss_quad_points], q[num_tri_gauss_quad_points];
+        calc_gauss_points(f1, f2, p, q, blob_corr);
+        calc_nearfield_nodal_forces(type, p, q, ssint, ip, ApAq, force1, force2, energy);
+    }
+
+    #pragma omp critical
+    {
+        fieldenergy[f1_daddy_blob_index][f2_daddy_blob_index] += energy;
+        for (int j = 0; j < 3; j++) {
+            f1->add_force_to_node(j, force1[j]);
+            f2->add_force_to_node(j, force2[j]);
+        }
+    } // end of critical
+}
+
+void VdW_solver::calc_gauss_points(Face *f1, Face *f2, arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+        std::vector<scalar> &blob_corr) {
 
     // Convert all area coordinate gauss points to cartesian
     if (blob_corr.empty()) {
@@ -207,53 +244,90 @@ void VdW_solver::do_lj_interaction(Face *f1, Face *f2, std::vector<scalar> &blob
             f2->barycentric_calc_point(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], q[i]);
         }
     } else {
+        int f1_daddy_blob_index = f1->daddy_blob->blob_index;
+        int f2_daddy_blob_index = f2->daddy_blob->blob_index;
         for (int i = 0; i < num_tri_gauss_quad_points; i++) {
             f1->barycentric_calc_point_f2(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], p[i],blob_corr, f1_daddy_blob_index, f2_daddy_blob_index);
             f2->barycentric_calc_point(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], q[i]);
         }
     }
+}
+
+bool VdW_solver::is_farfield(Face *f1, Face *f2, arr3 &pc, arr3 &qc, std::vector<scalar> &blob_corr) {
+    if (farfield_ratio2 == 0)
+        return false;
+
+    const scalar third = ffea_const::oneOverThree;
+    if (blob_corr.empty()) {
+        f1->barycentric_calc_point(third, third, third, pc);
+    } else {
+        f1->barycentric_calc_point_f2(third, third, third, pc, blob_corr, f1->daddy_blob->blob_index, f2->daddy_blob->blob_index);
+    }
+    f2->barycentric_calc_point(third, third, third, qc);
+
+    // Radius of each face: furthest vertex from its centroid
+    scalar r1_2 = 0, r2_2 = 0;
+    for (int i = 0; i < 3; i++) {
+        r1_2 = std::max(r1_2, distance2(f1->n[i]->pos, f1->centroid));
+        r2_2 = std::max(r2_2, distance2(f2->n[i]->pos, f2->centroid));
+    }
+    scalar r_sum = std::sqrt(r1_2) + std::sqrt(r2_2);
+
+    return distance2(pc, qc) > farfield_ratio2 * r_sum * r_sum;
+}
+
+void VdW_solver::calc_nearfield_nodal_forces(int type, arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+        const SSINT_table &ssint, int ip, scalar ApAq, arr3 (&force1)[3], arr3 (&force2)[3], scalar &energy) {
 
     // Construct the force pair matrix: f(p, q) where p and q are all the gauss points in each face
     // Also calculate energy whilst looping through face points
-    scalar energy = 0.0;
-    if (ssint_type == SSINT_TYPE_LJSTERIC) calc_ljinterpolated_force_pair_matrix(force_pair_matrix,
-             p, q, pmap["Rmin"], pmap["Emin"], energy);
-    else if (ssint_type == SSINT_TYPE_LJ) calc_lj_force_pair_matrix(force_pair_matrix,
-             p, q, pmap["Rmin"], pmap["Emin"], energy);
+    arr3 force_pair_matrix[num_tri_gauss_quad_points][num_tri_gauss_quad_points];
+    scalar e = 0.0;
+    calc_ssint_force_pair_matrix(type, force_pair_matrix, p, q, ssint, ip, e);
+    energy += e * ApAq;
 
-    scalar ApAq = f1->area * f2->area;
-    energy *= ApAq;
-    #pragma omp critical
-	    {
-        fieldenergy[f1_daddy_blob_index][f2_daddy_blob_index] += energy;
-        for (int j = 0; j < 3; j++) {
-            arr3 force1, force2;
-            memset(&force1, 0, sizeof(arr3));
-            memset(&force2, 0, sizeof(arr3));
-            for (int k = 0; k < num_tri_gauss_quad_points; k++) {
-                for (int l = 0; l < num_tri_gauss_quad_points; l++) {
-                    scalar c = gauss_points[k].W * gauss_points[l].W * gauss_points[l].eta[j];
-                    scalar d = gauss_points[k].W * gauss_points[l].W * gauss_points[k].eta[j];
-                    force1[0] += c * force_pair_matrix[k][l][0];
-                    force1[1] += c * force_pair_matrix[k][l][1];
-                    force1[2] += c * force_pair_matrix[k][l][2];
-
-                    force2[0] -= d * force_pair_matrix[l][k][0];
-                    force2[1] -= d * force_pair_matrix[l][k][1];
-                    force2[2] -= d * force_pair_matrix[l][k][2];
-                }
+    for (int j = 0; j < 3; j++) {
+        force1[j] = {};
+        force2[j] = {};
+        for (int k = 0; k < num_tri_gauss_quad_points; k++) {
+            for (int l = 0; l < num_tri_gauss_quad_points; l++) {
+                scalar c = gauss_points[k].W * gauss_points[l].W * gauss_points[l].eta[j];
+                scalar d = gauss_points[k].W * gauss_points[l].W * gauss_points[k].eta[j];
+                force1[j][0] += c * force_pair_matrix[k][l][0];
+                force1[j][1] += c * force_pair_matrix[k][l][1];
+                force1[j][2] += c * force_pair_matrix[k][l][2];
+
+                force2[j][0] -= d * force_pair_matrix[l][k][0];
+                force2[j][1] -= d * force_pair_matrix[l][k][1];
+                force2[j][2] -= d * force_pair_matrix[l][k][2];
             }
-            force1[0] *= ApAq;
-            force1[1] *= ApAq;
-            force1[2] *= ApAq;
-            f1->add_force_to_node(j, force1);
-
-            force2[0] *= ApAq;
-            force2[1] *= ApAq;
-            force2[2] *= ApAq;
-            f2->add_force_to_node(j, force2);
-        } // end updating face nodes.
-    } // end of critical
+        }
+        force1[j][0] *= ApAq;
+        force1[j][1] *= ApAq;
+        force1[j][2] *= ApAq;
+
+        force2[j][0] *= ApAq;
+        force2[j][1] *= ApAq;
+        force2[j][2] *= ApAq;
+    }
+}
+
+void VdW_solver::calc_farfield_nodal_forces(int type, arr3 &pc, arr3 &qc,
+        const SSINT_table &ssint, int ip, scalar ApAq, arr3 (&force1)[3], arr3 (&force2)[3], scalar &energy) {
+
+    // One point per face, unit weight: the Gauss weights of each face add up to 1
+    scalar dx = pc[0] - qc[0], dy = pc[1] - qc[1], dz = pc[2] - qc[2];
+    scalar w = 1;
+    scalar fx, fy, fz, e = 0.0;
+    calc_ssint_point_pairs(type, 1, &dx, &dy, &dz, &w, ssint, ip, &fx, &fy, &fz, e);
+    energy += e * ApAq;
+
+    // The centroid force is shared equally between the three nodes of each face
+    scalar node_share = ApAq * ffea_const::oneOverThree;
+    for (int j = 0; j < 3; j++) {
+        force1[j] = {node_share * fx, node_share * fy, node_share * fz};
+        force2[j] = {-node_share * fx, -node_share * fy, -node_share * fz};
+    }
 }
 
 /**Alters interaction calculations to apply periodic boundary conditions*/
@@ -331,9 +405,10 @@ void VdW_solver::do_sticky_xz_interaction(Face *f, bool bottom_wall, scalar dim_
     }
 
     // Get the interaction LJ parameters for these two face types
-    map<string, scalar> pmap;
-    pmap = ssint_matrix->get_SSINT_params(f->ssint_interaction_type, f->ssint_interaction_type);
-
+    const SSINT_table &ssint = ssint_matrix->get_SSINT_table();
+    const int ip = ssint_matrix->get_SSINT_index(f->ssint_interaction_type, f->ssint_interaction_type);
+    const scalar Emin = ssint.Emin[ip];
+    const scalar Rmin_6 = ssint.Rmin_6[ip];
 
     arr3 p[num_tri_gauss_quad_points];
     scalar force_pair_matrix[num_tri_gauss_quad_points][num_tri_gauss_quad_points];
@@ -350,8 +425,8 @@ void VdW_solver::do_sticky_xz_interaction(Face *f, bool bottom_wall, scalar dim_
         for (int l = k; l < num_tri_gauss_quad_points; l++) {
             scalar mag_r = p[k][1] - y_wall;
 
-            scalar force_mag = 12 * pow(pmap["Rmin"], 6) * pmap["Emin"] * (pow(mag_r, -7) - pow(pmap["Rmin"], 6) * pow(mag_r, -13));
-            energy += pow(pmap["Rmin"], 6) * pmap["Emin"] * (pow(pmap["Rmin"], 6) * pow(mag_r, -12) - 2 * pow(mag_r, -6));
+            scalar force_mag = 12 * Rmin_6 * Emin * (pow(mag_r, -7) - Rmin_6 * pow(mag_r, -13));
+            energy += Rmin_6 * Emin * (Rmin_6 * pow(mag_r, -12) - 2 * pow(mag_r, -6));
             force_mag *= -1;
 
             force_pair_matrix[k][l] = force_mag;
@@ -379,6 +454,42 @@ void VdW_solver::do_sticky_xz_interaction(Face *f, bool bottom_wall, scalar dim_
     }
 }
 
+VdW_solver::steric_filter_counts &VdW_solver::get_thread_steric_counts() {
+#ifdef USE_OPENMP
+    return thread_steric_counts[omp_get_thread_num()].counts;
+#else
+    return thread_steric_counts[0].counts;
+#endif
+}
+
+bool VdW_solver::steric_overlap(Face *f1, Face *f2, std::vector<scalar> &blob_corr) {
+    steric_filter_counts &counts = get_thread_steric_counts();
+    counts.tested++;
+
+    bool bounds, sat;
+    if (blob_corr.empty()) {
+        bounds = f1->checkTetraBoundsOverlap(f2);
+        sat = bounds && f1->checkTetraIntersection(f2);
+    } else {
+        int f1_daddy_blob_index = f1->daddy_blob->blob_index;
+        int f2_daddy_blob_index = f2->daddy_blob->blob_index;
+        bounds = f1->checkTetraBoundsOverlap(f2, blob_corr, f1_daddy_blob_index, f2_daddy_blob_index);
+        sat = bounds && f1->checkTetraIntersection(f2, blob_corr, f1_daddy_blob_index, f2_daddy_blob_index);
+    }
+
+    if (!bounds) {
+        counts.rejected_bounds++;
+    } else if (!sat) {
+        counts.rejected_sat++;
+    }
+    return sat;
+}
+
+void VdW_solver::print_steric_filter_counts() const {
+    printf("Steric overlap tests: %lld pairs, %lld rejected by bounding box, %lld by tet_a_tetII, %lld with zero intersection volume\n",
+           steric_counts.tested, steric_counts.rejected_bounds, steric_counts.rejected_sat, steric_counts.rejected_volume);
+}
+
 bool VdW_solver::do_steric_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr) {
     int f1_daddy_blob_index = f1->daddy_blob->blob_index;
     int f2_daddy_blob_index = f2->daddy_blob->blob_index;
@@ -389,11 +500,15 @@ bool VdW_solver::do_steric_interaction(Face *f1, Face *f2, std::vector<scalar> &
     grr4 phi1, phi2;
 
     if (blob_corr.empty()) {
-      if (!f1->getTetraIntersectionVolumeTotalGradientAndShapeFunctions(f2, steric_dr, dVdr, vol, phi1, phi2))
+      if (!f1->getTetraIntersectionVolumeTotalGradientAndShapeFunctions(f2, dVdr, vol, phi1, phi2)) {
+          get_thread_steric_counts().rejected_volume++;
           return false;
+      }
     } else {
-      if (!f1->getTetraIntersectionVolumeTotalGradientAndShapeFunctions(f2, steric_dr, dVdr, vol, phi1, phi2, blob_corr, f1_daddy_blob_index, f2_daddy_blob_index))
+      if (!f1->getTetraIntersectionVolumeTotalGradientAndShapeFunctions(f2, dVdr, vol, phi1, phi2, blob_corr, f1_daddy_blob_index, f2_daddy_blob_index)) {
+          get_thread_steric_counts().rejected_volume++;
           return false;
+      }
     }
 
     vol *= steric_factor;
@@ -464,82 +579,7 @@ bool VdW_solver::do_steric_interaction(Face *f1, Face *f2, std::vector<scalar> &
 }
 
 void VdW_solver::do_gensoft_interaction(Face *f1, Face *f2, std::vector<scalar> &blob_corr) {
-    int f1_daddy_blob_index = f1->daddy_blob->blob_index;
-    int f2_daddy_blob_index = f2->daddy_blob->blob_index;
-
-    // Get the interaction LJ parameters for these two face types
-    map<string, scalar> pmap;
-    pmap = ssint_matrix->get_SSINT_params(f1->ssint_interaction_type, f2->ssint_interaction_type);
-    //printf("VdW Params: %f nm %e \n", pmap["Rmin"] * (mesoDimensions::length / 1e-9), Emin * (mesoDimensions::Energy / mesoDimensions::area) * (1.0/ mesoDimensions::area));
-    arr3 p[num_tri_gauss_quad_points], q[num_tri_gauss_quad_points];
-    arr3 force_pair_matrix[num_tri_gauss_quad_points][num_tri_gauss_quad_points];
-
-    // Convert all area coordinate gauss points to cartesian
-    if (blob_corr.empty()) {
-        for (int i = 0; i < num_tri_gauss_quad_points; i++) {
-            f1->barycentric_calc_point(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], p[i]);
-            f2->barycentric_calc_point(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], q[i]);
-        }
-    } else {
-        for (int i = 0; i < num_tri_gauss_quad_points; i++) {
-            f1->barycentric_calc_point_f2(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], p[i],blob_corr, f1_daddy_blob_index, f2_daddy_blob_index);
-            f2->barycentric_calc_point(gauss_points[i].eta[0], gauss_points[i].eta[1], gauss_points[i].eta[2], q[i]);
-        }
-    }
-
-    // Construct the force pair matrix: f(p, q) where p and q are all the gauss points in each face
-    // Also calculate energy whilst looping through face points
-    scalar energy = 0.0;
-
-    calc_gensoft_force_pair_matrix(force_pair_matrix, p, q, pmap["Rmin"], pmap["Emin"], pmap["k0"], energy);
-
-    scalar ApAq = f1->area * f2->area;
-    energy *= ApAq;
-
-    // Store the measurement
-	/*for (int k = 0; k < num_tri_gauss_quad_points; k++) {
-		for (int l = 0; l < num_tri_gauss_quad_points; l++) {
-			printf("%e  ", force_pair_matrix[k][l].z);
-		}
-		printf("\n");
-	}
-	exit(0);*/
-    #pragma omp critical
-    {
-        fieldenergy[f1_daddy_blob_index][f2_daddy_blob_index] += energy;
-        for (int j = 0; j < 3; j++) {
-            arr3 force1, force2;
-            memset(&force1, 0, sizeof(arr3));
-            memset(&force2, 0, sizeof(arr3));
-            for (int k = 0; k < num_tri_gauss_quad_points; k++) {
-                for (int l = 0; l < num_tri_gauss_quad_points; l++) {
-                    scalar c = gauss_points[k].W * gauss_points[l].W * gauss_points[l].eta[j];
-                    scalar d = gauss_points[k].W * gauss_points[l].W * gauss_points[k].eta[j];
-                    //printf("c = %e, %e, %e, %e\n", c, gauss_points[k].W, gauss_points[l].W, gauss_points[l].eta[j]);
-                    force1[0] += c * force_pair_matrix[k][l][0];
-                    force1[1] += c * force_pair_matrix[k][l][1];
-                    force1[2] += c * force_pair_matrix[k][l][2];
-
-                    force2[0] -= d * force_pair_matrix[l][k][0];
-                    force2[1] -= d * force_pair_matrix[l][k][1];
-                    force2[2] -= d * force_pair_matrix[l][k][2];
-                }
-            }
-            force1[0] *= ApAq;
-            force1[1] *= ApAq;
-            force1[2] *= ApAq;
-            f1->add_force_to_node(j, force1);
-            // f1->add_bb_vdw_force_to_record(&force1, f2->daddy_blob->blob_index); // DEPRECATED
-            			//	printf("1:: %d %e %e %e\n", f1->index, force1[0], force1[1], force1[2]);
-					//printf("2:: %d %e %e %e\n", f2->index, force2[0], force2[1], force2[2]);
-
-            force2[0] *= ApAq;
-            force2[1] *= ApAq;
-            force2[2] *= ApAq;
-            f2->add_force_to_node(j, force2);
-            // f2->add_bb_vdw_force_to_record(&force2, f1->daddy_blob->blob_index); // DEPRECATED
-        } // end updating face nodes.
-    } // end of critical
+    do_ssint_interaction(SSINT_TYPE_GENSOFT, f1, f2, blob_corr);
 }
 
 scalar VdW_solver::minimum_image(scalar delta, scalar size) {
@@ -570,16 +610,70 @@ scalar VdW_solver::get_field_energy(int index0, int index1) {
     }
 }
 
+void VdW_solver::calc_ssint_point_pairs(int type, int n, const scalar *dx, const scalar *dy, const scalar *dz, const scalar *w,
+        const SSINT_table &ssint, int ip, scalar *fx, scalar *fy, scalar *fz, scalar &energy) {
+
+    switch (type) {
+        case SSINT_TYPE_LJ:
+            ssint_lj_kernel(n, dx, dy, dz, w,
+                    ssint.Emin[ip], ssint.Rmin_6[ip], fx, fy, fz, energy);
+            break;
+        case SSINT_TYPE_LJSTERIC:
+            ssint_ljinterpolated_kernel(n, dx, dy, dz, w,
+                    ssint.Emin[ip], ssint.Rmin[ip], ssint.Rmini[ip], ssint.Rmin_6[ip], fx, fy, fz, energy);
+            break;
+        case SSINT_TYPE_GENSOFT:
+            ssint_gensoft_kernel(n, dx, dy, dz, w,
+                    ssint.Emin[ip], ssint.Rmin[ip], ssint.Rmin_3[ip], ssint.k0[ip], fx, fy, fz, energy);
+            break;
+        default:
+            for (int i = 0; i < n; i++)
+                fx[i] = fy[i] = fz[i] = 0;
+    }
+}
+
+void VdW_solver::calc_ssint_force_pair_matrix(int type,
+        arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
+        arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
+        const SSINT_table &ssint, int ip, scalar &energy) {
+
+    scalar dx[num_tri_gauss_quad_pairs], dy[num_tri_gauss_quad_pairs], dz[num_tri_gauss_quad_pairs];
+    scalar w[num_tri_gauss_quad_pairs];
+    scalar fx[num_tri_gauss_quad_pairs], fy[num_tri_gauss_quad_pairs], fz[num_tri_gauss_quad_pairs];
+
+    // Pack the (k, l >= k) pairs; off-diagonal ones count twice in the energy
+    int i = 0;
+    for (int k = 0; k < num_tri_gauss_quad_points; k++) {
+        for (int l = k; l < num_tri_gauss_quad_points; l++) {
+            dx[i] = p[k][0] - q[l][0];
+            dy[i] = p[k][1] - q[l][1];
+            dz[i] = p[k][2] - q[l][2];
+            w[i] = gauss_points[k].W * gauss_points[l].W * ((k == l) ? 1 : 2);
+            i++;
+        }
+    }
+
+    calc_ssint_point_pairs(type, num_tri_gauss_quad_pairs, dx, dy, dz, w, ssint, ip, fx, fy, fz, energy);
+
+    // Unpack, the matrix is symmetric
+    i = 0;
+    for (int k = 0; k < num_tri_gauss_quad_points; k++) {
+        for (int l = k; l < num_tri_gauss_quad_points; l++) {
+            force_pair_matrix[k][l][0] = fx[i];
+            force_pair_matrix[k][l][1] = fy[i];
+            force_pair_matrix[k][l][2] = fz[i];
+            force_pair_matrix[l][k] = force_pair_matrix[k][l];
+            i++;
+        }
+    }
+}
+
 void VdW_solver::calc_lj_force_pair_matrix(arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
         arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
-        scalar &Rmin, scalar &Emin, scalar &energy) {
+        const scalar &Rmin_6, const scalar &Emin, scalar &energy) {
 
     scalar mag_r, force_mag, e;
 
-    scalar Rmin_2 = Rmin * Rmin;
-    scalar Rmin_4 = Rmin_2 * Rmin_2;
-    scalar Rmin_6 = Rmin_4 * Rmin_2;
-
     for(int k = 0; k < num_tri_gauss_quad_points; k++) {
         mag_r = sqrt(distance2(p[k], q[k]));
         calc_lj_factors(mag_r, k, k, Emin, Rmin_6, force_mag, e);
@@ -609,12 +703,10 @@ void VdW_solver::calc_lj_force_pair_matrix(arr3 (&force_pair_matrix)[num_tri_gau
 
 void VdW_solver::calc_gensoft_force_pair_matrix(arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
         arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
-        scalar &Rmin, scalar &Emin, scalar &k0, scalar &energy) {
+        const scalar &Rmin, const scalar &Rmin_3, const scalar &Emin, const scalar &k0, scalar &energy) {
 
     scalar mag_r, force_mag, e;
 
-    scalar Rmin_2 = Rmin * Rmin;
-    scalar Rmin_3 = Rmin_2 * Rmin;
     for(int k = 0; k < num_tri_gauss_quad_points; k++) {
         mag_r = sqrt(distance2(p[k], q[k]));
         calc_gensoft_factors(mag_r, k, k, Emin, Rmin, Rmin_3, k0, force_mag, e);
@@ -642,7 +734,7 @@ void VdW_solver::calc_gensoft_force_pair_matrix(arr3 (&force_pair_matrix)[num_tr
 }
 
 /** Given (mag_r), get LJ force magnitude (force_mag) and energy (e) */
-void VdW_solver::calc_lj_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmin_6,
+void VdW_solver::calc_lj_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmin_6,
                                  scalar &force_mag, scalar &e) {
 
     scalar mag_ri,  mag_ri_2, mag_ri_4, mag_ri_6, mag_ri_7;
@@ -660,7 +752,7 @@ void VdW_solver::calc_lj_factors(scalar &mag_r, int index_k, int index_l, scalar
 
 }
 
-void VdW_solver::calc_gensoft_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmin, scalar &Rmin_3, scalar &k0,
+void VdW_solver::calc_gensoft_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmin, const scalar &Rmin_3, const scalar &k0,
                                  scalar &force_mag, scalar &e) {
 
       scalar k0rm, k0rm2, epsonrm, Rmin_2, mag_r_2, mag_r_3, gensoftfac_2, gensoftfac_3, emag, korm2;
@@ -680,7 +772,7 @@ void VdW_solver::calc_gensoft_factors(scalar &mag_r, int index_k, int index_l, s
 }
 
 /** Given (mag_r), get LJ_interpolated force magnitude (force_mag) and energy (e) */
-void VdW_solver::calc_ljinterpolated_factors(scalar &mag_r, int index_k, int index_l, scalar &Emin, scalar &Rmini,
+void VdW_solver::calc_ljinterpolated_factors(scalar &mag_r, int index_k, int index_l, const scalar &Emin, const scalar &Rmini,
                                  scalar &force_mag, scalar &e) {
 
     scalar vdw_fac = mag_r * Rmini;
@@ -694,16 +786,10 @@ void VdW_solver::calc_ljinterpolated_factors(scalar &mag_r, int index_k, int ind
 
 void VdW_solver::calc_ljinterpolated_force_pair_matrix(arr3 (&force_pair_matrix)[num_tri_gauss_quad_points][num_tri_gauss_quad_points],
         arr3 (&p)[num_tri_gauss_quad_points], arr3 (&q)[num_tri_gauss_quad_points],
-        scalar &Rmin, scalar &Emin, scalar &energy) {
+        const scalar &Rmin, const scalar &Rmini, const scalar &Rmin_6, const scalar &Emin, scalar &energy) {
 
     scalar mag_r, e, force_mag;
 
-    scalar Rmin_2 = Rmin * Rmin;
-    scalar Rmin_4 = Rmin_2 * Rmin_2;
-    scalar Rmin_6 = Rmin_4 * Rmin_2;
-
-    scalar Rmini = 1.0 / Rmin;
-
     for(int k = 0; k < num_tri_gauss_quad_points; k++) {
         mag_r = sqrt(distance2(p[k], q[k]));
         if(mag_r < Rmin)
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
 #include "VolumeIntersection.h"
 
 using std::cout;
@@ -947,15 +948,15 @@ void contribVolForIntersections(T &vol, const std::array<T,3> &tetAi, const std:
                                    tetB3, tetB0, tetB1, tetB2, W, ips);
 }
 
-/** Return the volume intersection between two tetrahedra */ 
+/** Find the vertices W[0:ips] of the intersection between two tetrahedra,
+ *    and return its volume before any sanity checks */
 template <typename T>
-T volumeIntersectionII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3,
-    const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3, bool calcCM, std::array<T,3> &cm){
+T intersectionVerticesII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3,
+    const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3,
+    std::array<std::array<T,3>,56> &W, int &ips){
 
   T vol = 0.0; 
-  std::array<std::array<T,3>,56> W; 
-
-  int ips = 0;
+  ips = 0;
   int an0, an1, an2; 
   // Check for interior points. 
   //   Unfold the loop: 
@@ -1006,6 +1007,18 @@ T volumeIntersectionII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA
 
   // Done! Now multiply the current value by the magic factor:
   vol *= - ffea_const::oneOverSix;
+  return vol;
+}
+
+/** Return the volume intersection between two tetrahedra */ 
+template <typename T>
+T volumeIntersectionII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3,
+    const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3, bool calcCM, std::array<T,3> &cm){
+
+  std::array<std::array<T,3>,56> W; 
+  int ips;
+  T vol = intersectionVerticesII(tetA0, tetA1, tetA2, tetA3, tetB0, tetB1, tetB2, tetB3, W, ips);
+
   // CHECKing /// 
   // three points cannot have a volume.
   if (ips <= 3) 
@@ -1023,6 +1036,103 @@ T volumeIntersectionII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA
 
 } 
 
+/** Add to varea the area of the face of the intersection polyhedron W[0:ips]
+ *    that lies on the plane f0:f1:f2, times the unit normal of that plane
+ *    pointing away from p3.
+ */
+template <typename T>
+void addFaceVectorArea(const std::array<T,3> &f0, const std::array<T,3> &f1, const std::array<T,3> &f2, const std::array<T,3> &p3,
+    int ips, const std::array<std::array<T,3>,56> &W, std::array<T,3> &varea){
+
+  std::array<T,3> e1, e2, n;
+  sub(f1, f0, e1);
+  sub(f2, f0, e2);
+  n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+  n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+  n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+  T nn = magnitude(n);
+  if (nn == 0) return;
+  resize(1/nn, n);
+  T d = dot(n, f0);
+  if (dot(n, p3) - d > 0) {
+    resize(T(-1), n);
+    d = -d;
+  }
+
+  // the vertices lying on this plane, allowing for the round off
+  //   of the edge-face intersection points:
+  T tol = 1e-9 * std::max(magnitude(e1), magnitude(e2));
+  std::array<int,56> on;
+  int non = 0;
+  std::array<T,3> c = {0, 0, 0};
+  for (int i=0; i<ips; i++) {
+    if (fabs(dot(n, W[i]) - d) < tol) {
+      on[non++] = i;
+      add(c, W[i], c);
+    }
+  }
+  if (non < 3) return;
+  resize(T(1)/non, c);
+
+  // sort them by angle around their centre, and add up the triangle fan:
+  std::array<T,3> u, v, r;
+  sub(W[on[0]], c, u);
+  v[0] = n[1]*u[2] - n[2]*u[1];
+  v[1] = n[2]*u[0] - n[0]*u[2];
+  v[2] = n[0]*u[1] - n[1]*u[0];
+  std::array<T,56> ang;
+  for (int i=0; i<non; i++) {
+    sub(W[on[i]], c, r);
+    ang[i] = atan2(dot(r, v), dot(r, u));
+  }
+  for (int i=1; i<non; i++) {
+    for (int j=i; j>0 && ang[j] < ang[j-1]; j--) {
+      std::swap(ang[j], ang[j-1]);
+      std::swap(on[j], on[j-1]);
+    }
+  }
+  T area = 0;
+  std::array<T,3> r1;
+  for (int i=0; i<non; i++) {
+    sub(W[on[i]], c, r);
+    sub(W[on[(i+1)%non]], c, r1);
+    area += n[0]*(r[1]*r1[2] - r[2]*r1[1]) + n[1]*(r[2]*r1[0] - r[0]*r1[2]) + n[2]*(r[0]*r1[1] - r[1]*r1[0]);
+  }
+  area *= T(0.5);
+
+  for (int j=0; j<3; j++) varea[j] += area * n[j];
+}
+
+/** Return the volume intersection between two tetrahedra, its CM,
+ *    and the gradient of the volume with respect to a rigid translation of tetB.
+ *  The gradient is the vector area of the faces of the intersection
+ *    lying on the faces of tetB, so it comes out of the same clipping pass.
+ */
+template <typename T>
+T volumeIntersectionAndGradientII(const std::array<T,3> &tetA0, const std::array<T,3> &tetA1, const std::array<T,3> &tetA2, const std::array<T,3> &tetA3,
+    const std::array<T,3> &tetB0, const std::array<T,3> &tetB1, const std::array<T,3> &tetB2, const std::array<T,3> &tetB3, std::array<T,3> &dVdB, std::array<T,3> &cm){
+
+  std::array<std::array<T,3>,56> W; 
+  int ips;
+  initialise(dVdB);
+  T vol = intersectionVerticesII(tetA0, tetA1, tetA2, tetA3, tetB0, tetB1, tetB2, tetB3, W, ips);
+
+  if (ips <= 3) 
+    return 0.; 
+  T w = maxVolume(ips, W); 
+  if ((fabs(vol) > w) || (vol < 0)) { 
+    vol = w;
+  }
+  findCM(ips, W, cm);
+
+  addFaceVectorArea(tetB0, tetB1, tetB2, tetB3, ips, W, dVdB);
+  addFaceVectorArea(tetB1, tetB2, tetB3, tetB0, ips, W, dVdB);
+  addFaceVectorArea(tetB2, tetB3, tetB0, tetB1, ips, W, dVdB);
+  addFaceVectorArea(tetB3, tetB0, tetB1, tetB2, ips, W, dVdB);
+
+  return vol; 
+}
+
 
 /** Return the volume and area of intersection between two tetrahedra */ 
 //  input: std::array<T,3> (&tetA)[4], std::array<T,3> (&tetB)[4])
@@ -1207,6 +1317,7 @@ template scalar volumeForIntPoint<scalar>(const std::array<scalar, 3>& ip, const
 template scalar volumeForIntPointII<scalar>(const std::array<scalar, 3>& ip, const std::array<scalar, 3>& tetAe1, const std::array<scalar, 3>& tetAe2, const std::array<scalar, 3>& tetAe3, const std::array<scalar, 3>& tetAe4, const std::array<scalar, 3>& tetBf1, const std::array<scalar, 3>& tetBf2, const std::array<scalar, 3>& tetBf3, const std::array<scalar, 3>& tetBf4);
 template void volumeAndAreaForIntPoint<scalar>(const std::array<scalar, 3>& ip, const std::array<std::array<scalar, 3>, 4>& tetA, int e1, int e2, const std::array<std::array<scalar, 3>, 4>& tetB, int f1, int f2, int f3, scalar& volume, scalar& area);
 template scalar volumeIntersection<scalar>(const std::array<std::array<scalar, 3>, 4>& tetA, const std::array<std::array<scalar, 3>, 4>& tetB, bool calcCM, std::array<scalar, 3>& cm);
+template scalar volumeIntersectionAndGradientII<scalar>(const std::array<scalar, 3>& tetA0, const std::array<scalar, 3>& tetA1, const std::array<scalar, 3>& tetA2, const std::array<scalar, 3>& tetA3, const std::array<scalar, 3>& tetB0, const std::array<scalar, 3>& tetB1, const std::array<scalar, 3>& tetB2, const std::array<scalar, 3>& tetB3, std::array<scalar, 3>& dVdB, std::array<scalar, 3>& cm);
 template scalar volumeIntersectionII<scalar>(const std::array<scalar, 3>& tetA0, const std::array<scalar, 3>& tetA1, const std::array<scalar, 3>& tetA2, const std::array<scalar, 3>& tetA3, const std::array<scalar, 3>& tetB0, const std::array<scalar, 3>& tetB1, const std::array<scalar, 3>& tetB2, const std::array<scalar, 3>& tetB3, bool calcCM, std::array<scalar, 3>& cm);
 
 template void volumeAndAreaIntersection<scalar>(const std::array<std::array<scalar, 3>, 4>& tetA, const std::array<std::array<scalar, 3>, 4>& tetB, scalar& vol, scalar& area);
@@ -1229,6 +1340,7 @@ template geoscalar volumeForIntPoint<geoscalar>(const std::array<geoscalar,3> &i
 template geoscalar volumeForIntPointII<geoscalar>(const std::array<geoscalar,3> &ip, const std::array<geoscalar,3> &tetAe1, const std::array<geoscalar,3> &tetAe2, const std::array<geoscalar,3> &tetAe3, const std::array<geoscalar,3> &tetAe4, const std::array<geoscalar,3> &tetBf1, const std::array<geoscalar,3> &tetBf2, const std::array<geoscalar,3> &tetBf3, const std::array<geoscalar,3> &tetBf4);
 template void volumeAndAreaForIntPoint<geoscalar>(const std::array<geoscalar,3> &ip, const std::array<std::array<geoscalar,3>,4> &tetA, int e1, int e2, const std::array<std::array<geoscalar,3>,4> &tetB, int f1, int f2, int f3, geoscalar &volume, geoscalar &area);
 template geoscalar volumeIntersection<geoscalar>(const std::array<std::array<geoscalar,3>,4> &tetA, const std::array<std::array<geoscalar,3>,4> &tetB, bool calcCM, std::array<geoscalar,3> &cm);
+template geoscalar volumeIntersectionAndGradientII<geoscalar>(const std::array<geoscalar,3> &tetA0, const std::array<geoscalar,3> &tetA1, const std::array<geoscalar,3> &tetA2, const std::array<geoscalar,3> &tetA3, const std::array<geoscalar,3> &tetB0, const std::array<geoscalar,3> &tetB1, const std::array<geoscalar,3> &tetB2, const std::array<geoscalar,3> &tetB3, std::array<geoscalar,3> &dVdB, std::array<geoscalar,3> &cm);
 template geoscalar volumeIntersectionII<geoscalar>(const std::array<geoscalar,3> &tetA0, const std::array<geoscalar,3> &tetA1, const std::array<geoscalar,3> &tetA2, const std::array<geoscalar,3> &tetA3, const std::array<geoscalar,3> &tetB0, const std::array<geoscalar,3> &tetB1, const std::array<geoscalar,3> &tetB2, const std::array<geoscalar,3> &tetB3, bool calcCM, std::array<geoscalar,3> &cm);
 
 template void volumeAndAreaIntersection<geoscalar>(const std::array<std::array<geoscalar,3>,4> &tetA, const std::array<std::array<geoscalar,3>,4> &tetB, geoscalar &vol, geoscalar &area);
@@ -25,6 +25,8 @@
 #ifdef USE_MPI
 #include "mpi.h"
 #endif
+#include <algorithm>
+#include <exception>
 #include <filesystem>
 
 
@@ -50,6 +52,8 @@ World::World()
     box_dim[2] = 0;
     step_initial = 0;
     trajectory_out = nullptr;
+    rod_traj_out = nullptr;
+    rod_traj_restart_size = 0;
     measurement_out = nullptr;
     detailed_meas_out = nullptr;
     writeDetailed = true;
@@ -128,6 +132,11 @@ World::~World()
     {
         fclose(detailed_meas_out);
     }
+    if (rod_traj_out)
+    {
+        fclose(rod_traj_out);
+    }
+    rod_traj_out = nullptr;
     writeDetailed = false;
     if (params.calc_kinetics == 1)
     {
@@ -393,6 +402,40 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
                     throw FFEAException("Error reading seeds as integers: %s", ia.what());
                 }
             }
+
+            // RNG.1.5 - and the kinetic events that were waiting, so that they are not drawn again.
+            //   Older checkpoints do not have them, and the events are then drawn afresh.
+            for (size_t i = 0; i < checkpoint_v.size(); ++i)
+            {
+                if (checkpoint_v[i].rfind("Pending kinetic events:", 0) != 0)
+                    continue;
+                vector<string> vline;
+                boost::split(vline, checkpoint_v[i], boost::is_any_of(" "));
+                if (stoi(vline.back()) != params.num_blobs || i + params.num_blobs >= checkpoint_v.size())
+                {
+                    throw FFEAException("The pending kinetic events in %s do not match the %d blobs", params.icheckpoint_fname.c_str(), params.num_blobs);
+                }
+                kinetic_event_time.assign(params.num_blobs, 0);
+                kinetic_event_total_rate.assign(params.num_blobs, 0);
+                for (int j = 0; j < params.num_blobs; ++j)
+                {
+                    boost::split(vline, checkpoint_v[i + 1 + j], boost::is_any_of(" "));
+                    if (vline.size() != 2)
+                    {
+                        throw FFEAException("ERROR reading pending kinetic events");
+                    }
+                    try
+                    {
+                        kinetic_event_time[j] = static_cast<scalar>(stod(vline[0]));
+                        kinetic_event_total_rate[j] = static_cast<scalar>(stod(vline[1]));
+                    }
+                    catch (invalid_argument &ia)
+                    {
+                        throw FFEAException("Error reading pending kinetic events: %s", ia.what());
+                    }
+                }
+                break;
+            }
         }
 
         // RNG.2 - AND initialise rng:
@@ -426,7 +469,7 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
     }
 
     // Build system of blobs, conformations, kinetics etc
-    read_and_build_system(script_vector);
+    read_and_build_system(script_vector, frames_to_delete);
 
     // If requested, initialise the PreComp_solver.
     //   Because beads need to be related to elements, it is much easier if
@@ -515,6 +558,7 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
     {
         rod_blob_interface_array[i]->update_J_0();
     }
+    group_rod_blob_interfaces();
 
     // If not restarting a previous simulation, create new trajectory and measurement files. But only if full simulation is happening!
     if (mode == 0)
@@ -524,6 +568,9 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
         {
             throw FFEAFileException(params.ocheckpoint_fname);
         }
+
+        if (params.num_rods > 0 && params.rod_traj_format == "binary")
+            open_rod_binary_trajectory();
 #ifdef FFEA_PARALLEL_FUTURE
         // And launch a first trajectory thread, that will be catched up at print_traj time
         thread_writingTraj = std::async(std::launch::async, &World::do_nothing, this);
@@ -950,6 +997,13 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
         }
     }
 
+    // Inactive conformations are built without a solver. Make sure the active ones (which may have
+    // been read back from a restart) have theirs.
+    for (int i = 0; i < params.num_blobs; ++i)
+    {
+        use_conformation_solver(i, active_blob_array[i]->get_conformation_index());
+    }
+
     // Check if there are static blobs:
     bool there_are_static_blobs = false;
     for (int i = 0; i < params.num_blobs; i++)
@@ -981,7 +1035,7 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
         if (!vdw_solver)
             throw FFEAException("World::init failed to initialise the ssint_solver.\n");
 
-        vdw_solver->init(&lookup, box_dim, &ssint_matrix, params.steric_factor, params.num_blobs, params.inc_self_ssint, params.ssint_type, params.steric_dr, params.calc_kinetics, there_are_static_blobs);
+        vdw_solver->init(&lookup, box_dim, &ssint_matrix, params.steric_factor, params.num_blobs, params.inc_self_ssint, params.ssint_type, params.calc_kinetics, there_are_static_blobs, params.ssint_farfield_ratio);
     }
 
     // Calculate the total number of vdw interacting faces in the entire system
@@ -1013,11 +1067,14 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
 
         // Add all the faces from each Blob to the lookup pool
         printf("Adding all faces to nearest neighbour grid lookup pool\n");
+        lookup_face_range.resize(params.num_blobs);
         for (int i = 0; i < params.num_blobs; i++)
         {
+            lookup_face_range[i].resize(params.num_conformations[i]);
             for (int j = 0; j < params.num_conformations[i]; ++j)
             {
                 int num_faces_added = 0;
+                lookup_face_range[i][j][0] = lookup.get_pool_size();
                 for (int k = 0; k < blob_array[i][j].get_num_faces(); k++)
                 {
                     Face *b_face = blob_array[i][j].get_face(k);
@@ -1031,6 +1088,10 @@ void World::init(string FFEA_script_filename, int frames_to_delete, int mode, bo
                         num_faces_added++;
                     }
                 }
+                lookup_face_range[i][j][1] = num_faces_added;
+
+                // Only the active conformation takes part in neighbour searches
+                set_conformation_faces_active(i, j, &blob_array[i][j] == active_blob_array[i]);
                 if (userInfo::verblevel > 1)
                     printf("%d 'ssint active' faces, from blob %d, conformation %d, added to lookup grid.\n", num_faces_added, i, j);
             }
@@ -1744,6 +1805,11 @@ void World::run()
     scalar wtime0, wtime1, wtime2, wtime3, wtime4, time0 = 0, time1 = 0, time2 = 0, time3 = 0, time4 = 0;
 #endif
 
+    if (params.calc_kinetics == 1)
+    {
+        start_kinetic_events(step_initial);
+    }
+
     for (long long step = step_initial; step < params.num_steps + 1; step++)
     {
 #ifdef BENCHMARK
@@ -1779,14 +1845,13 @@ void World::run()
                 es_count++;
         } // es_update will turn to false at the begining of next timestep
 
-        // Zero the force across all blobs
+        // Prepare all blobs for the step. The forces were zeroed as they were used up in the last step, and
+        // the centroid and bounds were found when the nodes were last moved, so this rarely needs to touch the nodes
 #ifdef USE_OPENMP
 #pragma omp parallel for default(none) shared(es_update, step) schedule(static)
 #endif
         for (int i = 0; i < params.num_blobs; i++)
         {
-            active_blob_array[i]->zero_force();
-
             // If blob centre of mass moves outside simulation box, apply PBC to it
             arr3 com;
             active_blob_array[i]->calc_and_store_centroid(com);
@@ -1858,9 +1923,6 @@ void World::run()
             // If Blob is near a hard wall, prevent it from moving further into it
             active_blob_array[i]->enforce_box_boundaries(box_dim);
 
-            // Set node forces to zero
-            active_blob_array[i]->set_forces_to_zero();
-
             if (es_update)
                 active_blob_array[i]->calc_centroids_and_normals_of_all_faces();
         }
@@ -1912,13 +1974,7 @@ void World::run()
         // Rod steric neighbours
         if (params.calc_steric_rod == 1)
         {
-            for (int i = 0; i < params.num_rods; i++)
-            {
-                for (int j = i + 1; j < params.num_rods; j++)
-                {
-                    update_rod_steric_nbr_lists(rod_array[i], rod_array[j]);
-                }
-            }
+            update_rod_steric_nbr_lists();
             if (rod::dbg_print)
             {
                 std::cout << "Generated rod steric neighbour lists" << std::endl;
@@ -1932,13 +1988,7 @@ void World::run()
         // Rod VDW neighbours
         if (params.calc_vdw_rod == 1)
         {
-            for (int i = 0; i < params.num_rods; i++)
-            {
-                for (int j = i + 1; j < params.num_rods; j++)
-                {
-                    update_rod_vdw_nbr_lists(rod_array[i], rod_array[j], &rod_lj_matrix);
-                }
-            }
+            update_rod_vdw_nbr_lists(&rod_lj_matrix);
             if (rod::dbg_print)
             {
                 std::cout << "Generated rod vdw neighbour lists" << std::endl;
@@ -1950,18 +2000,42 @@ void World::run()
         }
 
 
-        // Do rods
+        // Do rods. The noise is drawn serially from the first stream, so each
+        // node gets the same random numbers whatever the number of threads,
+        // then the rods are stepped as concurrent tasks, whose node loops are
+        // taskloops sharing the same threads
+        // The perturbed energies are only needed for the text trajectory frame
+        // written at the end of this step
         for (int i = 0; i < params.num_rods; i++)
         {
-            rod_array[i]->do_timestep(rng);
+            rod_array[i]->draw_noise((*rng)[0]);
+            rod_array[i]->perturbed_energies_due = step % params.check == 0 && params.rod_traj_format == "text";
         }
 
-        // Rod-blob interface
-        for (int i = 0; i < params.num_interfaces; i++)
+        std::vector<std::exception_ptr> rod_errors(params.num_rods);
+#pragma omp parallel default(none) shared(rod_errors) if(params.num_rods > 0)
+#pragma omp single
+        for (int i = 0; i < params.num_rods; i++)
         {
-            rod_blob_interface_array[i]->do_connection_timestep();
+#pragma omp task default(none) firstprivate(i) shared(rod_errors)
+            try
+            {
+                rod_array[i]->do_timestep();
+            }
+            catch (...)
+            {
+                rod_errors[i] = std::current_exception();
+            }
+        }
+        for (const std::exception_ptr &error : rod_errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
         }
 
+        // Rod-blob interface
+        do_rod_blob_interface_timestep();
+
         if (params.pbc_rod == 1)
         {
             for (int i = 0; i < params.num_rods; i++)
@@ -2066,20 +2140,9 @@ void World::run()
         /* Kinetic Part of each step */
         // This part consists of a discrete change, and so must occur before a force calculation cycle to be consistent with measurement data
         // This means is must happen either at the very end of a timstep, or at the very beginning
-        if (params.calc_kinetics == 1 && step % params.kinetics_update == 0)
+        if (params.calc_kinetics == 1)
         {
-            // Calculate the kinetic switching probablilites. These are scaled from the base rates provided
-            calculate_kinetic_rates();
-
-            // Now we can treat each blob separately
-            for (int i = 0; i < params.num_blobs; ++i)
-            {
-
-                // Find out what the state change should be based on the rates
-                int target = active_blob_array[i]->get_state_index();
-                choose_new_kinetic_state(i, &target);
-                change_kinetic_state(i, target);
-            }
+            do_kinetic_events(step);
         }
 
 #ifdef BENCHMARK
@@ -2104,6 +2167,8 @@ void World::run()
 #endif
 
     printf("\n\nTime taken: %2f seconds\n", (omp_get_wtime() - wtime));
+    if (params.calc_steric == 1 && vdw_solver && userInfo::verblevel > 1)
+        vdw_solver->print_steric_filter_counts();
 }
 
 /**
@@ -2154,13 +2219,14 @@ void World::change_kinetic_state(int blob_index, int target_state)
         }
         else
         {
-            // Change active conformation and activate all faces
+            // Change active conformation (building its solver if need be) and activate all faces
+            use_conformation_solver(blob_index, target_conformation);
             active_blob_array[blob_index] = &blob_array[blob_index][target_conformation];
-            active_blob_array[blob_index]->kinetically_set_faces(true);
+            set_conformation_faces_active(blob_index, target_conformation, true);
 
-            // Move the old one to random space so as not to interfere with calculations, and deactivate all faces
+            // Move the old one to random space, and take its faces out of the lookup
             blob_array[blob_index][current_conformation].position(blob_array[blob_index][current_conformation].get_RandU01() * 1e10, blob_array[blob_index][current_conformation].get_RandU01() * 1e10, blob_array[blob_index][current_conformation].get_RandU01() * 1e10);
-            blob_array[blob_index][current_conformation].kinetically_set_faces(false);
+            set_conformation_faces_active(blob_index, current_conformation, false);
 
             // Reactivate springs
             activate_springs();
@@ -2169,16 +2235,14 @@ void World::change_kinetic_state(int blob_index, int target_state)
     else if (!kinetic_state[blob_index][current_state].is_bound() && kinetic_state[blob_index][target_state].is_bound())
     {
 
-        // Binding event! Add nodes to pinned node list, or add springs, and reset the solver
+        // Binding event! Add nodes to pinned node list (and to the solver's pin mask), or add springs
         active_blob_array[blob_index]->pin_binding_site(kinetic_state[blob_index][target_state].get_base_site()->get_nodes());
-        active_blob_array[blob_index]->reset_solver();
     }
     else if (kinetic_state[blob_index][current_state].is_bound() && !kinetic_state[blob_index][target_state].is_bound())
     {
 
-        // Unbinding event! Remove nodes to pinned node list and reset the solver
+        // Unbinding event! Remove nodes from pinned node list (and from the solver's pin mask)
         active_blob_array[blob_index]->unpin_binding_site(kinetic_state[blob_index][current_state].get_base_site()->get_nodes());
-        active_blob_array[blob_index]->reset_solver();
     }
     else
     {
@@ -2192,12 +2256,49 @@ void World::change_kinetic_state(int blob_index, int target_state)
     active_blob_array[blob_index]->set_previous_conformation_index(current_conformation);
 }
 
+/**
+ * @brief Switches a conformation's faces on or off, both on the blob and in the face lookup,
+ *        so that inactive conformations take no part in the surface interactions.
+ */
+void World::set_conformation_faces_active(int blob_index, int conformation_index, bool state)
+{
+    blob_array[blob_index][conformation_index].kinetically_set_faces(state);
+
+    // The lookup only exists if ssint, steric or es are being calculated
+    if (!lookup_face_range.empty())
+    {
+        const std::array<int, 2> &range = lookup_face_range[blob_index][conformation_index];
+        lookup.set_pool_range_active(range[0], range[1], state);
+    }
+}
+
+/**
+ * @brief Makes sure the given conformation has a built solver and marks it as the most
+ *        recently used for its blob. Once more than kinetics_solver_cache conformations of the
+ *        blob hold a solver, the least recently used ones are released.
+ */
+void World::use_conformation_solver(int blob_index, int conformation_index)
+{
+    std::list<int> &lru = conformation_solver_lru[blob_index];
+    lru.remove(conformation_index);
+    lru.push_front(conformation_index);
+    blob_array[blob_index][conformation_index].build_solver();
+
+    // Free the least recently used solvers. The conformation being used is at the front, so it is never freed
+    while (lru.size() > static_cast<size_t>(params.kinetics_solver_cache))
+    {
+        blob_array[blob_index][lru.back()].release_solver();
+        lru.pop_back();
+    }
+}
+
 /**
  * @brief Parses <blobs>, <springs>, <rods> and <precomp>.
  * @param script_vector which is essentially the FFEA input file,
  *            line by line, as it comes out of FFEA_input_reader::file_to_lines
+ * @param frames_to_delete frames at the end of a binary rod trajectory that a restart drops
  */
-void World::read_and_build_system(const vector<string> &script_vector)
+void World::read_and_build_system(const vector<string> &script_vector, int frames_to_delete)
 {
     // READ and parse more
     // Reading variables
@@ -2225,6 +2326,7 @@ void World::read_and_build_system(const vector<string> &script_vector)
     // Get precomputed data first
     pc_params.dist_to_m = 1;
     pc_params.E_to_J = 1;
+    pc_params.spline_tol = 1e-4;
     if (params.calc_preComp == 1)
     {
         vector<string> precomp_vector;
@@ -2260,6 +2362,14 @@ void World::read_and_build_system(const vector<string> &script_vector)
             {
                 pc_params.E_to_J = stod(lrvalue[1]);
             }
+            else if (lrvalue[0] == "spline_tol")
+            {
+                pc_params.spline_tol = stod(lrvalue[1]);
+                if (pc_params.spline_tol < 0)
+                {
+                    throw FFEAException("Invalid value for 'spline_tol' in <precomp> section: it cannot be negative.");
+                }
+            }
         }
     }
 
@@ -2719,6 +2829,8 @@ void World::read_and_build_system(const vector<string> &script_vector)
         set_states = 0; // aux reader flag
     }
 
+    conformation_solver_lru.assign(params.num_blobs, std::list<int>());
+
     // Blobs are now configured. Initialisation will allocate memory,
     //    and thus it may be performance wise to initialise things in the
     //    thread they will be. Hopefully will work, though that
@@ -2731,9 +2843,12 @@ void World::read_and_build_system(const vector<string> &script_vector)
     {
         for (int j = 0; j < params.num_conformations[i]; ++j)
         {
-            blob_array[i][j].init();
+            // Only the first conformation is active to begin with. The rest get a solver when they are first used
+            blob_array[i][j].init(j == 0);
+            if (j == 0)
+                conformation_solver_lru[i].push_front(j);
 
-            // If not an active conforamtion, move to random area in infinity so ssint and stuff are not active (face linked list is not set up for deleting elements)
+            // If not an active conforamtion, move to random area in infinity. Its faces are kept out of the face lookup until it is activated
             if (j > 0)
             {
                 blob_array[i][j].position(blob_array[i][j].get_RandU01() * 1e10, blob_array[i][j].get_RandU01() * 1e10, blob_array[i][j].get_RandU01() * 1e10);
@@ -2851,6 +2966,10 @@ void World::read_and_build_system(const vector<string> &script_vector)
 
     }
 
+    // Rods restarting from a binary trajectory take their positions from its last frame
+    if (params.num_rods > 0 && params.rod_traj_format == "binary")
+        load_rod_binary_trajectory(frames_to_delete);
+
     // Create rod-blob interfaces
     rod_blob_interface_array = new rod::Rod_blob_interface *[params.num_interfaces];
     for (int i = 0; i < params.num_interfaces; i++)
@@ -2992,6 +3111,7 @@ void World::load_kinetic_maps(const vector<string> &map_fnames, const vector<int
 
         // Create sparse matrix
         // Use of std::move() here moves the local scope entry/key into the method (converts them to rval)
+        kinetic_map[blob_index][map_from[i]][map_to[i]] = std::make_shared<SparseMatrixFixedPattern>();
         kinetic_map[blob_index][map_from[i]][map_to[i]]->init(num_rows, entries, std::move(key), col_index);
     }
 }
@@ -3021,6 +3141,22 @@ void World::build_kinetic_identity_maps() {
     }
 }
 
+/**
+ * @brief Indexes the binding sites of the active blobs, so that only nearby sites are checked for binding
+ */
+void World::build_binding_site_hash()
+{
+    binding_site_hash.clear();
+    for (int i = 0; i < params.num_blobs; ++i)
+    {
+        for (int bsindex = 0; bsindex < active_blob_array[i]->getNumBindingSites(); ++bsindex)
+        {
+            binding_site_hash.add_site(i, active_blob_array[i]->get_binding_site(bsindex));
+        }
+    }
+    binding_site_hash.build(params.num_blobs);
+}
+
 /**
  * @brief Calculates kinetic rates based upon the current state of the blob
  * @details This function alters the given kinetic_rates using the energy of the system.
@@ -3029,6 +3165,9 @@ void World::build_kinetic_identity_maps() {
 
 void World::calculate_kinetic_rates()
 {
+    // The binding sites are only indexed once some blob can bind from its current state
+    bool binding_site_hash_built = false;
+
     // For each blob
     for (int i = 0; i < params.num_blobs; ++i)
     {
@@ -3036,9 +3175,6 @@ void World::calculate_kinetic_rates()
         // Get current state
         int current_state = active_blob_array[i]->get_state_index();
         //cout << "Current State = " << current_state << endl;
-        // Set total probability to 0
-        scalar prob_sum = 0.0;
-
         // And for each state we could switch to
         for (int j = 0; j < params.num_states[i]; ++j)
         {
@@ -3069,6 +3205,11 @@ void World::calculate_kinetic_rates()
                 // Binding event! Kinetic switch is constant but a step function dependent upon distance from the potential binding sites. Entropy taken into account by simulation
                 // Initialise to zero in case of no sites in range
                 kinetic_rate[i][current_state][j] = 0.0;
+                if (!binding_site_hash_built)
+                {
+                    build_binding_site_hash();
+                    binding_site_hash_built = true;
+                }
 
                 // Get the base and target types
                 int base_type = kinetic_state[i][j].get_base_bsite_type();
@@ -3085,42 +3226,15 @@ void World::calculate_kinetic_rates()
                         continue;
                     }
 
-                    // Else, scan all other binding sites in the world
-                    for (int other_blob_index = 0; other_blob_index < params.num_blobs; ++other_blob_index)
+                    // Else, find the first compatible site on another blob that's in range
+                    int target_entry = binding_site_hash.find_first_in_range(i, base_bsindex, target_type);
+                    if (target_entry != -1)
                     {
 
-                        // If same blob, continue (for now)
-                        if (i == other_blob_index)
-                        {
-                            continue;
-                        }
-
-                        // Scan all sites on this blob too
-                        for (int target_bsindex = 0; target_bsindex < active_blob_array[other_blob_index]->getNumBindingSites(); ++target_bsindex)
-                        {
-
-                            BindingSite *target_site = active_blob_array[other_blob_index]->get_binding_site(target_bsindex);
-
-                            // If wrong type, move on
-                            if (target_site->get_type() != target_type)
-                            {
-                                continue;
-                            }
-
-                            // We've got 2 compatible sites! Are they in range?
-                            if (BindingSite::sites_in_range(*base_site, *target_site))
-                            {
-
-                                // Success! Set rates and bsites into the states
-                                kinetic_rate[i][current_state][j] = kinetic_base_rate[i][current_state][j];
-                                kinetic_state[i][j].set_sites(base_site, target_site);
-
-                                // And return from this crazy loop
-                                other_blob_index = params.num_blobs;
-                                base_bsindex = active_blob_array[i]->getNumBindingSites();
-                                break;
-                            }
-                        }
+                        // Success! Set rates and bsites into the states
+                        kinetic_rate[i][current_state][j] = kinetic_base_rate[i][current_state][j];
+                        kinetic_state[i][j].set_sites(base_site, binding_site_hash.get_site(target_entry));
+                        break;
                     }
                 }
             }
@@ -3135,16 +3249,7 @@ void World::calculate_kinetic_rates()
                 kinetic_rate[i][current_state][j] = kinetic_base_rate[i][current_state][j];
             }
 
-            prob_sum += kinetic_rate[i][current_state][j];
         }
-
-        // Finally, the probability of staying put
-        if (prob_sum > 1.0)
-        {
-            throw FFEAException("Although your original switching probabilities for blob %d totalled < 1.0, after rescaling they have gone > 1.0. Lower your 'kinetic_update' parameter!", i);
-        }
-
-        kinetic_rate[i][current_state][current_state] = 1 - prob_sum;
     }
 }
 
@@ -3159,34 +3264,143 @@ void World::calculate_kinetic_rates()
 
 void World::choose_new_kinetic_state(int blob_index, int *target)
 {
-    scalar switch_check;
+    int current_state = active_blob_array[blob_index]->get_state_index();
 
-    // Make some bins
-    vector<scalar[2]> bin(params.num_states[blob_index]);
+    // Pick a bin, each as wide as the rate of switching to that state
+    scalar switch_check = kinetic_rng->RandU01() * get_total_kinetic_rate(blob_index);
     scalar total = 0.0;
     for (int i = 0; i < params.num_states[blob_index]; ++i)
     {
+        if (i == current_state || kinetic_rate[blob_index][current_state][i] == 0)
+        {
+            continue;
+        }
 
-        // Lower limit
-        bin[i][0] = total;
+        // The last non-zero bin also catches any rounding at the top end
+        *target = i;
+        total += kinetic_rate[blob_index][current_state][i];
+        if (switch_check <= total)
+        {
+            return;
+        }
+    }
+}
 
-        // Upper limit
-        total += kinetic_rate[blob_index][active_blob_array[blob_index]->get_state_index()][i];
-        bin[i][1] = total;
+scalar World::get_total_kinetic_rate(int blob_index) const
+{
+    int current_state = active_blob_array[blob_index]->get_state_index();
+    scalar total = 0.0;
+    for (int i = 0; i < params.num_states[blob_index]; ++i)
+    {
+        if (i != current_state)
+        {
+            total += kinetic_rate[blob_index][current_state][i];
+        }
     }
+    return total;
+}
 
-    // Round up in case of numerical problems
-    bin[params.num_states[blob_index] - 1][1] = 1.0;
+void World::schedule_kinetic_event(int blob_index, scalar now)
+{
+    scalar total_rate = get_total_kinetic_rate(blob_index);
+    kinetic_event_total_rate[blob_index] = total_rate;
+    if (total_rate <= 0)
+    {
+        kinetic_event_time[blob_index] = std::numeric_limits<scalar>::infinity();
+        return;
+    }
 
-    // Get a random number
-    switch_check = kinetic_rng->RandU01();
+    // Switching is memoryless, so whenever the rates change the waiting time can simply be sampled again from now
+    kinetic_event_time[blob_index] = now - std::log(kinetic_rng->RandU01()) / total_rate;
+    kinetic_events.emplace(kinetic_event_time[blob_index], blob_index);
+}
 
-    // See which bin this falls into
-    for (int i = 0; i < params.num_states[blob_index]; ++i)
+void World::start_kinetic_events(long long step)
+{
+    // Binding rates are the only ones that depend on the environment (how close the binding sites are)
+    kinetic_rates_depend_on_sites = false;
+    for (int i = 0; i < params.num_blobs; ++i)
     {
-        if (switch_check > bin[i][0] && switch_check <= bin[i][1])
+        for (int j = 0; j < params.num_states[i]; ++j)
         {
-            *target = i;
+            for (int k = 0; k < params.num_states[i]; ++k)
+            {
+                if (j != k && kinetic_base_rate[i][j][k] != 0 &&
+                    kinetic_state[i][j].get_conformation_index() == kinetic_state[i][k].get_conformation_index() &&
+                    !kinetic_state[i][j].is_bound() && kinetic_state[i][k].is_bound())
+                {
+                    kinetic_rates_depend_on_sites = true;
+                }
+            }
+        }
+    }
+
+    // A restart carries on with the events that were waiting when the checkpoint was written, so that it makes the
+    // same switches as an uninterrupted run would have. Binding rates are worked out again from the restart positions
+    const bool restored = kinetic_event_time.size() == static_cast<size_t>(params.num_blobs);
+    kinetic_events = decltype(kinetic_events)();
+    if (!restored)
+    {
+        kinetic_event_time.assign(params.num_blobs, std::numeric_limits<scalar>::infinity());
+        kinetic_event_total_rate.assign(params.num_blobs, 0);
+    }
+    calculate_kinetic_rates();
+    for (int i = 0; i < params.num_blobs; ++i)
+    {
+        if (restored && kinetic_event_time[i] != std::numeric_limits<scalar>::infinity())
+            kinetic_events.emplace(kinetic_event_time[i], i);
+        else
+            schedule_kinetic_event(i, static_cast<scalar>(step));
+    }
+}
+
+void World::do_kinetic_events(long long step)
+{
+    const scalar now = static_cast<scalar>(step);
+    bool rates_changed = false;
+
+    // Binding sites move with the blobs, so binding rates are checked every kinetics_update steps
+    if (kinetic_rates_depend_on_sites && step % params.kinetics_update == 0)
+    {
+        calculate_kinetic_rates();
+        rates_changed = true;
+    }
+
+    // Carry out every event due by now. Each one is followed by a new event from the blob's new state, below
+    std::vector<int> switched;
+    while (!kinetic_events.empty() && kinetic_events.top().first <= now)
+    {
+        std::pair<scalar, int> event = kinetic_events.top();
+        kinetic_events.pop();
+        int i = event.second;
+        if (event.first != kinetic_event_time[i])
+        {
+            continue;
+        }
+
+        int target = active_blob_array[i]->get_state_index();
+        choose_new_kinetic_state(i, &target);
+        change_kinetic_state(i, target);
+        kinetic_event_time[i] = std::numeric_limits<scalar>::infinity();
+        switched.push_back(i);
+    }
+
+    // A switch changes the rates of that blob, and may move (or bind) its binding sites
+    if (!switched.empty())
+    {
+        calculate_kinetic_rates();
+        rates_changed = true;
+    }
+
+    // Re-sample only the blobs that switched, or whose total rate is no longer the one their event was sampled from
+    if (rates_changed)
+    {
+        for (int i = 0; i < params.num_blobs; ++i)
+        {
+            if (kinetic_event_time[i] == std::numeric_limits<scalar>::infinity() || get_total_kinetic_rate(i) != kinetic_event_total_rate[i])
+            {
+                schedule_kinetic_event(i, now);
+            }
         }
     }
 }
@@ -3334,8 +3548,8 @@ void World::load_kinetic_rates(string rates_fname, int blob_index)
         kinetic_rate[blob_index][0] = std::vector<scalar>(1);
         kinetic_base_rate[blob_index][0] = std::vector<scalar>(1);
 
-        kinetic_rate[blob_index][0][0] = 1.0;
-        kinetic_base_rate[blob_index][0][0] = 1.0;
+        kinetic_rate[blob_index][0][0] = 0.0;
+        kinetic_base_rate[blob_index][0][0] = 0.0;
 
         return;
     }
@@ -3369,13 +3583,9 @@ void World::load_kinetic_rates(string rates_fname, int blob_index)
         kinetic_base_rate[blob_index][i] = std::vector<scalar>(num_states);
     }
 
-    scalar total_prob;
-
-    // Get each state's rates and check total probability is conserved
+    // Get each state's rates
     for (int i = 0; i < num_states; ++i)
     {
-        total_prob = 0.0;
-
         // Get a line and split it
         fgets(buf.data(), 255, fin);
         boost::split(sline, buf, boost::is_any_of(" "), boost::token_compress_on);
@@ -3393,23 +3603,16 @@ void World::load_kinetic_rates(string rates_fname, int blob_index)
             kinetic_base_rate[blob_index][i][j] = atof((*it).c_str());
             kinetic_base_rate[blob_index][i][j] *= mesoDimensions::time;
 
-            // Change to probabilities and ignore diagonal
-            kinetic_base_rate[blob_index][i][j] *= params.dt * params.kinetics_update;
-            if (i != j)
+            // Change to rates per time step. Switching times are sampled from these, so they need not be small
+            kinetic_base_rate[blob_index][i][j] *= params.dt;
+            if (kinetic_base_rate[blob_index][i][j] < 0)
             {
-                total_prob += kinetic_base_rate[blob_index][i][j];
+                throw FFEAException("\nRate %d -> %d in '%s' is negative.", i, j, rates_fname.c_str());
             }
         }
 
-        // Prob of not switching (for completion)
-        if (total_prob > 1)
-        {
-            throw FFEAException(
-                "P(switch_state in kinetic update period) = rate(switch_state)(Hz) * dt * kinetics_update\n"
-                "Due to the size of your rates, your timestep, and your kinetic_update value, the total probability of changing states each kinetic update period is greater than one.\n"
-                "Best solution - Reduce 'kinetics_update' parameter");
-        }
-        kinetic_base_rate[blob_index][i][i] = 1 - total_prob;
+        // Staying put is not an event
+        kinetic_base_rate[blob_index][i][i] = 0;
     }
 }
 
@@ -3901,17 +4104,153 @@ rod::Rod *World::rod_from_block(vector<string> block, int block_id, FFEA_input_r
     return current_rod;
 }
 
+/** Work out which rod-blob interfaces can share a Tet_rotation_batch (those
+ * on the same tetrahedron, with the same displacement and reference
+ * Jacobian), and group the interfaces by rod. Run after update_J_0.
+*/
+void World::group_rod_blob_interfaces()
+{
+    interface_tet_batches.clear();
+    interface_batch_index.assign(params.num_interfaces, -1);
+    rod_interface_groups.clear();
+    interface_forces.resize(params.num_interfaces);
+
+    std::vector<rod::Rod *> group_rods;
+    for (int i = 0; i < params.num_interfaces; i++)
+    {
+        rod::Rod_blob_interface *interface = rod_blob_interface_array[i];
+        float displacement = interface->get_dynamics_displacement();
+        for (size_t j = 0; j < interface_tet_batches.size(); j++)
+        {
+            const rod::Tet_rotation_batch &batch = interface_tet_batches[j];
+            if (batch.tet == interface->connected_tet && batch.displacement == displacement && batch.J_inv_0 == interface->J_inv_0)
+            {
+                interface_batch_index[i] = j;
+                break;
+            }
+        }
+        if (interface_batch_index[i] == -1)
+        {
+            rod::Tet_rotation_batch batch;
+            batch.tet = interface->connected_tet;
+            batch.displacement = displacement;
+            batch.J_inv_0 = interface->J_inv_0;
+            interface_batch_index[i] = interface_tet_batches.size();
+            interface_tet_batches.push_back(batch);
+        }
+
+        auto group = std::find(group_rods.begin(), group_rods.end(), interface->connected_rod);
+        if (group == group_rods.end())
+        {
+            group_rods.push_back(interface->connected_rod);
+            rod_interface_groups.push_back({i});
+        }
+        else
+        {
+            rod_interface_groups[group - group_rods.begin()].push_back(i);
+        }
+    }
+}
+
+/** Step all of the rod-blob interfaces. Equivalent to calling
+ * do_connection_timestep on each in turn, but the perturbed rotations of
+ * each tetrahedron are only found once per step, and interfaces on
+ * different rods (which do not touch each other's state) are stepped
+ * concurrently. The forces are added to the blobs afterwards, in interface
+ * order, so the result does not depend on the number of threads.
+*/
+void World::do_rod_blob_interface_timestep()
+{
+    if (params.num_interfaces == 0)
+        return;
+
+    int num_batches = interface_tet_batches.size();
+    int num_groups = rod_interface_groups.size();
+    std::vector<std::exception_ptr> interface_errors(num_groups);
+#pragma omp parallel default(none) shared(num_batches, num_groups, interface_errors)
+    {
+#pragma omp for schedule(dynamic)
+        for (int i = 0; i < num_batches; i++)
+            interface_tet_batches[i].build(interface_tet_batches[i].tet);
+
+#pragma omp for schedule(dynamic)
+        for (int i = 0; i < num_groups; i++)
+        {
+            try
+            {
+                for (int j : rod_interface_groups[i])
+                {
+                    rod_blob_interface_array[j]->begin_connection_timestep();
+                    rod_blob_interface_array[j]->get_connection_forces(interface_tet_batches[interface_batch_index[j]], interface_forces[j]);
+                }
+            }
+            catch (...)
+            {
+                interface_errors[i] = std::current_exception();
+            }
+        }
+    }
+    for (const std::exception_ptr &error : interface_errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    for (int i = 0; i < params.num_interfaces; i++)
+        rod_blob_interface_array[i]->apply_connection_forces(interface_forces[i]);
+}
+
+/** Populate the steric neighbour lists of all rods.
+ *
+ * The rod elements are bounded by spheres around their midpoints, and only
+ * the element pairs whose spheres are close, from rod_steric_cells, are
+ * checked. These are only searched for again once the elements have moved
+ * far enough for new pairs to be possible.
+*/
+void World::update_rod_steric_nbr_lists()
+{
+    rod::float3 r = {0};
+    rod::float3 p = {0};
+
+    rod_nbr_spheres.clear();
+    rod_nbr_ids.clear();
+    for (int i = 0; i < params.num_rods; i++)
+    {
+        rod_array[i]->check_nbr_list_dim(rod_array[i]->steric_nbrs);
+        for (int elem = 0; elem < rod_array[i]->get_num_nodes() - 1; elem++)
+        {
+            rod_array[i]->get_r(elem, r, false);
+            rod_array[i]->get_p(elem, p, false);
+            rod::NbrSphere sphere;
+            rod::get_element_midpoint(p, r, sphere.centre);
+            sphere.radius = 0.5 * rod::absolute(p) + rod_array[i]->get_radius(elem);
+            sphere.rod_id = i;
+            rod_nbr_spheres.push_back(sphere);
+            rod_nbr_ids.push_back({i, elem});
+        }
+    }
+
+    rod_steric_cells.update(rod_nbr_spheres, params.pbc_rod, {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]});
+
+    // The pairs are sorted, so each element's interactions end up in the
+    // same order as when looping over every element pair of every pair of rods
+    for (const std::array<int, 2> &pair : rod_steric_cells.get_pairs())
+    {
+        const std::array<int, 2> &a = rod_nbr_ids[pair[0]];
+        const std::array<int, 2> &b = rod_nbr_ids[pair[1]];
+        add_rod_steric_nbrs(rod_array[a[0]], a[1], rod_array[b[0]], b[1]);
+    }
+
+    for (int i = 0; i < params.num_rods; i++)
+        rod_array[i]->steric_nbrs.group();
+}
+
 /** Populate neighbour lists of two rods, a and b.
  *
  * Loops over every element of both rods; O(N^2).
 */
 void World::update_rod_steric_nbr_lists(rod::Rod *rod_a, rod::Rod *rod_b)
 {
-    rod::float3 r_a = {0};
-    rod::float3 r_b = {0};
-    rod::float3 p_a = {0};
-    rod::float3 p_b = {0};
-
     rod_a->check_nbr_list_dim(rod_a->steric_nbrs);
     rod_b->check_nbr_list_dim(rod_b->steric_nbrs);
 
@@ -3922,81 +4261,144 @@ void World::update_rod_steric_nbr_lists(rod::Rod *rod_a, rod::Rod *rod_b)
     {
         for (int elem_b = 0; elem_b < rod_b->get_num_nodes() - 1; elem_b++)
         {
-            rod_a->get_r(elem_a, r_a, false);
-            rod_b->get_r(elem_b, r_b, false);
-            rod_a->get_p(elem_a, p_a, false);
-            rod_b->get_p(elem_b, p_b, false);
-
-            // assign to both elements
-            rod::set_steric_nbrs(
-                rod_a->rod_no,
-                rod_b->rod_no,
-                elem_a,
-                elem_b,
-                p_a,
-                p_b,
-                r_a,
-                r_b,
-                rod_a->get_radius(elem_a),
-                rod_b->get_radius(elem_b),
-                rod_a->steric_nbrs.at(elem_a),
-                rod_b->steric_nbrs.at(elem_b),
-                params.pbc_rod,
-                {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]});
+            add_rod_steric_nbrs(rod_a, elem_a, rod_b, elem_b);
         }
     }
+
+    rod_a->steric_nbrs.group();
+    rod_b->steric_nbrs.group();
 }
 
-// ! - currently broken
-void World::update_rod_vdw_nbr_lists(rod::Rod *rod_a, rod::Rod *rod_b, SSINT_matrix *lj_matrix)
+/** Add the steric interaction between two elements to both neighbour lists, if they intersect. */
+void World::add_rod_steric_nbrs(rod::Rod *rod_a, int elem_a, rod::Rod *rod_b, int elem_b)
 {
     rod::float3 r_a = {0};
     rod::float3 r_b = {0};
     rod::float3 p_a = {0};
     rod::float3 p_b = {0};
 
+    rod_a->get_r(elem_a, r_a, false);
+    rod_b->get_r(elem_b, r_b, false);
+    rod_a->get_p(elem_a, p_a, false);
+    rod_b->get_p(elem_b, p_b, false);
+
+    // assign to both elements
+    rod::set_steric_nbrs(
+        rod_a->rod_no,
+        rod_b->rod_no,
+        elem_a,
+        elem_b,
+        p_a,
+        p_b,
+        r_a,
+        r_b,
+        rod_a->get_radius(elem_a),
+        rod_b->get_radius(elem_b),
+        rod_a->steric_nbrs,
+        rod_b->steric_nbrs,
+        params.pbc_rod,
+        {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]});
+}
+
+/** Populate the VDW neighbour lists of all rods.
+ *
+ * As for the steric lists, but the spheres are centred on the VDW sites and
+ * reach out to the VDW cutoff.
+*/
+void World::update_rod_vdw_nbr_lists(SSINT_matrix *lj_matrix)
+{
+    rod_nbr_spheres.clear();
+    rod_nbr_ids.clear();
+    for (int i = 0; i < params.num_rods; i++)
+    {
+        rod_array[i]->check_nbr_list_dim(rod_array[i]->vdw_nbrs);
+        for (int site = 0; site < (int)rod_array[i]->vdw_sites.size(); site++)
+        {
+            rod::VDWSite &vdw_site = rod_array[i]->vdw_sites[site];
+            vdw_site.update_position(rod_array[i]->current_r);
+            rod::NbrSphere sphere;
+            sphere.centre = vdw_site.pos;
+            sphere.radius = rod_array[i]->get_radius(vdw_site.elem_id) + 0.5 * params.ssint_cutoff;
+            sphere.rod_id = i;
+            rod_nbr_spheres.push_back(sphere);
+            rod_nbr_ids.push_back({i, site});
+        }
+    }
+
+    rod_vdw_cells.update(rod_nbr_spheres, params.pbc_rod, {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]});
+
+    for (const std::array<int, 2> &pair : rod_vdw_cells.get_pairs())
+    {
+        rod::Rod *rod_a = rod_array[rod_nbr_ids[pair[0]][0]];
+        rod::Rod *rod_b = rod_array[rod_nbr_ids[pair[1]][0]];
+        add_rod_vdw_nbrs(rod_a, rod_a->vdw_sites[rod_nbr_ids[pair[0]][1]], rod_b, rod_b->vdw_sites[rod_nbr_ids[pair[1]][1]], lj_matrix);
+    }
+
+    for (int i = 0; i < params.num_rods; i++)
+        rod_array[i]->vdw_nbrs.group();
+}
+
+// ! - currently broken
+void World::update_rod_vdw_nbr_lists(rod::Rod *rod_a, rod::Rod *rod_b, SSINT_matrix *lj_matrix)
+{
     if (rod::dbg_print)
         std::cout << "Updating vdw neighbour lists of rods " << rod_a->rod_no << " and " << rod_b->rod_no << std::endl;
 
     rod_a->check_nbr_list_dim(rod_a->vdw_nbrs);
     rod_b->check_nbr_list_dim(rod_b->vdw_nbrs);
 
+    for (auto &site : rod_a->vdw_sites)
+        site.update_position(rod_a->current_r);
+    for (auto &site : rod_b->vdw_sites)
+        site.update_position(rod_b->current_r);
+
     for (auto &site_a : rod_a->vdw_sites)
     {
-
         for (auto &site_b : rod_b->vdw_sites)
         {
-            int elem_a = site_a.elem_id;
-            int elem_b = site_b.elem_id;
-
-            site_a.update_position(rod_a->current_r);
-            site_b.update_position(rod_b->current_r);
-
-            rod_a->get_r(elem_a, r_a, false);
-            rod_b->get_r(elem_b, r_b, false);
-            rod_a->get_p(elem_a, p_a, false);
-            rod_b->get_p(elem_b, p_b, false);
-
-            map<string, scalar> pmap = lj_matrix->get_SSINT_params(site_a.vdw_type, site_b.vdw_type);
-
-            rod::set_vdw_nbrs(
-                site_a,
-                site_b,
-                p_a,
-                p_b,
-                r_a,
-                r_b,
-                rod_a->get_radius(elem_a),
-                rod_b->get_radius(elem_b),
-                rod_a->vdw_nbrs.at(elem_a),
-                rod_b->vdw_nbrs.at(elem_b),
-                params.pbc_rod,
-                {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]},
-                params.ssint_cutoff,
-                pmap["Emin"],
-                pmap["Rmin"]);
+            add_rod_vdw_nbrs(rod_a, site_a, rod_b, site_b, lj_matrix);
         }
     }
+
+    rod_a->vdw_nbrs.group();
+    rod_b->vdw_nbrs.group();
+}
+
+/** Add the VDW interaction between two sites to both neighbour lists, if they are within the cutoff. */
+void World::add_rod_vdw_nbrs(rod::Rod *rod_a, rod::VDWSite &site_a, rod::Rod *rod_b, rod::VDWSite &site_b, SSINT_matrix *lj_matrix)
+{
+    rod::float3 r_a = {0};
+    rod::float3 r_b = {0};
+    rod::float3 p_a = {0};
+    rod::float3 p_b = {0};
+
+    int elem_a = site_a.elem_id;
+    int elem_b = site_b.elem_id;
+
+    rod_a->get_r(elem_a, r_a, false);
+    rod_b->get_r(elem_b, r_b, false);
+    rod_a->get_p(elem_a, p_a, false);
+    rod_b->get_p(elem_b, p_b, false);
+
+    const SSINT_table &ssint = lj_matrix->get_SSINT_table();
+    const int ip = lj_matrix->get_SSINT_index(site_a.vdw_type, site_b.vdw_type);
+
+    rod::set_vdw_nbrs(
+        site_a,
+        site_b,
+        p_a,
+        p_b,
+        r_a,
+        r_b,
+        rod_a->get_radius(elem_a),
+        rod_b->get_radius(elem_b),
+        rod_a->vdw_nbrs,
+        rod_b->vdw_nbrs,
+        params.pbc_rod,
+        {(float)box_dim[0], (float)box_dim[1], (float)box_dim[2]},
+        params.ssint_cutoff,
+        ssint.Emin[ip],
+        ssint.Rmin[ip]);
 }
 
 // If rod centroid leaves simulation box, apply PBC wrap
@@ -4049,6 +4451,139 @@ void World::rod_box_length_check(rod::Rod *current_rod, std::vector<float> dim)
     }
 }
 
+/**
+ * @brief Binary rod trajectories start with this line, followed by the
+ * int32 version, number of rods and diagnostics flag, then the int32 number
+ * of nodes and VDW sites of every rod, then the static data of every rod
+ * (Rod::append_static_data). Each frame is the int64 step followed by
+ * Rod::append_frame for every rod, all as native floats in SI units.
+ */
+static const char rod_binary_magic[] = "FFEA_rod_binary_trajectory\n";
+static const int32_t rod_binary_version = 1;
+
+/**
+ * @brief Create the binary rod trajectory and write its header, or, when the
+ * rods are restarting from it, cut it back to its last complete frame and
+ * append to it. Each rod's .rodtraj keeps its text header and a single frame
+ * of the starting state, which is what restarts and the existing tools read
+ * the static data from.
+ */
+void World::open_rod_binary_trajectory()
+{
+    if (rod_traj_restart_size > 0)
+    {
+        error_code ec;
+        filesystem::resize_file(params.rod_traj_out_fname, rod_traj_restart_size, ec);
+        if (ec)
+            throw FFEAException("Error when trying to truncate rod trajectory file %s", params.rod_traj_out_fname.c_str());
+        if (!(rod_traj_out = fopen(params.rod_traj_out_fname.c_str(), "ab")))
+            throw FFEAFileException(params.rod_traj_out_fname);
+        return;
+    }
+
+    if (!(rod_traj_out = fopen(params.rod_traj_out_fname.c_str(), "wb")))
+        throw FFEAFileException(params.rod_traj_out_fname);
+
+    int32_t header[3] = {rod_binary_version, params.num_rods, params.rod_traj_diagnostics};
+    fwrite(rod_binary_magic, 1, sizeof(rod_binary_magic) - 1, rod_traj_out);
+    fwrite(header, sizeof(int32_t), 3, rod_traj_out);
+    for (int i = 0; i < params.num_rods; i++)
+    {
+        int32_t sizes[2] = {rod_array[i]->num_nodes, rod_array[i]->num_vdw_sites};
+        fwrite(sizes, sizeof(int32_t), 2, rod_traj_out);
+    }
+    rod_traj_buffer.clear();
+    for (int i = 0; i < params.num_rods; i++)
+    {
+        rod_array[i]->append_static_data(rod_traj_buffer);
+        if (rod_array[i]->frame_no == 0)
+            rod_array[i]->write_frame_to_file();
+    }
+    fwrite(rod_traj_buffer.data(), sizeof(float), rod_traj_buffer.size(), rod_traj_out);
+    fflush(rod_traj_out);
+}
+
+/**
+ * @brief If the rods are restarting and a binary rod trajectory exists, check
+ * that it matches the rods and load current_r and current_m from its last
+ * complete frame, once the last frames_to_delete frames have been dropped,
+ * as for the other trajectories. Its size up to that frame is kept for
+ * open_rod_binary_trajectory, which drops anything written after it.
+ */
+void World::load_rod_binary_trajectory(int frames_to_delete)
+{
+    rod_traj_restart_size = 0;
+    if (!rod_array[0]->restarting)
+        return;
+
+    ifstream in(params.rod_traj_out_fname, ios::binary);
+    if (!in)
+    {
+        printf("\tFRIENDLY WARNING: No binary rod trajectory %s to restart from, rods will restart from their .rodtraj files\n", params.rod_traj_out_fname.c_str());
+        return;
+    }
+
+    std::string magic(sizeof(rod_binary_magic) - 1, '\0');
+    int32_t header[3] = {0};
+    in.read(&magic[0], magic.size());
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || magic != rod_binary_magic || header[0] != rod_binary_version)
+        throw FFEAException("%s is not a binary rod trajectory that this version of FFEA can read.", params.rod_traj_out_fname.c_str());
+    if (header[1] != params.num_rods || header[2] != params.rod_traj_diagnostics)
+        throw FFEAException("The number of rods or 'rod_traj_diagnostics' in %s do not match the script.", params.rod_traj_out_fname.c_str());
+
+    long static_length = 0;
+    long frame_length = 0;
+    for (int i = 0; i < params.num_rods; i++)
+    {
+        int32_t sizes[2] = {0};
+        in.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+        if (!in || sizes[0] != rod_array[i]->num_nodes || sizes[1] != rod_array[i]->num_vdw_sites)
+            throw FFEAException("Rod %d in %s does not match its .rodtraj file.", i, params.rod_traj_out_fname.c_str());
+        static_length += (3 * 3 + 4) * sizes[0];
+        frame_length += rod_array[i]->get_frame_length(params.rod_traj_diagnostics);
+    }
+
+    long header_size = static_cast<long>(in.tellg()) + static_length * static_cast<long>(sizeof(float));
+    long frame_size = sizeof(int64_t) + frame_length * static_cast<long>(sizeof(float));
+    in.seekg(0, ios::end);
+    long num_frames = (static_cast<long>(in.tellg()) - header_size) / frame_size;
+    num_frames = std::max(num_frames - frames_to_delete, 0L);
+    rod_traj_restart_size = header_size + num_frames * frame_size;
+    if (num_frames <= 0)
+        return;
+
+    int64_t rstep = 0;
+    std::vector<float> frame(frame_length);
+    in.seekg(rod_traj_restart_size - frame_size);
+    in.read(reinterpret_cast<char*>(&rstep), sizeof(rstep));
+    in.read(reinterpret_cast<char*>(frame.data()), frame_length * sizeof(float));
+    if (!in)
+        throw FFEAException("Could not read the last frame of %s", params.rod_traj_out_fname.c_str());
+
+    const float *frame_ptr = frame.data();
+    for (int i = 0; i < params.num_rods; i++)
+        rod_array[i]->load_binary_frame(frame_ptr, params.rod_traj_diagnostics);
+    printf("Loaded rod positions from step %lld of %s\n", static_cast<long long>(rstep), params.rod_traj_out_fname.c_str());
+}
+
+/**
+ * @brief Write one frame of the binary rod trajectory: every rod's positions
+ * and material frames, gathered into one buffer and written with a single call.
+ */
+void World::write_rod_binary_frame(int step)
+{
+    // the int64 step takes the place of the first two floats
+    int64_t frame_step = step;
+    rod_traj_buffer.assign(sizeof(int64_t) / sizeof(float), 0);
+    memcpy(rod_traj_buffer.data(), &frame_step, sizeof(int64_t));
+    for (int i = 0; i < params.num_rods; i++)
+        rod_array[i]->append_frame(rod_traj_buffer, params.rod_traj_diagnostics);
+
+    fwrite(rod_traj_buffer.data(), sizeof(float), rod_traj_buffer.size(), rod_traj_out);
+    fflush(rod_traj_out);
+}
+
 void World::activate_springs()
 {
     for (auto &spring : spring_array)
@@ -4489,17 +5024,21 @@ void World::print_trajectory_and_measurement_files(int step, scalar wtime)
     // TRAJECTORY END
 
     //Write rod trajectory (skip first frame if this is a restart)
+    bool rods_restarting = false;
     for (int i = 0; i < params.num_rods; i++)
     {
         if (rod_array[i]->restarting)
         {
             rod_array[i]->restarting = false;
+            rods_restarting = true;
         }
-        else
+        else if (params.rod_traj_format == "text")
         {
             rod_array[i]->write_frame_to_file();
         }
     }
+    if (params.num_rods > 0 && params.rod_traj_format == "binary" && !rods_restarting)
+        write_rod_binary_frame(step);
 
     // Detailed Measurement Stuff.
     // Stuff needed on each blob, and in global energy files
@@ -4589,6 +5128,12 @@ void World::print_checkpoints()
         kinetic_rng->GetState(state.data());
         fprintf(checkpoint_out, "%u %u %u %u %u %u\n", state[0], state[1], state[2],
                 state[3], state[4], state[5]);
+        // and the events still waiting, which were drawn from it earlier, with the total rate each was drawn from:
+        fprintf(checkpoint_out, "Pending kinetic events: %d\n", params.num_blobs);
+        for (int i = 0; i < params.num_blobs; i++)
+        {
+            fprintf(checkpoint_out, "%.17g %.17g\n", static_cast<double>(kinetic_event_time[i]), static_cast<double>(kinetic_event_total_rate[i]));
+        }
     }
     //cout << "hi" << endl << flush;
     fflush(checkpoint_out);
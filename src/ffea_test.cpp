@@ -47,6 +47,9 @@
 #include "Solver.h"
 #include "SparseSubstitutionSolver.h"
 #include "rod_interactions.h"
+#include "VdW_solver.h"
+
+#include <random>
 
 int ffea_test::do_ffea_test(std::string filename)
 {
@@ -150,12 +153,48 @@ int ffea_test::do_ffea_test(std::string filename)
         result = ffea_test::rod_vdw_site_placement();
     }
 
+    if (buffer.str().find("rod_nbr_cell_list") !=
+        std::string::npos)
+    {
+        result = ffea_test::rod_nbr_cell_list();
+    }
+
     if (buffer.str().find("point_lies_within_rod_element") !=
         std::string::npos)
     {
         result = ffea_test::point_lies_within_rod_element();
     }
 
+    if (buffer.str().find("ssint_kernels") != std::string::npos)
+    {
+        result = ffea_test::ssint_kernels();
+    }
+
+    if (buffer.str().find("ssint_farfield_quadrature") != std::string::npos)
+    {
+        result = ffea_test::ssint_farfield_quadrature();
+    }
+
+    if (buffer.str().find("tetra_element_kernel") != std::string::npos)
+    {
+        result = ffea_test::tetra_element_kernel();
+    }
+
+    if (buffer.str().find("kinetic_rates") != std::string::npos)
+    {
+        result = ffea_test::kinetic_rates();
+    }
+
+    if (buffer.str().find("binding_site_hash") != std::string::npos)
+    {
+        result = ffea_test::binding_site_hash();
+    }
+
+    if (buffer.str().find("rod_binary_trajectory") != std::string::npos)
+    {
+        result = ffea_test::rod_binary_trajectory();
+    }
+
     return result;
 }
 
@@ -2040,3 +2079,876 @@ int ffea_test::rod_vdw_site_placement()
 
     return 0;
 }
+
+/** Exposes the protected face-pair kernels of VdW_solver */
+class VdW_solver_kernels : public VdW_solver
+{
+public:
+    using VdW_solver::calc_ssint_force_pair_matrix;
+    using VdW_solver::calc_lj_force_pair_matrix;
+    using VdW_solver::calc_ljinterpolated_force_pair_matrix;
+    using VdW_solver::calc_gensoft_force_pair_matrix;
+    using VdW_solver::is_farfield;
+    using VdW_solver::calc_nearfield_nodal_forces;
+    using VdW_solver::calc_farfield_nodal_forces;
+
+    void set_farfield_ratio(scalar ratio) { farfield_ratio2 = ratio * ratio; }
+};
+
+int ffea_test::rod_nbr_cell_list()
+{
+    // Random spheres on three rods, some of which touch
+    const int num_spheres = 300;
+    const int num_steps = 200;
+    std::vector<float> box_dim = {10, 12, 8};
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> unif(0, 1);
+
+    for (int periodic = 0; periodic < 2; periodic++)
+    {
+        std::vector<rod::NbrSphere> spheres(num_spheres);
+        float max_radius = 0;
+        for (int k = 0; k < num_spheres; k++)
+        {
+            vec3d(n) { spheres[k].centre[n] = unif(gen) * box_dim[n]; }
+            spheres[k].radius = 0.2 + 0.4 * unif(gen);
+            spheres[k].rod_id = k % 3;
+            max_radius = std::max(max_radius, spheres[k].radius);
+        }
+
+        // Pairs on different rods within reach of each other, by brute force
+        auto within = [&](int a, int b, float reach) {
+            rod::float3 d;
+            vec3d(n) { d[n] = spheres[b].centre[n] - spheres[a].centre[n]; }
+            if (periodic)
+            {
+                vec3d(n) { d[n] -= box_dim[n] * std::floor((d[n] + 0.5 * box_dim[n]) / box_dim[n]); }
+            }
+            reach += spheres[a].radius + spheres[b].radius;
+            return spheres[a].rod_id != spheres[b].rod_id && rod::absolute(d) < reach;
+        };
+
+        rod::NbrCellList cells;
+        cells.update(spheres, periodic, box_dim);
+
+        // Straight after a build, the pairs are exactly those within the skin
+        std::vector<std::array<int, 2>> expected;
+        float skin = 0.5 * max_radius;
+        for (int a = 0; a < num_spheres; a++)
+            for (int b = a + 1; b < num_spheres; b++)
+                if (within(a, b, skin))
+                    expected.push_back({a, b});
+
+        std::cout << "periodic " << periodic << ": " << cells.get_pairs().size() << " pairs, expected " << expected.size() << "\n";
+        if (cells.get_pairs() != expected)
+        {
+            std::cout << "Fail. Cell list pairs differ from the brute force ones.\n";
+            return 1;
+        }
+
+        // Random walk; every touching pair must stay in the list, which
+        // should only be rebuilt every few steps
+        std::normal_distribution<float> step(0, 0.02);
+        for (int s = 0; s < num_steps; s++)
+        {
+            for (rod::NbrSphere &sphere : spheres)
+                vec3d(n) { sphere.centre[n] += step(gen); }
+            cells.update(spheres, periodic, box_dim);
+
+            const std::vector<std::array<int, 2>> &pairs = cells.get_pairs();
+            for (int a = 0; a < num_spheres; a++)
+            {
+                for (int b = a + 1; b < num_spheres; b++)
+                {
+                    if (within(a, b, 0) && !std::binary_search(pairs.begin(), pairs.end(), std::array<int, 2>{a, b}))
+                    {
+                        std::cout << "Fail. Touching spheres " << a << " and " << b << " are missing on step " << s << ".\n";
+                        return 1;
+                    }
+                }
+            }
+        }
+
+        std::cout << "  " << cells.get_num_builds() << " builds in " << num_steps << " steps\n";
+        if (cells.get_num_builds() < 2 || cells.get_num_builds() > num_steps / 2)
+        {
+            std::cout << "Fail. Unexpected number of rebuilds.\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int ffea_test::ssint_kernels()
+{
+    // Compare the batched SSINT kernels against the scalar, point by point, path
+    const scalar tol = 1e-9;
+    const int num_samples = 1000;
+    const int types[3] = {SSINT_TYPE_LJ, SSINT_TYPE_LJSTERIC, SSINT_TYPE_GENSOFT};
+    const char *names[3] = {"lennard-jones", "ljsteric", "gensoft"};
+
+    SSINT_table ssint;
+    scalar Rmin = 1.2, Emin = 0.7, k0 = 0.3;
+    ssint.Emin = {Emin};
+    ssint.Rmin = {Rmin};
+    ssint.Rmin_3 = {Rmin * Rmin * Rmin};
+    ssint.Rmin_6 = {ssint.Rmin_3[0] * ssint.Rmin_3[0]};
+    ssint.Rmini = {1.0 / Rmin};
+    ssint.k0 = {k0};
+
+    VdW_solver_kernels solver;
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<scalar> unif(-0.5, 0.5);
+    std::uniform_real_distribution<scalar> sep(0.5 * Rmin, 3 * Rmin);
+
+    int fail_count = 0;
+    for (int t = 0; t < 3; t++)
+    {
+        scalar max_rel_err = 0;
+        for (int s = 0; s < num_samples; s++)
+        {
+            // Two small triangles' worth of Gauss points, some within Rmin of each other
+            arr3 p[3], q[3];
+            scalar offset = sep(gen);
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    p[i][j] = 0.2 * unif(gen);
+                    q[i][j] = 0.2 * unif(gen);
+                }
+                q[i][2] += offset;
+            }
+
+            arr3 f_ref[3][3], f_simd[3][3];
+            scalar e_ref = 0, e_simd = 0;
+            if (types[t] == SSINT_TYPE_LJ)
+                solver.calc_lj_force_pair_matrix(f_ref, p, q, ssint.Rmin_6[0], Emin, e_ref);
+            else if (types[t] == SSINT_TYPE_LJSTERIC)
+                solver.calc_ljinterpolated_force_pair_matrix(f_ref, p, q, Rmin, ssint.Rmini[0], ssint.Rmin_6[0], Emin, e_ref);
+            else
+                solver.calc_gensoft_force_pair_matrix(f_ref, p, q, Rmin, ssint.Rmin_3[0], Emin, k0, e_ref);
+            solver.calc_ssint_force_pair_matrix(types[t], f_simd, p, q, ssint, 0, e_simd);
+
+            scalar scale = std::max(std::fabs(e_ref), ffea_const::one);
+            max_rel_err = std::max(max_rel_err, std::fabs(e_simd - e_ref) / scale);
+            for (int k = 0; k < 3; k++)
+            {
+                for (int l = 0; l < 3; l++)
+                {
+                    scale = std::max(magnitude(f_ref[k][l]), ffea_const::one);
+                    for (int j = 0; j < 3; j++)
+                        max_rel_err = std::max(max_rel_err, std::fabs(f_simd[k][l][j] - f_ref[k][l][j]) / scale);
+                }
+            }
+        }
+
+        std::cout << names[t] << ": max relative error " << max_rel_err << "\n";
+        if (max_rel_err > tol)
+        {
+            std::cout << "Fail. Batched " << names[t] << " kernel differs from the scalar path.\n";
+            fail_count++;
+        }
+    }
+
+    if (fail_count == 0)
+        return 0;
+    return 1;
+}
+
+int ffea_test::ssint_farfield_quadrature()
+{
+    // Compare the one-point, centroid-centroid, quadrature used for distant
+    // face pairs against a converged reference integral of LJ over both faces
+    const int num_samples = 200;
+    const scalar ratios[4] = {2, 4, 8, 16};
+    const scalar max_err_at_4 = 0.05;
+
+    // Reference: both triangles split into 64 equal sub-triangles, one point each
+    auto subdivide = [](const std::array<arr3, 3> &tri, int levels, std::vector<arr3> &centroids)
+    {
+        std::vector<std::array<arr3, 3>> tris = {tri}, next;
+        for (int l = 0; l < levels; l++)
+        {
+            next.clear();
+            for (auto &t : tris)
+            {
+                arr3 m01, m12, m20;
+                for (int k = 0; k < 3; k++)
+                {
+                    m01[k] = 0.5 * (t[0][k] + t[1][k]);
+                    m12[k] = 0.5 * (t[1][k] + t[2][k]);
+                    m20[k] = 0.5 * (t[2][k] + t[0][k]);
+                }
+                next.push_back({t[0], m01, m20});
+                next.push_back({m01, t[1], m12});
+                next.push_back({m20, m12, t[2]});
+                next.push_back({m01, m12, m20});
+            }
+            tris.swap(next);
+        }
+        centroids.clear();
+        for (auto &t : tris)
+        {
+            arr3 c;
+            for (int k = 0; k < 3; k++)
+                c[k] = (t[0][k] + t[1][k] + t[2][k]) / 3;
+            centroids.push_back(c);
+        }
+    };
+    auto reference = [&subdivide](Face &fa, Face &fb, const SSINT_table &ssint, arr3 &net_force, scalar &energy)
+    {
+        std::vector<arr3> ca, cb;
+        subdivide({fa.n[0]->pos, fa.n[1]->pos, fa.n[2]->pos}, 3, ca);
+        subdivide({fb.n[0]->pos, fb.n[1]->pos, fb.n[2]->pos}, 3, cb);
+        std::vector<scalar> dx, dy, dz, w, fx, fy, fz;
+        scalar wpair = 1.0 / (ca.size() * cb.size());
+        for (auto &a : ca)
+        {
+            for (auto &b : cb)
+            {
+                dx.push_back(a[0] - b[0]);
+                dy.push_back(a[1] - b[1]);
+                dz.push_back(a[2] - b[2]);
+                w.push_back(wpair);
+            }
+        }
+        int n = dx.size();
+        fx.resize(n);
+        fy.resize(n);
+        fz.resize(n);
+        energy = 0;
+        ssint_lj_kernel(n, dx.data(), dy.data(), dz.data(), w.data(), ssint.Emin[0], ssint.Rmin_6[0],
+                        fx.data(), fy.data(), fz.data(), energy);
+        net_force = {};
+        for (int i = 0; i < n; i++)
+        {
+            net_force[0] += wpair * fx[i];
+            net_force[1] += wpair * fy[i];
+            net_force[2] += wpair * fz[i];
+        }
+        scalar ApAq = fa.area * fb.area;
+        energy *= ApAq;
+        for (int k = 0; k < 3; k++)
+            net_force[k] *= ApAq;
+    };
+
+    SSINT_table ssint;
+    scalar Rmin = 1.0, Emin = 1.0;
+    ssint.Emin = {Emin};
+    ssint.Rmin = {Rmin};
+    ssint.Rmin_3 = {Rmin * Rmin * Rmin};
+    ssint.Rmin_6 = {ssint.Rmin_3[0] * ssint.Rmin_3[0]};
+    ssint.Rmini = {1.0 / Rmin};
+    ssint.k0 = {0};
+
+    VdW_solver_kernels solver;
+    std::vector<scalar> no_corr;
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<scalar> unif(-1, 1);
+
+    mesh_node nodes[6];
+    Face f1, f2;
+    f1.n = {&nodes[0], &nodes[1], &nodes[2], nullptr};
+    f2.n = {&nodes[3], &nodes[4], &nodes[5], nullptr};
+
+    // With no ratio set, nothing is far-field
+    for (int i = 0; i < 6; i++)
+        nodes[i].set_pos(i, 0.5 * i, 100 * (i / 3));
+    f1.calc_area_normal_centroid();
+    f2.calc_area_normal_centroid();
+    arr3 pc, qc;
+    if (solver.is_farfield(&f1, &f2, pc, qc, no_corr))
+    {
+        std::cout << "Fail. Far-field quadrature used while disabled.\n";
+        return 1;
+    }
+
+    scalar prev_err = std::numeric_limits<scalar>::max();
+    for (scalar ratio : ratios)
+    {
+        scalar max_err = 0;
+        for (int s = 0; s < num_samples; s++)
+        {
+            // Two random triangles of size ~1, centred ratio * (r1 + r2) apart along z
+            for (int i = 0; i < 6; i++)
+                nodes[i].set_pos(unif(gen), unif(gen), 0.2 * unif(gen));
+            f1.calc_area_normal_centroid();
+            f2.calc_area_normal_centroid();
+            scalar r1 = 0, r2 = 0;
+            for (int i = 0; i < 3; i++)
+            {
+                r1 = std::max(r1, distance(f1.n[i]->pos, f1.centroid));
+                r2 = std::max(r2, distance(f2.n[i]->pos, f2.centroid));
+            }
+            scalar sep = 1.001 * ratio * (r1 + r2);
+            for (int i = 3; i < 6; i++)
+            {
+                nodes[i].pos[0] += f1.centroid[0] - f2.centroid[0];
+                nodes[i].pos[1] += f1.centroid[1] - f2.centroid[1];
+                nodes[i].pos[2] += f1.centroid[2] - f2.centroid[2] + sep;
+            }
+            f2.calc_area_normal_centroid();
+
+            solver.set_farfield_ratio(ratio);
+            if (!solver.is_farfield(&f1, &f2, pc, qc, no_corr))
+            {
+                std::cout << "Fail. Face pair at ratio " << ratio << " not treated as far-field.\n";
+                return 1;
+            }
+            solver.set_farfield_ratio(1.01 * ratio);
+            if (solver.is_farfield(&f1, &f2, pc, qc, no_corr))
+            {
+                std::cout << "Fail. Face pair below ratio " << 1.01 * ratio << " treated as far-field.\n";
+                return 1;
+            }
+
+            scalar ApAq = f1.area * f2.area;
+            arr3 far1[3], far2[3];
+            scalar e_far = 0, e_ref = 0;
+            arr3 net_ref;
+            solver.calc_farfield_nodal_forces(SSINT_TYPE_LJ, pc, qc, ssint, 0, ApAq, far1, far2, e_far);
+            reference(f1, f2, ssint, net_ref, e_ref);
+
+            // Net force on the first face, and energy
+            arr3 diff = net_ref;
+            for (int j = 0; j < 3; j++)
+            {
+                for (int k = 0; k < 3; k++)
+                    diff[k] -= far1[j][k];
+            }
+            max_err = std::max(max_err, magnitude(diff) / magnitude(net_ref));
+            max_err = std::max(max_err, std::fabs(e_far - e_ref) / std::fabs(e_ref));
+        }
+
+        std::cout << "ratio " << ratio << ": max relative error " << max_err << "\n";
+        if (ratio == 4 && max_err > max_err_at_4)
+        {
+            std::cout << "Fail. One-point quadrature error too large.\n";
+            return 1;
+        }
+        if (max_err > prev_err)
+        {
+            std::cout << "Fail. One-point quadrature error does not decrease with separation.\n";
+            return 1;
+        }
+        prev_err = max_err;
+    }
+
+    return 0;
+}
+
+int ffea_test::tetra_element_kernel()
+{
+    // Compare the batched element kernel used by Blob::update_internal_forces against the
+    // element by element path of tetra_element_linear, with and without thermal noise, and
+    // check that the element colouring never puts two elements sharing a node in one batch
+    const scalar tol = 1e-9;
+    const int nx = 5, ny = 4, nz = 2; // 240 elements, so several colours finishing with partial batches
+    const int perm[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    const uint32_t seed[6] = {12345, 12345, 12345, 12345, 12345, 12345};
+
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<scalar> unif(-0.5, 0.5);
+
+    // A block of unit cubes, each split into six tetrahedra, with randomly displaced nodes
+    auto node_id = [&](const int (&c)[3]) { return (c[0] * (ny + 1) + c[1]) * (nz + 1) + c[2]; };
+    std::vector<mesh_node> node((nx + 1) * (ny + 1) * (nz + 1));
+    std::vector<arr3> vel(node.size());
+    for (int i = 0; i <= nx; i++)
+    {
+        for (int j = 0; j <= ny; j++)
+        {
+            for (int k = 0; k <= nz; k++)
+            {
+                const int c[3] = {i, j, k};
+                mesh_node &node_c = node[node_id(c)];
+                node_c.index = node_id(c);
+                for (int d = 0; d < 3; d++)
+                {
+                    node_c.pos[d] = c[d] + 0.1 * unif(gen);
+                    vel[node_c.index][d] = unif(gen);
+                }
+            }
+        }
+    }
+
+    // Each with random material
+    std::vector<tetra_element_linear> elem;
+    for (int i = 0; i < nx; i++)
+    {
+        for (int j = 0; j < ny; j++)
+        {
+            for (int k = 0; k < nz; k++)
+            {
+                for (int p = 0; p < 6; p++)
+                {
+                    // Walk from one corner of the cube to the opposite one, an axis at a time
+                    int c[3] = {i, j, k};
+                    std::array<int, 4> t;
+                    t[0] = node_id(c);
+                    for (int m = 0; m < 3; m++)
+                    {
+                        c[perm[p][m]]++;
+                        t[m + 1] = node_id(c);
+                    }
+                    // Keep the orientation of the odd permutations the same as the others
+                    if (p == 1 || p == 2 || p == 5)
+                        std::swap(t[2], t[3]);
+
+                    tetra_element_linear elem_p;
+                    for (int n = 0; n < NUM_NODES_QUADRATIC_TET; n++)
+                        elem_p.n[n] = &node[t[n % 4]];
+                    elem_p.index = static_cast<int>(elem.size());
+                    elem_p.A = 1 + unif(gen);
+                    elem_p.B = 1 + unif(gen);
+                    elem_p.G = 2 + unif(gen);
+                    elem_p.E = 4 + unif(gen);
+
+                    matrix3 J;
+                    scalar det;
+                    elem_p.calculate_jacobian(J);
+                    mat3_invert(J, elem_p.J_inv_0, &det);
+                    elem_p.calc_shape_function_derivatives_and_volume(J);
+                    elem_p.vol_0 = elem_p.vol;
+                    elem.push_back(elem_p);
+                }
+            }
+        }
+    }
+    const int num_elements = static_cast<int>(elem.size());
+
+    std::vector<tetra_element_linear> ref_elem = elem;
+    TetraElementBlock block;
+    block.init(elem, NUM_NODES_LINEAR_TET);
+
+    // Check the colouring
+    std::vector<int> times_seen(num_elements, 0);
+    for (int c = 0; c < block.get_num_colours(); c++)
+    {
+        std::vector<int> node_colour_count(node.size(), 0);
+        for (int s = block.get_batch_start(block.get_colour_start(c)); s < block.get_batch_start(block.get_colour_start(c + 1)); s++)
+        {
+            times_seen[block.get_element(s)]++;
+            for (int i = 0; i < NUM_NODES_LINEAR_TET; i++)
+            {
+                if (++node_colour_count[elem[block.get_element(s)].n[i]->index] > 1)
+                {
+                    std::cout << "Fail. Two elements of colour " << c << " share a node.\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    for (int e = 0; e < num_elements; e++)
+    {
+        if (times_seen[e] != 1 || block.get_slot(block.get_element(e)) != e)
+        {
+            std::cout << "Fail. Element " << e << " is not in exactly one slot.\n";
+            return 1;
+        }
+    }
+    std::cout << num_elements << " elements in " << block.get_num_colours() << " colours\n";
+
+    // Deform the elements
+    for (auto &node_i : node)
+    {
+        for (int j = 0; j < 3; j++)
+            node_i.pos[j] += 0.05 * unif(gen);
+    }
+
+    SimulationParams params;
+    params.kT = 0.1;
+    params.dt = 0.01;
+    for (int noise = 0; noise < 2; noise++)
+    {
+        params.calc_noise = noise;
+        auto ref_rng = std::make_shared<std::vector<RngStream>>(1);
+        auto rng = std::make_shared<std::vector<RngStream>>(1);
+        (*ref_rng)[0].SetSeed(seed);
+        (*rng)[0].SetSeed(seed);
+
+        // Element by element (in slot order, so both paths use the same random numbers for each element)
+        std::vector<scalar> ref_stress_mag(num_elements);
+        std::vector<arr3> ref_force(node.size(), {0, 0, 0});
+        for (int s = 0; s < num_elements; s++)
+        {
+            const int e = block.get_element(s);
+            matrix3 J, stress = {};
+            vector12 du;
+            ref_elem[e].calculate_jacobian(J);
+            if (ref_elem[e].calc_shape_function_derivatives_and_volume(J))
+            {
+                std::cout << "Fail. Element " << e << " inverted in the element by element path.\n";
+                return 1;
+            }
+            ref_elem[e].create_viscosity_matrix();
+            ref_elem[e].add_shear_elastic_stress(J, stress);
+            ref_elem[e].add_bulk_elastic_stress(stress);
+            if (noise == 1)
+                ref_elem[e].add_fluctuating_stress(params, ref_rng, stress, 0);
+            ref_stress_mag[e] = sqrt(mat3_double_contraction_symmetric(stress));
+            ref_elem[e].get_element_velocity_vector(vel, du);
+            mat12_apply(ref_elem[e].viscosity_matrix, du);
+            ref_elem[e].apply_stress_tensor(stress, du);
+            for (int i = 0; i < NUM_NODES_LINEAR_TET; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                    ref_force[ref_elem[e].n[i]->index][j] -= du[i + 4 * j];
+            }
+        }
+
+        // Batched, with the viscous force calculated from the stress rather than the viscosity matrix
+        TetraElementBatch batch;
+        std::vector<arr3> force(node.size(), {0, 0, 0});
+        scalar max_visc_err = 0;
+        for (int b = 0; b < block.get_num_batches(); b++)
+        {
+            const int begin = block.get_batch_start(b);
+            const int end = block.get_batch_start(b + 1);
+            if (noise == 1)
+                block.draw_noise(begin, end, rng, 0, batch);
+            if (block.calc_stress_forces(begin, end, node, vel, params, true, batch) != 0)
+            {
+                std::cout << "Fail. Elements inverted in the batched path.\n";
+                return 1;
+            }
+            block.add_element_force_vectors(begin, end, batch, force);
+
+            // The explicit viscosity matrix (still needed by the CG_nomass solver)
+            for (int s = begin; s < end; s++)
+            {
+                const tetra_element_linear &ref_elem_s = ref_elem[block.get_element(s)];
+                vector12 dpsi;
+                matrix12 V;
+                batch.get_dpsi(s - begin, dpsi);
+                block.create_viscosity_matrix(s, dpsi, V);
+                for (int i = 0; i < 12; i++)
+                {
+                    for (int j = 0; j < 12; j++)
+                        max_visc_err = std::max(max_visc_err, std::fabs(V[i][j] - ref_elem_s.viscosity_matrix[i][j]) / std::max(std::fabs(ref_elem_s.viscosity_matrix[i][j]), ffea_const::one));
+                }
+            }
+        }
+
+        scalar max_rel_err = max_visc_err;
+        for (size_t n = 0; n < node.size(); n++)
+        {
+            scalar scale = std::max(magnitude(ref_force[n]), ffea_const::one);
+            for (int j = 0; j < 3; j++)
+                max_rel_err = std::max(max_rel_err, std::fabs(force[n][j] - ref_force[n][j]) / scale);
+        }
+        for (int e = 0; e < num_elements; e++)
+        {
+            const int s = block.get_slot(e);
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                    max_rel_err = std::max(max_rel_err, std::fabs(block.F_ij[s][i][j] - ref_elem[e].F_ij[i][j]));
+            }
+            max_rel_err = std::max(max_rel_err, std::fabs(block.vol[s] - ref_elem[e].vol) / ref_elem[e].vol);
+            max_rel_err = std::max(max_rel_err, std::fabs(block.internal_stress_mag[s] - ref_stress_mag[e]) / std::max(ref_stress_mag[e], ffea_const::one));
+        }
+
+        std::cout << (noise == 1 ? "with" : "without") << " noise: max relative error " << max_rel_err << "\n";
+        if (max_rel_err > tol)
+        {
+            std::cout << "Fail. Batched element kernel differs from the element by element path.\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int ffea_test::kinetic_rates()
+{
+    // Run a single blob through World's kinetic event queue for many steps, with three states
+    // of the same conformation so that every switch is an identity event. States 0 and 1
+    // switch into each other with known rates, state 2 can never be reached, and the diagonal
+    // of the rate matrix is set to a rate that must never be used
+    const long long num_steps = 2000000;
+    const scalar k01 = 0.02, k10 = 0.05; // per step
+    const scalar tol = 0.03;
+
+    World world = World();
+    world.params.num_blobs = 1;
+    world.params.num_states = {3};
+    world.blob_array = new Blob *[1];
+    world.blob_array[0] = new Blob[1];
+    world.active_blob_array = new Blob *[1];
+    world.active_blob_array[0] = &world.blob_array[0][0];
+    world.kinetic_rng = std::make_unique<RngStream>();
+
+    world.kinetic_state = std::vector<std::vector<KineticState>>(1, std::vector<KineticState>(3));
+    for (KineticState &state : world.kinetic_state[0])
+        state.init(0, -1, -1);
+    world.kinetic_base_rate = {{{0.5, k01, 0},
+                                {k10, 0.5, 0},
+                                {0.1, 0.1, 0.5}}};
+    world.kinetic_rate = world.kinetic_base_rate;
+
+    // Events land on the first step at or after their sampled time, so a dwell of rate k
+    // is geometric, with mean 1 / (1 - exp(-k)) steps
+    const scalar expected_dwell[2] = {1 / (1 - std::exp(-k01)), 1 / (1 - std::exp(-k10))};
+    const scalar expected_occupancy = expected_dwell[0] / (expected_dwell[0] + expected_dwell[1]);
+
+    std::array<long long, 3> steps_in_state = {0, 0, 0};
+    std::array<scalar, 2> dwell_sum = {0, 0};
+    std::array<long long, 2> num_dwells = {0, 0};
+    long long last_switch = -1;
+    world.start_kinetic_events(0);
+    for (long long step = 1; step <= num_steps; step++)
+    {
+        const int before = world.active_blob_array[0]->get_state_index();
+        world.do_kinetic_events(step);
+        const int after = world.active_blob_array[0]->get_state_index();
+        if (after != before)
+        {
+            // The first dwell started partway through one, so it isn't counted
+            if (last_switch >= 0 && before < 2)
+            {
+                dwell_sum[before] += step - last_switch;
+                num_dwells[before]++;
+            }
+            last_switch = step;
+        }
+        steps_in_state[after]++;
+    }
+
+    if (steps_in_state[2] != 0)
+    {
+        std::cout << "Fail. Blob switched to a state it has no rate of reaching.\n";
+        return 1;
+    }
+    for (int s = 0; s < 2; s++)
+    {
+        const scalar dwell = dwell_sum[s] / num_dwells[s];
+        std::cout << "state " << s << ": " << num_dwells[s] << " dwells, mean " << dwell << " steps (expected " << expected_dwell[s] << ")\n";
+        if (std::fabs(dwell - expected_dwell[s]) > tol * expected_dwell[s])
+        {
+            std::cout << "Fail. Mean dwell time does not match the switching rate.\n";
+            return 1;
+        }
+    }
+    const scalar occupancy = static_cast<scalar>(steps_in_state[0]) / num_steps;
+    std::cout << "state 0 occupancy " << occupancy << " (expected " << expected_occupancy << ")\n";
+    if (std::fabs(occupancy - expected_occupancy) > tol * expected_occupancy)
+    {
+        std::cout << "Fail. State occupancy does not match the switching rates.\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int ffea_test::binding_site_hash()
+{
+    // Scatter binding sites of mixed sizes and types over several blobs, and check that for every
+    // site and target type the spatial hash finds the same first site in range as the exhaustive
+    // search over the other blobs' sites, in blob then site order, with BindingSite::sites_in_range
+    const int num_blobs = 5, sites_per_blob = 40, num_types = 3;
+    const scalar box = 8;
+
+    std::mt19937 gen(2468);
+    std::uniform_real_distribution<scalar> unif(0, 1);
+    std::uniform_int_distribution<int> num_faces_dist(1, 3), type_dist(0, num_types - 1);
+
+    // Each face is a small triangle of its own nodes, near the centre of its site
+    const int max_faces = num_blobs * sites_per_blob * 3;
+    std::vector<mesh_node> node(3 * max_faces);
+    std::vector<Face> face(max_faces);
+    std::vector<std::vector<BindingSite>> site(num_blobs, std::vector<BindingSite>(sites_per_blob));
+    int f = 0;
+    for (int b = 0; b < num_blobs; b++)
+    {
+        for (BindingSite &s : site[b])
+        {
+            arr3 centre = {box * unif(gen), box * unif(gen), box * unif(gen)};
+            scalar size = 0.2 + 2 * unif(gen);
+            int num_faces = num_faces_dist(gen);
+            s.set_type(type_dist(gen));
+            s.set_num_faces(num_faces);
+            for (int k = 0; k < num_faces; k++, f++)
+            {
+                for (int v = 0; v < 3; v++)
+                {
+                    for (int j = 0; j < 3; j++)
+                        node[3 * f + v].pos[j] = centre[j] + size * (unif(gen) - 0.5);
+                    face[f].n[v] = &node[3 * f + v];
+                }
+                s.add_face(&face[f]);
+            }
+        }
+    }
+
+    BindingSite_hash hash;
+    for (int b = 0; b < num_blobs; b++)
+    {
+        for (BindingSite &s : site[b])
+            hash.add_site(b, &s);
+    }
+    hash.build(num_blobs);
+
+    int num_checked = 0, num_found = 0;
+    for (int b = 0; b < num_blobs; b++)
+    {
+        for (int i = 0; i < sites_per_blob; i++)
+        {
+            for (int t = 0; t < num_types; t++)
+            {
+                BindingSite *expected = nullptr;
+                for (int ob = 0; ob < num_blobs && expected == nullptr; ob++)
+                {
+                    if (ob == b)
+                        continue;
+                    for (BindingSite &target : site[ob])
+                    {
+                        if (target.get_type() == t && BindingSite::sites_in_range(site[b][i], target))
+                        {
+                            expected = &target;
+                            break;
+                        }
+                    }
+                }
+
+                int entry = hash.find_first_in_range(b, i, t);
+                BindingSite *found = entry == -1 ? nullptr : hash.get_site(entry);
+                if (found != expected)
+                {
+                    std::cout << "Fail. Blob " << b << " site " << i << ", type " << t << ": the hash and the exhaustive search disagree.\n";
+                    return 1;
+                }
+                num_checked++;
+                if (found != nullptr)
+                    num_found++;
+            }
+        }
+    }
+
+    std::cout << num_checked << " searches, " << num_found << " with a site in range, all matching the exhaustive search\n";
+    if (num_found == 0 || num_found == num_checked)
+    {
+        std::cout << "Fail. The test sites should be neither all in nor all out of range.\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int ffea_test::rod_binary_trajectory()
+{
+    // Write a few frames of a binary rod trajectory for two rods, then restart from it the way
+    // World::init does with --delete-frames, and check that the rods are loaded from the last
+    // frame kept and that the frames written after the restart replace the deleted ones
+    const int num_rods = 2, num_frames = 5, frames_to_delete = 2;
+    const std::string rod_fname = "twisted_bent_rod.rod";
+    const std::string traj_fname = "rod_binary_trajectory.rodbin";
+    const float tol = 1e-5;
+
+    // Every step moves the nodes and material frames of each rod by a different amount
+    auto frame_value = [](const std::vector<float> &equil, int rod_no, int step, int j) {
+        return equil[j] + 0.01f * step * (rod_no + 1) * ((j % 3) + 1);
+    };
+    auto set_frame = [&](World &world, int step) {
+        for (int r = 0; r < num_rods; r++)
+        {
+            rod::Rod *rod = world.rod_array[r];
+            for (int j = 0; j < rod->length; j++)
+            {
+                rod->current_r[j] = frame_value(rod->equil_r, r, step, j);
+                rod->current_m[j] = frame_value(rod->equil_m, r, step, j);
+            }
+        }
+    };
+    auto check_frame = [&](World &world, int step) {
+        for (int r = 0; r < num_rods; r++)
+        {
+            rod::Rod *rod = world.rod_array[r];
+            for (int j = 0; j < rod->length; j++)
+            {
+                float r_expected = frame_value(rod->equil_r, r, step, j);
+                float m_expected = frame_value(rod->equil_m, r, step, j);
+                if (std::fabs(rod->current_r[j] - r_expected) > tol * std::fabs(r_expected) ||
+                    std::fabs(rod->current_m[j] - m_expected) > tol * std::fabs(m_expected))
+                {
+                    std::cout << "Fail. Rod " << r << " entry " << j << " was not loaded from step " << step << ".\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    std::remove(traj_fname.c_str());
+    World world = World();
+    world.params.num_rods = num_rods;
+    world.params.rod_traj_format = "binary";
+    world.params.rod_traj_out_fname = traj_fname;
+    world.params.rod_traj_diagnostics = 0;
+    world.rod_array = new rod::Rod *[num_rods];
+    for (int r = 0; r < num_rods; r++)
+    {
+        std::string rodtraj_fname = "rod_binary_trajectory_" + std::to_string(r) + ".rodtraj";
+        std::remove(rodtraj_fname.c_str());
+        world.rod_array[r] = new rod::Rod(rod_fname, r);
+        world.rod_array[r]->load_header(rod_fname);
+        world.rod_array[r]->load_contents(rod_fname);
+        world.rod_array[r]->set_units();
+        world.rod_array[r]->change_filename(rodtraj_fname);
+    }
+
+    world.open_rod_binary_trajectory();
+    for (int step = 1; step <= num_frames; step++)
+    {
+        set_frame(world, step);
+        world.write_rod_binary_frame(step);
+    }
+    fclose(world.rod_traj_out);
+    world.rod_traj_out = nullptr;
+    std::ifstream full_file(traj_fname, std::ios::binary | std::ios::ate);
+    const long full_size = full_file.tellg();
+    full_file.close();
+
+    // Restart, deleting the last frames
+    for (int r = 0; r < num_rods; r++)
+    {
+        world.rod_array[r]->restarting = true;
+        std::fill(world.rod_array[r]->current_r.begin(), world.rod_array[r]->current_r.end(), 0);
+        std::fill(world.rod_array[r]->current_m.begin(), world.rod_array[r]->current_m.end(), 0);
+    }
+    world.load_rod_binary_trajectory(frames_to_delete);
+    if (!check_frame(world, num_frames - frames_to_delete))
+        return 1;
+    const long kept_size = world.rod_traj_restart_size;
+
+    // Carry on one frame further than before, then restart again without deleting any
+    world.open_rod_binary_trajectory();
+    for (int step = num_frames - frames_to_delete + 1; step <= num_frames + 1; step++)
+    {
+        set_frame(world, step);
+        world.write_rod_binary_frame(step);
+    }
+    fclose(world.rod_traj_out);
+    world.rod_traj_out = nullptr;
+
+    set_frame(world, 0);
+    world.load_rod_binary_trajectory(0);
+    if (!check_frame(world, num_frames + 1))
+        return 1;
+
+    // Without the cut, the file would have grown by the frames_to_delete + 1 frames written since
+    std::ifstream final_file(traj_fname, std::ios::binary | std::ios::ate);
+    const long final_size = final_file.tellg();
+    const long frame_size = final_size - full_size;
+    if (frame_size <= 0 || full_size - kept_size != frames_to_delete * frame_size ||
+        final_size != world.rod_traj_restart_size)
+    {
+        std::cout << "Fail. The deleted frames were not cut from " << traj_fname << ".\n";
+        return 1;
+    }
+
+    std::cout << "Rods restarted from step " << num_frames - frames_to_delete << " of " << num_frames << ", then from step " << num_frames + 1 << ".\n";
+    return 0;
+}
@@ -50,7 +50,6 @@ void mesh_node::set_pos(scalar x, scalar y, scalar z) {
 
 void mesh_node::print() {
     printf("pos: %e %e %e\n", pos[0], pos[1], pos[2]);
-    printf("vel: %e %e %e\n", vel[0], vel[1], vel[2]);
 }
 
 void mesh_node::set_linear() {
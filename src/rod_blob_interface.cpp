@@ -597,6 +597,96 @@ void get_attachment_node_pos(const float3 &face_node_1, const float3 &face_node_
     }
 }
 
+/**
+ Normalise one lane of a batch of 3-d vectors. Like rod::normalize, a
+ vector with no length comes out as zero, but the check is a comparison
+ rather than a NaN test, so there is no branch in the loop calling it.
+*/
+static inline void normalize_lane(float in_x, float in_y, float in_z, OUT float &out_x, float &out_y, float &out_z){
+    const float absolute = sqrt(in_x*in_x + in_y*in_y + in_z*in_z);
+    const bool valid = absolute > 0;
+    out_x = valid ? in_x/absolute : 0;
+    out_y = valid ? in_y/absolute : 0;
+    out_z = valid ? in_z/absolute : 0;
+}
+
+/**
+ Batched equivalent of get_gradient_deformation followed by
+ QR_decompose_gram_schmidt. J holds the Jacobian of each deformed
+ tetrahedron and Q receives the corresponding rotation, both stored one
+ matrix element per row, so the loop over the tetrahedra has unit stride
+ and no branches, and is left to the auto-vectoriser. It is deliberately
+ not forced with omp simd: under -ffast-math the SIMD square roots and
+ divisions become reciprocal approximations, and the attachment is
+ sensitive enough to the rotation for that to change trajectories.
+*/
+void get_tet_rotation_batch(const float9 &J_inv_0, const std::array<std::array<float, Tet_rotation_batch::num_perturbations>, 9> &J, OUT std::array<std::array<float, Tet_rotation_batch::num_perturbations>, 9> &Q){
+    for (int k=0; k<Tet_rotation_batch::num_perturbations; k++){
+        // columns of the gradient deformation matrix, (J' J^-1)^T
+        float a[3][3];
+        for (int r=0; r<3; r++){
+            for (int c=0; c<3; c++){
+                a[r][c] = J[r][k]*J_inv_0[3*c] + J[r+3][k]*J_inv_0[3*c+1] + J[r+6][k]*J_inv_0[3*c+2];
+            }
+        }
+        float e1[3];
+        float e2[3];
+        float e3[3];
+        normalize_lane(a[0][0], a[0][1], a[0][2], e1[0], e1[1], e1[2]);
+        const float a2_dot_e1 = a[1][0]*e1[0] + a[1][1]*e1[1] + a[1][2]*e1[2];
+        normalize_lane(a[1][0] - a2_dot_e1*e1[0], a[1][1] - a2_dot_e1*e1[1], a[1][2] - a2_dot_e1*e1[2], e2[0], e2[1], e2[2]);
+        const float a3_dot_e1 = a[2][0]*e1[0] + a[2][1]*e1[1] + a[2][2]*e1[2];
+        const float a3_dot_e2 = a[2][0]*e2[0] + a[2][1]*e2[1] + a[2][2]*e2[2];
+        normalize_lane(a[2][0] - a3_dot_e1*e1[0] - a3_dot_e2*e2[0], a[2][1] - a3_dot_e1*e1[1] - a3_dot_e2*e2[1], a[2][2] - a3_dot_e1*e1[2] - a3_dot_e2*e2[2], e3[0], e3[1], e3[2]);
+        for (int n=0; n<3; n++){
+            Q[n][k] = e1[n];
+            Q[n+3][k] = e2[n];
+            Q[n+6][k] = e3[n];
+        }
+    }
+}
+
+/**
+ Build the batch from the positions of the four linear nodes of the
+ tetrahedron. displacement and J_inv_0 need to be set first. The nodes are
+ perturbed one axis at a time in a scratch copy, in the same order (and
+ with the same rounding) as get_node_energy used to move the real nodes,
+ and the rotations for all of the perturbations are then found together.
+*/
+void Tet_rotation_batch::build(const std::array<arr3, NUM_NODES_LINEAR_TET> &tet_pos){
+    std::array<arr3, NUM_NODES_LINEAR_TET> pos = tet_pos;
+    for (int node=0; node<NUM_NODES_LINEAR_TET; node++){
+        for (int i=0; i<6; i++){
+            const int k = node*6 + i;
+            const int displacement_sign = i<3 ? 1 : -1;
+            const int displacement_index = i<3 ? i : i-3;
+            pos[node][displacement_index] += (displacement_sign*(this->displacement));
+            this->perturbed_pos[k] = pos;
+            for (int e=0; e<3; e++){
+                vec3d(n){this->J[e*3+n][k] = pos[e+1][n] - pos[0][n];}
+            }
+            pos[node][displacement_index] += (displacement_sign*this->displacement*-1);
+        }
+    }
+    get_tet_rotation_batch(this->J_inv_0, this->J, this->Q);
+}
+
+void Tet_rotation_batch::build(const tetra_element_linear *tet){
+    std::array<arr3, NUM_NODES_LINEAR_TET> tet_pos;
+    for (int i=0; i<NUM_NODES_LINEAR_TET; i++){
+        vec3d(n){tet_pos[i][n] = tet->n[i]->pos[n];}
+    }
+    this->build(tet_pos);
+}
+
+/**
+ Copy out the rotation for one perturbation (index node*6 + axis, where the
+ axes go +x, +y, +z, -x, -y, -z).
+*/
+void Tet_rotation_batch::get_rotation(int perturbation, OUT float9 &rotation) const {
+    for (int i=0; i<9; i++){rotation[i] = this->Q[i][perturbation];}
+}
+
 // interface structure
 
 /**
@@ -979,6 +1069,34 @@ void Rod_blob_interface::get_attachment_node_pos(float3 &attachment_node_pos, bo
 
 }
 
+/**
+ Same as above, but for a tetrahedron given by the positions of its linear
+ nodes (e.g. a perturbed copy from a Tet_rotation_batch) rather than the
+ internal one. The edge vectors are worked out locally, so this does not
+ change the state of the interface.
+*/
+void Rod_blob_interface::get_attachment_node_pos(const std::array<arr3, NUM_NODES_LINEAR_TET> &tet_pos, OUT float3 &attachment_node_pos){
+    float3 origin;
+    float3x3 edges;
+    vec3d(v){origin[v] = tet_pos[0][v];}
+    vec3d(v){edges[0][v] = tet_pos[1][v] - origin[v];}
+    vec3d(v){edges[1][v] = tet_pos[2][v] - origin[v];}
+    vec3d(v){edges[2][v] = tet_pos[3][v] - origin[v];}
+    
+    if (this->node_weighting[0] == -1 && this->node_weighting[1] == -1 && this->node_weighting[2] == -1){
+        float3 face_node_1;
+        float3 face_node_2;
+        float3 face_node_3;
+        vec3d(n){face_node_1[n] = tet_pos[this->face_node_indices[0]][n];}
+        vec3d(n){face_node_2[n] = tet_pos[this->face_node_indices[1]][n];}
+        vec3d(n){face_node_3[n] = tet_pos[this->face_node_indices[2]][n];}
+        vec3d(n){attachment_node_pos[n] = 1./3. * (face_node_1[n] + face_node_2[n] + face_node_3[n]);}
+    }
+    else{
+        vec3d(n){attachment_node_pos[n] = origin[n] + (edges[0][n]*this->node_weighting[0] + edges[1][n]*this->node_weighting[1] + edges[2][n]*this->node_weighting[2]);}
+    }
+}
+
 // need to call this AFTER getting the attachment node
 /**
  Once the attachment node has been obtained, this sets the initial direction of the attachment material axis.
@@ -1297,6 +1415,8 @@ int Rod_blob_interface::get_element_id(const int3 &nodes){
   - attachment_material_axis - same, but material axis
   - displacement - how much the node is being moved. I would suggest this->connected_rod->perturbation_amount
   - energy - this is the output listing the energy associated with that perturbation in the following axes: [+x +y +z -x -y -z].
+ The perturbed tetrahedra are built from the current internal tetrahedron,
+ which is left as it is.
 */
 void Rod_blob_interface::get_node_energy(
     int node_index,
@@ -1305,8 +1425,35 @@ void Rod_blob_interface::get_node_energy(
     float3 &attachment_node,
     float3 &attachment_material_axis,
     float displacement,
+    float6 &energy){
+    
+    Tet_rotation_batch batch;
+    batch.tet = this->connected_tet;
+    batch.displacement = displacement;
+    batch.J_inv_0 = this->J_inv_0;
+    std::array<arr3, NUM_NODES_LINEAR_TET> tet_pos;
+    for (int i=0; i<NUM_NODES_LINEAR_TET; i++){
+        vec3d(n){tet_pos[i][n] = this->deformed_tet_nodes[i]->pos[n];}
+    }
+    batch.build(tet_pos);
+    this->get_node_energy(node_index, batch, attachment_node_equil, attachment_material_axis_equil, attachment_node, attachment_material_axis, energy);
+}
+
+/**
+ As above, but the rotations of the perturbed tetrahedra are taken from a
+ batch that has already been built (see Tet_rotation_batch), and the
+ displacement is the one the batch was built with.
+*/
+void Rod_blob_interface::get_node_energy(
+    int node_index,
+    const Tet_rotation_batch &batch,
+    float3 &attachment_node_equil,
+    float3 &attachment_material_axis_equil,
+    float3 &attachment_node,
+    float3 &attachment_material_axis,
     float6 &energy){ //int direction, float equil_energy, bool use_equil_energy){
     
+    const float displacement = batch.displacement;
     float3 attachment_node_pos;
     float3 attachment_n;
     float3 attachment_n_equil;
@@ -1434,21 +1581,15 @@ void Rod_blob_interface::get_node_energy(
         
         if(dbg_print){std::cout << " ...with displacement " << displacement << " in axis " << displacement_index << " with sign " << displacement_sign << "\n";}
         
-        // apply displacement to tetrahedron
-        this->deformed_tet_nodes[node_index]->pos[displacement_index] += (displacement_sign*(displacement));
-        
-        // get actual attachment node
-        this->reorientate_connection(attachment_node_equil, attachment_material_axis_equil, attachment_node, attachment_material_axis);
+        // get actual attachment node, from the rotation of the displaced tetrahedron
+        const int perturbation = node_index*6 + i;
+        const std::array<arr3, NUM_NODES_LINEAR_TET> &perturbed_tet = batch.perturbed_pos[perturbation];
+        float9 Q;
+        batch.get_rotation(perturbation, Q);
+        apply_rotation_matrix(attachment_node_equil, Q, attachment_node);
+        apply_rotation_matrix(attachment_material_axis_equil, Q, attachment_material_axis);
                 
-        float3 facevec;
-        // Below line is the original code, which appears wrong as data-data was pointer arithmetic
-        //vec3d(n){facevec[n] = deformed_tet_nodes[this->face_node_indices[0]][n].pos.data -  deformed_tet_nodes[this->face_node_indices[1]][n].pos.data;}
-        // This version seems right, but regardless it's not used
-        vec3d(n) { facevec[n] = deformed_tet_nodes[this->face_node_indices[0]][n].pos[n] -  deformed_tet_nodes[this->face_node_indices[1]][n].pos[n]; }
-        normalize(facevec, facevec);
-        //float edge_attachment_dotprod = dot(facevec, attachment_node);
-                
-        this->get_attachment_node_pos(attachment_node_pos, false);
+        this->get_attachment_node_pos(perturbed_tet, attachment_node_pos);
         
         this->position_rod_ends(attachment_node_pos);
         
@@ -1485,10 +1626,10 @@ void Rod_blob_interface::get_node_energy(
         rescale_attachment_node(attachment_node, p[0], attachment_node_equil, p_equil[0], attachment_node, attachment_node_equil);
         
         if(dbg_print) {
-            print_array(" deformed tetrahedron node 0", this->deformed_tet_nodes[0]->pos);
-            print_array(" deformed tetrahedron node 1", this->deformed_tet_nodes[1]->pos);
-            print_array(" deformed tetrahedron node 2", this->deformed_tet_nodes[2]->pos);
-            print_array(" deformed tetrahedron node 3", this->deformed_tet_nodes[3]->pos);
+            print_array(" deformed tetrahedron node 0", perturbed_tet[0]);
+            print_array(" deformed tetrahedron node 1", perturbed_tet[1]);
+            print_array(" deformed tetrahedron node 2", perturbed_tet[2]);
+            print_array(" deformed tetrahedron node 3", perturbed_tet[3]);
             print_array(" attachment_node", attachment_node);
             print_array(" attachment_node_pos", attachment_node_pos);
             print_array(" attachment_material_axis", attachment_material_axis);
@@ -1515,8 +1656,6 @@ void Rod_blob_interface::get_node_energy(
         normalize(attachment_node, attachment_node);
         normalize(attachment_node_equil, attachment_node_equil);
 
-        // un-apply displacement to tetrahedron
-        this->deformed_tet_nodes[node_index]->pos[displacement_index] += (displacement_sign*displacement*-1);
         this->position_rod_ends(attachment_node_pos);
         
     }
@@ -1570,25 +1709,67 @@ void Rod_blob_interface::position_rod_ends(float3 &attachment_node_pos){
 */
 void Rod_blob_interface::do_connection_timestep(){ // run this after regular blob\rod dynamics
     
+    Tet_rotation_batch batch;
+    batch.tet = this->connected_tet;
+    batch.displacement = this->get_dynamics_displacement();
+    batch.J_inv_0 = this->J_inv_0;
+    batch.build(this->connected_tet);
+    
+    std::array<arr3, NUM_NODES_LINEAR_TET> forces;
+    this->begin_connection_timestep();
+    this->get_connection_forces(batch, forces);
+    this->apply_connection_forces(forces);
+    
+}
+
+/**
+ How far each tetrahedron node is moved in either direction to get the
+ interface forces. Tet_rotation_batch objects used by this interface need
+ to be built with this displacement.
+*/
+float Rod_blob_interface::get_dynamics_displacement(){
+    return this->connected_rod->perturbation_amount*0.5;
+}
+
+/**
+ Step 1 of do_connection_timestep. This only changes the interface and the
+ end of its rod, so interfaces on different rods can run it concurrently.
+*/
+void Rod_blob_interface::begin_connection_timestep(){
     this->reorientate_connection(this->attachment_node, this->attachment_m, this->attachment_node, this->attachment_m);
     this->update_internal_state(true, true);
     this->get_attachment_node_pos(this->attachment_node_pos, false);
     this->position_rod_ends(attachment_node_pos);
+}
+
+/**
+ Step 2 of do_connection_timestep. Get the force on each tetrahedron node
+ without applying it to the blob, using a batch built from the current
+ tetrahedron. As above, this is safe to run concurrently for interfaces on
+ different rods.
+*/
+void Rod_blob_interface::get_connection_forces(const Tet_rotation_batch &batch, OUT std::array<arr3, NUM_NODES_LINEAR_TET> &forces){
     float dynamics_displacement = this->connected_rod->perturbation_amount;
     
     // For each tetrahedron node:
     for(int i=0; i<4; i++){
         float6 curr_node_energy = {0,0,0,0,0,0};
-        get_node_energy(i, this->attachment_node_equil, this->attachment_m_equil, this->attachment_node, this->attachment_m, dynamics_displacement*0.5, curr_node_energy)   ; 
-        arr3 force;
-        vec3d(n){force[n] = (curr_node_energy[n+3] - curr_node_energy[n])/dynamics_displacement;}
-        if(dbg_print){print_array("Force added to node: ", force);}
-        //std::cout << "Interface " << this->order << " node " << i << " force: [" << force.data[0] << ", " << force.data[1] << ", " << force.data[2] << "]\n"; //DEBUGGO
-        this->connected_blob->add_force_to_node(force, this->connected_tet->n[i]->index);
+        get_node_energy(i, batch, this->attachment_node_equil, this->attachment_m_equil, this->attachment_node, this->attachment_m, curr_node_energy);
+        vec3d(n){forces[i][n] = (curr_node_energy[n+3] - curr_node_energy[n])/dynamics_displacement;}
+        if(dbg_print){print_array("Force added to node: ", forces[i]);}
+    }
+}
+
+/**
+ Step 3 of do_connection_timestep. Add the forces to the blob and update
+ the internal tetrahedron. This writes to the blob, so it should be run
+ for one interface at a time.
+*/
+void Rod_blob_interface::apply_connection_forces(const std::array<arr3, NUM_NODES_LINEAR_TET> &forces){
+    for(int i=0; i<4; i++){
+        this->connected_blob->add_force_to_node(forces[i], this->connected_tet->n[i]->index);
     }
-    
     this->update_internal_state(true, true);
-    
 }
 
 }
@@ -29,6 +29,8 @@
 
 #include "rod_interactions.h"
 
+#include <algorithm>
+
 #include "FFEA_return_codes.h"
 #include "mat_vec_fns_II.h"
 
@@ -116,6 +118,186 @@ bool InteractionData::elements_intersect() const {
         return false;
 }
 
+/*
+================================================================================
+    NEIGHBOUR SEARCH
+================================================================================
+*/
+
+void NbrList::resize(int num_elements)
+{
+    start.resize(num_elements + 1);
+    this->clear();
+}
+
+void NbrList::clear()
+{
+    added.clear();
+    data.clear();
+    std::fill(start.begin(), start.end(), 0);
+}
+
+/*
+Counting sort of the interactions by the element they belong to. Calling
+this again after adding more interactions regroups all of them.
+*/
+void NbrList::group()
+{
+    std::fill(start.begin(), start.end(), 0);
+    for (const InteractionData &interaction : added)
+        start.at(interaction.elem_id_self + 1)++;
+    for (int e = 0; e < this->num_elements(); e++)
+        start[e + 1] += start[e];
+
+    fill.assign(start.begin(), start.end() - 1);
+    data = added;
+    for (const InteractionData &interaction : added)
+        data[fill[interaction.elem_id_self]++] = interaction;
+}
+
+bool NbrCellList::update(const std::vector<NbrSphere> &spheres, bool periodic, const std::vector<float> &box_dim)
+{
+    bool rebuild = spheres.size() != built.size();
+    float max_shift = 0.5 * skin;
+
+    for (int k = 0; k < (int)spheres.size() && !rebuild; k++)
+    {
+        float3 disp;
+        vec3d(n) { disp[n] = spheres[k].centre[n] - built[k].centre[n]; }
+        if (periodic)
+        {
+            vec3d(n) { disp[n] -= box_dim[n] * std::floor((disp[n] + 0.5 * box_dim[n]) / box_dim[n]); }
+        }
+        float growth = std::max(spheres[k].radius - built[k].radius, 0.0f);
+        rebuild = rod::absolute(disp) + growth > max_shift;
+    }
+
+    if (rebuild)
+        this->build(spheres, periodic, box_dim);
+
+    return rebuild;
+}
+
+/*
+The cells are at least as wide as the largest sphere diameter plus the skin,
+so that the candidates of a sphere are all in its own or the adjacent cells.
+If the spheres are spread out, the cells are made larger to keep their number
+down to a few per sphere.
+*/
+void NbrCellList::build(const std::vector<NbrSphere> &spheres, bool periodic, const std::vector<float> &box_dim)
+{
+    int num_spheres = spheres.size();
+    built = spheres;
+    pairs.clear();
+    num_builds++;
+
+    if (num_spheres == 0)
+        return;
+
+    float max_radius = 0;
+    float3 lo = spheres[0].centre;
+    float3 hi = spheres[0].centre;
+    for (const NbrSphere &sphere : spheres)
+    {
+        max_radius = std::max(max_radius, sphere.radius);
+        vec3d(n) { lo[n] = std::min(lo[n], sphere.centre[n]); }
+        vec3d(n) { hi[n] = std::max(hi[n], sphere.centre[n]); }
+    }
+    skin = skin_fraction * max_radius;
+
+    float cell_size = 2 * max_radius + skin;
+    std::array<int, 3> num_cells;
+    float3 cell_width;
+    while (true)
+    {
+        vec3d(n)
+        {
+            float extent = periodic ? box_dim[n] : hi[n] - lo[n];
+            num_cells[n] = std::max(1, (int)std::floor(extent / cell_size));
+            cell_width[n] = periodic ? box_dim[n] / num_cells[n] : cell_size;
+        }
+        if ((long long)num_cells[0] * num_cells[1] * num_cells[2] <= 2 * (long long)num_spheres + 8)
+            break;
+        cell_size *= 2;
+    }
+    int total_cells = num_cells[0] * num_cells[1] * num_cells[2];
+
+    // Sort the spheres into the cells
+    auto cell_coord = [&](const NbrSphere &sphere, int n) {
+        float x = sphere.centre[n];
+        if (periodic)
+            x -= box_dim[n] * std::floor(x / box_dim[n]);
+        else
+            x -= lo[n];
+        return std::min(std::max((int)(x / cell_width[n]), 0), num_cells[n] - 1);
+    };
+
+    cell_start.assign(total_cells + 1, 0);
+    sphere_cell.resize(num_spheres);
+    for (int k = 0; k < num_spheres; k++)
+    {
+        sphere_cell[k] = (cell_coord(spheres[k], 2) * num_cells[1] + cell_coord(spheres[k], 1)) * num_cells[0] + cell_coord(spheres[k], 0);
+        cell_start[sphere_cell[k] + 1]++;
+    }
+    for (int c = 0; c < total_cells; c++)
+        cell_start[c + 1] += cell_start[c];
+    std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+    cell_spheres.resize(num_spheres);
+    for (int k = 0; k < num_spheres; k++)
+        cell_spheres[fill[sphere_cell[k]]++] = k;
+
+    // Periodic cells wrap around, but a cell must not be visited twice
+    std::array<int, 3> offset_min;
+    std::array<int, 3> offset_max;
+    vec3d(n)
+    {
+        offset_min[n] = (periodic && num_cells[n] < 3) ? 0 : -1;
+        offset_max[n] = (periodic && num_cells[n] < 2) ? 0 : 1;
+    }
+
+    for (int a = 0; a < num_spheres; a++)
+    {
+        std::array<int, 3> cell_a = {sphere_cell[a] % num_cells[0], (sphere_cell[a] / num_cells[0]) % num_cells[1], sphere_cell[a] / (num_cells[0] * num_cells[1])};
+
+        for (int dz = offset_min[2]; dz <= offset_max[2]; dz++)
+        for (int dy = offset_min[1]; dy <= offset_max[1]; dy++)
+        for (int dx = offset_min[0]; dx <= offset_max[0]; dx++)
+        {
+            std::array<int, 3> cell_b = {cell_a[0] + dx, cell_a[1] + dy, cell_a[2] + dz};
+            bool outside = false;
+            vec3d(n)
+            {
+                if (periodic)
+                    cell_b[n] = (cell_b[n] + num_cells[n]) % num_cells[n];
+                else if (cell_b[n] < 0 || cell_b[n] >= num_cells[n])
+                    outside = true;
+            }
+            if (outside)
+                continue;
+
+            int c = (cell_b[2] * num_cells[1] + cell_b[1]) * num_cells[0] + cell_b[0];
+            for (int j = cell_start[c]; j < cell_start[c + 1]; j++)
+            {
+                int b = cell_spheres[j];
+                if (b <= a || spheres[b].rod_id == spheres[a].rod_id)
+                    continue;
+
+                float3 disp;
+                vec3d(n) { disp[n] = spheres[b].centre[n] - spheres[a].centre[n]; }
+                if (periodic)
+                {
+                    vec3d(n) { disp[n] -= box_dim[n] * std::floor((disp[n] + 0.5 * box_dim[n]) / box_dim[n]); }
+                }
+                float reach = spheres[a].radius + spheres[b].radius + skin;
+                if (disp[0] * disp[0] + disp[1] * disp[1] + disp[2] * disp[2] < reach * reach)
+                    pairs.push_back({a, b});
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+}
+
 /*
 ================================================================================
     STERIC INTERACTIONS
@@ -344,8 +526,8 @@ lists.
 */
 void set_steric_nbrs(int rod_id_a, int rod_id_b, int elem_id_a,
     int elem_id_b, const float3 &p_a, const float3 &p_b, float3 &r_a, float3 &r_b,
-    float radius_a, float radius_b, std::vector<InteractionData> &neighbours_a,
-    std::vector<InteractionData> &neighbours_b, bool periodic, const std::vector<float> &box_dim)
+    float radius_a, float radius_b, NbrList &neighbours_a,
+    NbrList &neighbours_b, bool periodic, const std::vector<float> &box_dim)
 {
     float3  mid_a = {0};
     float3  mid_b = {0};
@@ -418,7 +600,7 @@ void set_steric_nbrs(int rod_id_a, int rod_id_b, int elem_id_a,
                 shift,
                 r_a,
                 r_b);
-            neighbours_a.push_back(stericDataA);
+            neighbours_a.add(stericDataA);
 
             InteractionData stericDataB(
                 rod_id_b,
@@ -432,7 +614,7 @@ void set_steric_nbrs(int rod_id_a, int rod_id_b, int elem_id_a,
                 shift,
                 r_b,
                 r_a);
-            neighbours_b.push_back(stericDataB);
+            neighbours_b.add(stericDataB);
         }
         else if (rod::absolute(c_ab) <= 1e-5)
         {
@@ -479,7 +661,7 @@ float intersection_distance(const float3 &c_a, const float3 &c_b, float radius_s
 
 // Return the steric collision energy of a rod element as a vector with the
 // format [r+dr, r-dr, r]. Perturbation is applied along the intersection vector.
-std::vector<float> element_steric_energy(float delta, float force_constant,
+float3 element_steric_energy(float delta, float force_constant,
     float radius_sum, const float3 &c_a, const float3 &c_b)
 {
     float3 dist = {0};
@@ -519,19 +701,19 @@ std::vector<float> element_steric_energy(float delta, float force_constant,
         }
     }
 
-    return std::vector<float> {energy[0], energy[1], energy[2]};
+    return energy;
 }
 
 // Interpolate the force applied to an element onto both nodes
-std::vector<float> node_force_interpolation(
+float6 node_force_interpolation(
     const float3 &contact,
     const float3 &node_start,
-    float element_length, const std::vector<float> &element_force)
+    float element_length, const float3 &element_force)
 {
     float3 displacement = { 0 };
     float l1 = 0;
     float l2 = 0;
-    std::vector<float> force(6, 0);  // x0, y0, z0, x1, y1, z1
+    float6 force = { 0 };  // x0, y0, z0, x1, y1, z1
 
     vec3d(n) { displacement[n] = contact[n] - node_start[n]; }
 
@@ -547,14 +729,14 @@ std::vector<float> node_force_interpolation(
         print_array("  contact", contact);
         print_array("  node_start", node_start);
         std::cout << "  element_length, L : " << element_length << "\n";
-        print_vector("  element_force", element_force);
+        print_array("  element_force", element_force);
         print_array("  displacement", displacement);
         std::cout << "  l1 : " << l1 << "\n";
         std::cout << "  l2 : " << l2 << "\n";
         std::cout << "  weight start node : " << (element_length - l1) / element_length << "\n";
         std::cout << "  weight end node : " << (element_length - l2) / element_length << "\n";
-        print_vector("  force start node", std::vector<float>(force.begin(), std::next(force.begin(), 3)) );
-        print_vector("  force end node", std::vector<float>(std::next(force.begin(), 3), force.end()) );
+        print_array("  force start node", float3 {force[0], force[1], force[2]});
+        print_array("  force end node", float3 {force[3], force[4], force[5]});
         std::cout << "\n";
     }
 
@@ -688,10 +870,10 @@ void VDWSite::get_parent_element(const std::vector<float> &r_rod, const float co
 }
 
 
-void set_vdw_nbrs(const VDWSite site_a, const VDWSite site_b, const float3 &p_a, const float3 &p_b,
+void set_vdw_nbrs(const VDWSite &site_a, const VDWSite &site_b, const float3 &p_a, const float3 &p_b,
     const float3 &r_a, const float3 &r_b, float radius_a, float radius_b,
-    std::vector<InteractionData>& nbr_a, std::vector<InteractionData>& nbr_b,
-    bool periodic, std::vector<float> box_dim, float vdw_cutoff,
+    NbrList &nbr_a, NbrList &nbr_b,
+    bool periodic, const std::vector<float> &box_dim, float vdw_cutoff,
     float epsilon, float sigma)
 {
     float3 c_a = { 0 };
@@ -744,7 +926,7 @@ void set_vdw_nbrs(const VDWSite site_a, const VDWSite site_b, const float3 &p_a,
             r_b,
             epsilon,
             sigma);
-        nbr_a.push_back(vdwDataA);
+        nbr_a.add(vdwDataA);
 
         InteractionData vdwDataB(
             site_b.rod_id,
@@ -760,7 +942,7 @@ void set_vdw_nbrs(const VDWSite site_a, const VDWSite site_b, const float3 &p_a,
             r_a,
             epsilon,
             sigma);
-        nbr_b.push_back(vdwDataB);
+        nbr_b.add(vdwDataB);
     }
     else if (rod::dbg_print && mag - radius_sum >= vdw_cutoff)
     {
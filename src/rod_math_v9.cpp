@@ -63,6 +63,16 @@ namespace rod
     bool isnan(float x) { return x != x; }
     bool isinf(float x) { return !isnan(x) && isnan(x - x); }
 
+    /** The value of a scalar, without its derivatives (see get_energy_gradient) */
+    inline float value(float v) { return v; }
+
+    /** An equilibrium vector, as the scalar type S */
+    template <typename S>
+    vec3<S> promote(const float3 &a)
+    {
+        return {a[0], a[1], a[2]};
+    }
+
     /**
  Check if a single value is simulation destroying. Here, simulation
  destroying means NaN or infinite.
@@ -206,6 +216,13 @@ namespace rod
             std::fprintf(file_ptr, "\n");
     }
 
+    // Binary equivalent of write_vector, for output that is written in one go
+    void append_vector(std::vector<float> &buffer, const std::vector<float> &vec, float unit_scale_factor)
+    {
+        for (float value : vec)
+            buffer.push_back(value * unit_scale_factor);
+    }
+
     // Print vector contents to stdout
     void print_vector(std::string vector_name, const std::vector<float> &vec)
     {
@@ -291,11 +308,12 @@ namespace rod
  Normalize a 3-d vector. The there is no return value, but it populates
  an array whose pointer is specified as a function parameter, stl-style.
 */
-    void normalize(const float3 &in, OUT float3 &out)
+    template <typename S>
+    void normalize(const vec3<S> &in, OUT vec3<S> &out)
     {
-        float absolute = sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+        S absolute = sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
         vec3d(n) { out[n] = in[n] / absolute; }
-        if (boost::math::isnan(out[0]))
+        if (boost::math::isnan(value(out[0])))
         {
             out[0] = 0;
             out[1] = 0;
@@ -303,6 +321,7 @@ namespace rod
         }
         not_simulation_destroying(out, "Normalisation is simulation destroying.");
     }
+    template void normalize(const float3 &, OUT float3 &);
 
     void normalize(const std::vector<float> &in, OUT std::vector<float> out)
     {
@@ -329,11 +348,13 @@ namespace rod
  Note: this version is 'unsafe' because it does not check for the
  presence of NaN or infinity.
 */
-    void normalize_unsafe(const float3 &in, float3 &out)
+    template <typename S>
+    void normalize_unsafe(const vec3<S> &in, vec3<S> &out)
     {
-        float absolute = sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+        S absolute = sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
         vec3d(n) { out[n] = in[n] / absolute; }
     }
+    template void normalize_unsafe(const float3 &, float3 &);
 
     /**
  There is some weird behaviour in FFEA when -ffast-math and -O1 or more
@@ -362,12 +383,14 @@ namespace rod
     /**
  Get the absolute value of a vector.
 */
-    float absolute(const float3 &in)
+    template <typename S>
+    S absolute(const vec3<S> &in)
     {
-        float absolute = sqrt(in[x] * in[x] + in[y] * in[y] + in[z] * in[z]);
+        S absolute = sqrt(in[x] * in[x] + in[y] * in[y] + in[z] * in[z]);
         not_simulation_destroying(absolute, "Absolute value is simulation destroying.");
         return absolute;
     }
+    template float absolute(const float3 &);
 
     float absolute(const std::vector<float> &in)
     {
@@ -380,20 +403,24 @@ namespace rod
  Compute the cross product of a 3x1 vector x a 3x1 vector (the result is
  also a 3x1 vector).
 */
-    void cross_product(const float3 &a, const float3 &b, float3 &out)
+    template <typename S>
+    void cross_product(const vec3<S> &a, const vec3<S> &b, vec3<S> &out)
     { // 3x1 x 3x1
         out[x] = (a[y] * b[z]) - (a[z] * b[y]);
         out[y] = (a[z] * b[x]) - (a[x] * b[z]);
         out[z] = (a[x] * b[y]) - (a[y] * b[x]);
         not_simulation_destroying(out, "Cross product is simulation destroying.");
     }
+    template void cross_product(const float3 &, const float3 &, float3 &);
 
-    void cross_product_unsafe(const float3 &a, const float3 &b, float3 &out)
+    template <typename S>
+    void cross_product_unsafe(const vec3<S> &a, const vec3<S> &b, vec3<S> &out)
     { // 3x1 x 3x1
         out[x] = (a[y] * b[z]) - (a[z] * b[y]);
         out[y] = (a[z] * b[x]) - (a[x] * b[z]);
         out[z] = (a[x] * b[y]) - (a[y] * b[x]);
     }
+    template void cross_product_unsafe(const float3 &, const float3 &, float3 &);
 
     /**
  Get the rotation matrix (3x3) that rotates a (3x1) onto b (3x1).
@@ -409,12 +436,13 @@ namespace rod
     \end{bmatrix}\f]
  This seemed like the cheapest way to do it.
 */
-    void get_rotation_matrix(const float3 &a, const float3 &b, float9 &rotation_matrix)
+    template <typename S>
+    void get_rotation_matrix(const vec3<S> &a, const vec3<S> &b, vec9<S> &rotation_matrix)
     {
-        float3 v;
+        vec3<S> v;
         cross_product(a, b, v);
-        float c = (a[x] * b[x]) + (a[y] * b[y]) + (a[z] * b[z]);
-        float9 vx;
+        S c = (a[x] * b[x]) + (a[y] * b[y]) + (a[z] * b[z]);
+        vec9<S> vx;
         vx[0] = 0;
         vx[1] = -1 * v[2];
         vx[2] = v[1]; // vx = skew-symmetric cross product matrix
@@ -424,16 +452,17 @@ namespace rod
         vx[6] = -1 * v[1];
         vx[7] = v[0];
         vx[8] = 0;
-        float m_f = 1 / (1 + c); // multiplication factor
-        float9 identity_matrix = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+        S m_f = 1 / (1 + c); // multiplication factor
+        vec9<S> identity_matrix = {1, 0, 0, 0, 1, 0, 0, 0, 1};
 
-        float9 vx_squared = {-(v[1] * v[1]) - (v[2] * v[2]), v[0] * v[1], v[0] * v[2], v[0] * v[1], -(v[0] * v[0]) - (v[2] * v[2]), v[1] * v[2], v[0] * v[2], v[1] * v[2], -(-v[0] * -v[0]) - (v[1] * v[1])};
+        vec9<S> vx_squared = {-(v[1] * v[1]) - (v[2] * v[2]), v[0] * v[1], v[0] * v[2], v[0] * v[1], -(v[0] * v[0]) - (v[2] * v[2]), v[1] * v[2], v[0] * v[2], v[1] * v[2], -(-v[0] * -v[0]) - (v[1] * v[1])};
 
         for (int i = 0; i < 9; i++)
         {
             rotation_matrix[i] = identity_matrix[i] + vx[i] + (vx_squared[i] * m_f);
         }
     }
+    template void get_rotation_matrix(const float3 &, const float3 &, float9 &);
 
     /**
   Get the rotation matrix (3x3) that rotates some vector (3x1) by an angle
@@ -492,6 +521,15 @@ namespace rod
  This is just a straight matrix multiplication, multiplyning the a column
  vector by a rotation matrix.
 */
+    template <typename S>
+    void apply_rotation_matrix(const vec3<S> &vec, const vec9<S> &matrix, OUT vec3<S> &rotated_vec)
+    {
+        rotated_vec[0] = (vec[x] * matrix[0] + vec[y] * matrix[1] + vec[z] * matrix[2]);
+        rotated_vec[1] = (vec[x] * matrix[3] + vec[y] * matrix[4] + vec[z] * matrix[5]);
+        rotated_vec[2] = (vec[x] * matrix[6] + vec[y] * matrix[7] + vec[z] * matrix[8]);
+    }
+    template void apply_rotation_matrix(const float3 &, const float9 &, OUT float3 &);
+
     void apply_rotation_matrix(arr3_view<float, float3> vec, const float9 &matrix, OUT float3 &rotated_vec)
     {
         rotated_vec[0] = (vec[x] * matrix[0] + vec[y] * matrix[1] + vec[z] * matrix[2]);
@@ -549,20 +587,24 @@ namespace rod
  Where \f$ v_{rot} \f$ is the resultant vector, \f$ \theta \f$ is the angle to rotate,\f$ v \f$ is the original vector and \f$ k \f$ is the axis of rotation.
  This is Rodrigues' rotation formula, a cheap way to rotate a vector around an axis.
 */
-    void rodrigues_rotation(const float3 &v, const float3 &k, float theta, OUT float3 &v_rot)
+    template <typename S>
+    void rodrigues_rotation(const vec3<S> &v, const vec3<S> &k, typename non_deduced<S>::type theta, OUT vec3<S> &v_rot)
     {
-        float3 k_norm;
+        using std::sin;
+        using std::cos;
+        vec3<S> k_norm;
         normalize(k, k_norm);
-        float3 k_cross_v;
-        float sin_theta = std::sin(theta);
-        float cos_theta = std::cos(theta);
+        vec3<S> k_cross_v;
+        S sin_theta = sin(theta);
+        S cos_theta = cos(theta);
         cross_product_unsafe(k_norm, v, k_cross_v);
-        float right_multiplier = (1 - cos_theta) * ((k_norm[x] * v[x]) + (k_norm[y] * v[y]) + (k_norm[z] * v[z]));
-        float3 rhs;
+        S right_multiplier = (1 - cos_theta) * ((k_norm[x] * v[x]) + (k_norm[y] * v[y]) + (k_norm[z] * v[z]));
+        vec3<S> rhs;
         vec3d(n) { rhs[n] = right_multiplier * k_norm[n]; }
         vec3d(n) { v_rot[n] = cos_theta * v[n] + sin_theta * k_cross_v[n] + rhs[n]; }
         not_simulation_destroying(v_rot, "Rodrigues' rotation is simulation destroying.");
     }
+    template void rodrigues_rotation<float>(const float3 &, const float3 &, float, OUT float3 &);
 
     /**
  the c++ acos function will return nan for acos(>1), which we sometimes get (mostly 1.000001) due to
@@ -603,12 +645,14 @@ namespace rod
  returns: the angle between them, in radians.
  Credit: StackOverflow user Adrian Leonhard (https://stackoverflow.com/a/33920320)
  */
-    float get_signed_angle(const float3 &m1, const float3 &m2, const float3 &l)
+    template <typename S>
+    S get_signed_angle(const vec3<S> &m1, const vec3<S> &m2, const vec3<S> &l)
     {
-        float3 m2_cross_m1;
+        vec3<S> m2_cross_m1;
         cross_product(m2, m1, m2_cross_m1);
         return atan2((m2_cross_m1[0] * l[0] + m2_cross_m1[1] * l[1] + m2_cross_m1[2] * l[2]), (m1[0] * m2[0] + m1[1] * m2[1] + m1[2] * m2[2]));
     }
+    template float get_signed_angle(const float3 &, const float3 &, const float3 &);
 
     /*-----------------------*/
     /* Update Material Frame */
@@ -618,25 +662,28 @@ namespace rod
  \f[\widetilde{m_{1 i}}' = \widetilde{m_{1 i}} - ( \widetilde{m_{1 i}} \cdot \widetilde{l_i}) \widetilde{\hat{l_i}}\f]
  where \f$l\f$ is the normalized tangent, \f$m\f$ is the current material frame and \f$m'\f$ is the new one.
 */
-    void perpendicularize(const float3 &m_i, const float3 &p_i, OUT float3 &m_i_prime)
+    template <typename S>
+    void perpendicularize(const vec3<S> &m_i, const vec3<S> &p_i, OUT vec3<S> &m_i_prime)
     {
-        float3 t_i;
+        vec3<S> t_i;
         normalize(p_i, t_i);
-        float m_i_dot_t_i = m_i[x] * t_i[x] + m_i[y] * t_i[y] + m_i[z] * t_i[z];
+        S m_i_dot_t_i = m_i[x] * t_i[x] + m_i[y] * t_i[y] + m_i[z] * t_i[z];
         vec3d(n) { m_i_prime[n] = m_i[n] - m_i_dot_t_i * t_i[n]; }
     }
+    template void perpendicularize(const float3 &, const float3 &, OUT float3 &);
 
     /**
  Say that the segment p_i is rotated into the position p_i_prime. This function rotates the material frame m_i
  by the same amount. Used to compute m_i of the 'perturbed' p_i values during the numerical differentation.
  And also when the new e_i values are computed at the end of each frame!
 */
-    void update_m1_matrix(float3 &m_i, const float3 &p_i, const float3 &p_i_prime, float3 &m_i_prime)
+    template <typename S>
+    void update_m1_matrix(const vec3<S> &m_i, const vec3<S> &p_i, const vec3<S> &p_i_prime, vec3<S> &m_i_prime)
     {
-        float9 rm;
-        float3 m_i_rotated;
-        float3 p_i_norm;
-        float3 p_i_prime_norm;
+        vec9<S> rm;
+        vec3<S> m_i_rotated;
+        vec3<S> p_i_norm;
+        vec3<S> p_i_prime_norm;
         normalize(p_i, p_i_norm);
         normalize(p_i_prime, p_i_prime_norm);
         get_rotation_matrix(p_i_norm, p_i_prime_norm, rm);
@@ -644,6 +691,7 @@ namespace rod
         perpendicularize(m_i_rotated, p_i, m_i_prime);
         normalize(m_i_prime, m_i_prime);
     }
+    template void update_m1_matrix(const float3 &, const float3 &, const float3 &, float3 &);
 
     /*------------------*/
     /* Compute Energies */
@@ -653,14 +701,16 @@ namespace rod
  \f[ E_{stretch} = \frac{1}{2}k(|\vec{p}_i| - |\widetilde{p}_i|)^2 \f]
  where \f$k\f$ is the spring constant, \f$p\f$ is the current segment and \f$m'\f$ is the equilbrium one.
 */
-    float get_stretch_energy(float k, float3 &p_i, float3 &p_i_equil)
+    template <typename S>
+    S get_stretch_energy(float k, const vec3<S> &p_i, const float3 &p_i_equil)
     {
-        float diff = absolute(p_i) - absolute(p_i_equil);
-        float stretch_energy = (diff * diff * 0.5 * k) / absolute(p_i_equil);
+        S diff = absolute(p_i) - absolute(p_i_equil);
+        S stretch_energy = (diff * diff * 0.5 * k) / absolute(p_i_equil);
         not_simulation_destroying(stretch_energy, "get_stretch_energy is simulation destroying.");
 
         return stretch_energy;
     }
+    template float get_stretch_energy(float, const float3 &, const float3 &);
 
     // todo: use OUT correctly on this fn
 
@@ -668,12 +718,14 @@ namespace rod
  Use the previously defined rotation matrix functions to parallel transport a material frame
  m into the orientation m', from segment p_im1 to segment p_i.
 */
-    void parallel_transport(float3 &m, float3 &m_prime, const float3 &p_im1, const float3 &p_i)
+    template <typename S>
+    void parallel_transport(const vec3<S> &m, vec3<S> &m_prime, const vec3<S> &p_im1, const vec3<S> &p_i)
     {
-        float9 rm; // rotation matrix
+        vec9<S> rm; // rotation matrix
         get_rotation_matrix(p_im1, p_i, rm);
         apply_rotation_matrix(m, rm, m_prime);
     }
+    template void parallel_transport(const float3 &, float3 &, const float3 &, const float3 &);
 
     /**
  \f[ E_{twist} = \frac{\beta}{l_i} \left( \Delta \theta_i - \Delta \widetilde{\theta}_i \right)^2 \f]
@@ -681,19 +733,20 @@ namespace rod
  \f[ \Delta\theta = \cos^{-1} ( P(m_{i+1}) \cdot m_i ) \f]
  Where P represents parallel transport.
 */
-    float get_twist_energy(float beta, float3 &m_i, float3 &m_im1, float3 &m_i_equil, float3 &m_im1_equil, float3 &p_im1, float3 &p_i, float3 &p_im1_equil, float3 &p_i_equil)
+    template <typename S>
+    S get_twist_energy(float beta, const vec3<S> &m_i, const vec3<S> &m_im1, const float3 &m_i_equil, const float3 &m_im1_equil, const vec3<S> &p_im1, const vec3<S> &p_i, const float3 &p_im1_equil, const float3 &p_i_equil)
     {
 
         float l_i = get_l_i(p_im1_equil, p_i_equil);
 
-        float3 p_i_norm;
-        float3 p_im1_norm;
+        vec3<S> p_i_norm;
+        vec3<S> p_im1_norm;
         float3 p_i_equil_norm;
         float3 p_im1_equil_norm;
 
-        float3 m_i_norm;
+        vec3<S> m_i_norm;
         float3 m_i_equil_norm;
-        float3 m_im1_norm;
+        vec3<S> m_im1_norm;
         float3 m_im1_equil_norm;
 
         normalize(p_i, p_i_norm);
@@ -706,7 +759,7 @@ namespace rod
         precise_normalize(m_im1, m_im1_norm);
         precise_normalize(m_im1_equil, m_im1_equil_norm);
 
-        float3 m_prime;
+        vec3<S> m_prime;
         parallel_transport(m_im1_norm, m_prime, p_im1_norm, p_i_norm);
         float3 m_equil_prime;
         parallel_transport(m_im1_equil_norm, m_equil_prime, p_im1_equil_norm, p_i_equil_norm);
@@ -714,57 +767,64 @@ namespace rod
         precise_normalize(m_prime, m_prime);
         precise_normalize(m_equil_prime, m_equil_prime);
 
-        float delta_theta = get_signed_angle(m_prime, m_i_norm, p_i_norm);
+        S delta_theta = get_signed_angle(m_prime, m_i_norm, p_i_norm);
         float delta_theta_equil = get_signed_angle(m_equil_prime, m_i_equil_norm, p_i_equil_norm);
 
-        float twist_energy = beta / (l_i * 2) * pow(fmod(delta_theta - delta_theta_equil + M_PI, 2 * M_PI) - M_PI, 2);
+        S twist_energy = beta / (l_i * 2) * pow(fmod(delta_theta - delta_theta_equil + M_PI, 2 * M_PI) - M_PI, 2);
 
         not_simulation_destroying(twist_energy, "get_twist_energy is simulation destroying.");
 
         return twist_energy;
     }
+    template float get_twist_energy(float, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &);
 
     /**
  \f[ \frac{2p_{i-1} \times p_i}{|p_i|\cdot|p_{i-1}| + p_{i-1}\cdot p_i } \f]
  Where \f$p_i\f$ and \f$p_{i-1}\f$ are the i-1 and ith segments, respectively.
 */
-    void get_kb_i(const float3 &p_im1, const float3 &p_i, OUT float3 &kb_i)
+    template <typename S>
+    void get_kb_i(const vec3<S> &p_im1, const vec3<S> &p_i, OUT vec3<S> &kb_i)
     {
-        float3 two_p_im1;
+        vec3<S> two_p_im1;
         vec3d(n) { two_p_im1[n] = p_im1[n] + p_im1[n]; }
-        float3 top;
+        vec3<S> top;
         cross_product(two_p_im1, p_i, top);
-        float bottom = (absolute(p_im1) * absolute(p_i)) + ((p_im1[x] * p_i[x]) + (p_im1[y] * p_i[y]) + (p_im1[z] * p_i[z]));
+        S bottom = (absolute(p_im1) * absolute(p_i)) + ((p_im1[x] * p_i[x]) + (p_im1[y] * p_i[y]) + (p_im1[z] * p_i[z]));
         vec3d(n) { kb_i[n] = top[n] / bottom; }
         not_simulation_destroying(kb_i, "get_kb_i is simulation destroying.");
     }
+    template void get_kb_i(const float3 &, const float3 &, OUT float3 &);
 
     /**
  \f[ \omega(i,j) = \left( (k\vec{b})_i \cdot \vec{n}_j, -(k\vec{b})_i \cdot m_j \right)^T \f]
  Where \f$ (k\vec{b})_i \f$ is the curvature binormal, defined above, and \f$ m_j \f$ and \f$ n_j \f$ are the jth material axes.
 */
-    void get_omega_j_i(const float3 &kb_i, const float3 &n_j, const float3 &m_j, OUT float2 &omega_j_i)
+    template <typename S>
+    void get_omega_j_i(const vec3<S> &kb_i, const vec3<S> &n_j, const vec3<S> &m_j, OUT vec2<S> &omega_j_i)
     { //This is a column matrix not a vector
         omega_j_i[0] = (kb_i[x] * n_j[x]) + (kb_i[y] * n_j[y]) + (kb_i[z] * n_j[z]);
         omega_j_i[1] = -1 * ((kb_i[x] * m_j[x]) + (kb_i[y] * m_j[y]) + (kb_i[z] * m_j[z]));
         not_simulation_destroying(omega_j_i[0], "get_omega_j_i is simulation destroying.");
         not_simulation_destroying(omega_j_i[1], "get_omega_j_i is simulation destroying.");
     }
+    template void get_omega_j_i(const float3 &, const float3 &, const float3 &, OUT float2 &);
 
     /**
  \f[ E_{bend} = \frac{1}{2 \widetilde{l}_i} \sum^i_{j=i-1} (\omega(i,j) - \widetilde{\omega}(i,j) )^T \widetilde{B}^i ( \omega(i,j) - \widetilde{\omega}(i,j) ) \f]
  Where \f$ \omega \f$ is the centreline curvature, defined above, \f$ B \f$ is the bending response matrix, and \f$l_i\f$ is \f$ |p_i| + |p_{i-1}| \f$
 
 */
-    float get_bend_energy(const float2 &omega_i_im1, const float2 &omega_i_im1_equil, const float4 &B_equil)
+    template <typename S>
+    S get_bend_energy(const vec2<S> &omega_i_im1, const vec2<S> &omega_i_im1_equil, const float4 &B_equil)
     {
-        float delta_omega[2];
+        S delta_omega[2];
         delta_omega[0] = omega_i_im1[0] - omega_i_im1_equil[0];
         delta_omega[1] = omega_i_im1[1] - omega_i_im1_equil[1];
-        float result = delta_omega[0] * (delta_omega[0] * B_equil[0] + delta_omega[1] * B_equil[2]) + delta_omega[1] * (delta_omega[0] * B_equil[1] + delta_omega[1] * B_equil[3]);
+        S result = delta_omega[0] * (delta_omega[0] * B_equil[0] + delta_omega[1] * B_equil[2]) + delta_omega[1] * (delta_omega[0] * B_equil[1] + delta_omega[1] * B_equil[3]);
         not_simulation_destroying(result, "get_bend_energy is simulation destroying.");
         return result;
     }
+    template float get_bend_energy(const float2 &, const float2 &, const float4 &);
 
     /**
  This function combines the curvature binormal, centerline curvature and bend energy formulae together, for a given set of segmments and material frames.
@@ -861,32 +921,38 @@ namespace rod
         return bend_energy;
     }
 
-    float get_weights(const float3 &a, const float3 &b)
+    template <typename S>
+    S get_weights(const vec3<S> &a, const vec3<S> &b)
     {
-        const float a_length = absolute(a);
-        const float b_length = absolute(b);
-        const float weight1 = a_length / (a_length + b_length);
+        const S a_length = absolute(a);
+        const S b_length = absolute(b);
+        const S weight1 = a_length / (a_length + b_length);
         return weight1; // weight2 = 1-weight1
     }
+    template float get_weights(const float3 &, const float3 &);
 
-    void get_mutual_element_inverse(const float3 &pim1, const float3 &pi, float weight, OUT float3 &mutual_element)
+    template <typename S>
+    void get_mutual_element_inverse(const vec3<S> &pim1, const vec3<S> &pi, S weight, OUT vec3<S> &mutual_element)
     {
-        float3 pim1_norm;
-        float3 pi_norm;
+        vec3<S> pim1_norm;
+        vec3<S> pi_norm;
         normalize(pi, pi_norm);
         normalize(pim1, pim1_norm);
         vec3d(n) { mutual_element[n] = (1 / weight) * pim1_norm[n] + (1 / (1 - weight)) * pi_norm[n]; }
         //vec3d(n){ mutual_frame[n] = (1/a_length)*a[n] + (1/b_length)*b[n]; }
         normalize(mutual_element, mutual_element);
     }
+    template void get_mutual_element_inverse(const float3 &, const float3 &, float, OUT float3 &);
 
-    void get_mutual_axes_inverse(const float3 &mim1, const float3 &mi, float weight, OUT float3 &m_mutual)
+    template <typename S>
+    void get_mutual_axes_inverse(const vec3<S> &mim1, const vec3<S> &mi, S weight, OUT vec3<S> &m_mutual)
     {
-        float mi_length = absolute(mi);
-        float mim1_length = absolute(mim1);
+        S mi_length = absolute(mi);
+        S mim1_length = absolute(mim1);
         vec3d(n) { m_mutual[n] = (mim1[n] * (1.0 / weight) + mi[n] * (1.0 / (1 - weight))) / (mi_length + mim1_length); }
         normalize(m_mutual, m_mutual);
     }
+    template void get_mutual_axes_inverse(const float3 &, const float3 &, float, OUT float3 &);
 
     //float get_mutual_angle_inverse(const float3 &a, const float3 &b, float angle){
     //    float a_length = absolute(a);
@@ -895,95 +961,101 @@ namespace rod
     //    return angle*a_b_ratio;
     //}
 
-    float get_bend_energy_mutual_parallel_transport(
-        const float3 &p_im1,
-        const float3 &p_i,
-        const float3 &p_im1_equil,
-        const float3 & p_i_equil,
-        const float3 &n_im1,
-        float3 &m_im1,
+    template <typename S>
+    S get_bend_energy_mutual_parallel_transport(
+        const vec3<S> &p_im1,
+        const vec3<S> &p_i,
+        const float3 &p_im1_equil_in,
+        const float3 &p_i_equil_in,
+        const vec3<S> &n_im1,
+        const vec3<S> &m_im1,
         const float3 &n_im1_equil,
-        float3 &m_im1_equil,
-        const float3 &n_i,
-        float3 &m_i,
+        const float3 &m_im1_equil,
+        const vec3<S> &n_i,
+        const vec3<S> &m_i,
         const float3 &n_i_equil,
-        float3 &m_i_equil,
+        const float3 &m_i_equil,
         const float4 &B_i_equil,
         const float4 &B_im1_equil)
     {
+        // The equilibrium mutual element is built with the current weight, so
+        // the equilibrium side of the calculation is done in S as well.
+        vec3<S> p_im1_equil = promote<S>(p_im1_equil_in);
+        vec3<S> p_i_equil = promote<S>(p_i_equil_in);
 
         // get k_b
-        float3 p_i_norm;
-        float3 p_im1_norm;
-        float3 p_i_equil_norm;
-        float3 p_im1_equil_norm;
+        vec3<S> p_i_norm;
+        vec3<S> p_im1_norm;
+        vec3<S> p_i_equil_norm;
+        vec3<S> p_im1_equil_norm;
 
         normalize(p_i, p_i_norm);
         normalize(p_im1, p_im1_norm);
         normalize(p_i_equil, p_i_equil_norm);
         normalize(p_im1_equil, p_im1_equil_norm);
 
-        float L_i = get_l_i(p_i_equil, p_im1_equil);
+        float L_i = get_l_i(p_i_equil_in, p_im1_equil_in);
 
-        float3 kb_i;
-        float3 kb_i_equil;
+        vec3<S> kb_i;
+        vec3<S> kb_i_equil;
         get_kb_i(p_im1_norm, p_i_norm, kb_i);
         get_kb_i(p_im1_equil_norm, p_i_equil_norm, kb_i_equil);
 
-        float weight = get_weights(p_im1, p_i);
-        float equil_weight = get_weights(p_im1_equil, p_i_equil);
+        S weight = get_weights(p_im1, p_i);
+        S equil_weight = get_weights(p_im1_equil, p_i_equil);
 
         // create our mutual l_i
-        float3 mutual_l;
-        float3 equil_mutual_l;
+        vec3<S> mutual_l;
+        vec3<S> equil_mutual_l;
         get_mutual_element_inverse(p_im1, p_i, weight, OUT mutual_l);
         get_mutual_element_inverse(p_im1_equil, p_i_equil, weight, OUT equil_mutual_l);
 
         // parallel transport our existing material frames to our mutual l_i
-        float3 m_im1_transported;
-        float3 m_im1_equil_transported;
+        vec3<S> m_im1_transported;
+        vec3<S> m_im1_equil_transported;
         parallel_transport(m_im1, m_im1_transported, p_im1_norm, mutual_l);
-        parallel_transport(m_im1_equil, m_im1_equil_transported, p_im1_equil_norm, equil_mutual_l);
+        parallel_transport(promote<S>(m_im1_equil), m_im1_equil_transported, p_im1_equil_norm, equil_mutual_l);
 
-        float3 m_i_transported;
-        float3 m_i_equil_transported;
+        vec3<S> m_i_transported;
+        vec3<S> m_i_equil_transported;
         parallel_transport(m_i, m_i_transported, p_i_norm, mutual_l);
-        parallel_transport(m_i_equil, m_i_equil_transported, p_i_equil_norm, equil_mutual_l);
+        parallel_transport(promote<S>(m_i_equil), m_i_equil_transported, p_i_equil_norm, equil_mutual_l);
 
-        float3 m_mutual;
+        vec3<S> m_mutual;
         get_mutual_axes_inverse(m_im1_transported, m_i_transported, weight, m_mutual);
 
-        float3 m_mutual_equil;
+        vec3<S> m_mutual_equil;
         get_mutual_axes_inverse(m_im1_equil_transported, m_i_equil_transported, equil_weight, m_mutual_equil);
 
         normalize(m_mutual_equil, m_mutual_equil);
         normalize(m_mutual, m_mutual);
 
-        float3 n_mutual;
-        float3 n_mutual_equil;
+        vec3<S> n_mutual;
+        vec3<S> n_mutual_equil;
 
         cross_product(mutual_l, m_mutual, n_mutual);
         cross_product(equil_mutual_l, m_mutual_equil, n_mutual_equil);
 
         // finally get omega
-        float2 omega_j_im1;
+        vec2<S> omega_j_im1;
         get_omega_j_i(kb_i, n_mutual, m_mutual, omega_j_im1);
 
-        float2 omega_j_im1_equil;
+        vec2<S> omega_j_im1_equil;
         get_omega_j_i(kb_i_equil, n_mutual_equil, m_mutual_equil, omega_j_im1_equil);
 
-        float bend_energy = 0;
+        S bend_energy = 0;
         bend_energy += get_bend_energy(omega_j_im1, omega_j_im1_equil, B_i_equil);
         bend_energy = bend_energy * (0.5 / (L_i)); // constant!
 
         not_simulation_destroying(bend_energy, "get_bend_energy_from_p is simulation destroying.");
-        if (bend_energy >= 1900000850)
+        if (value(bend_energy) >= 1900000850)
         {
             std::cout << "bend energy is very large. Please fire this up in gdb!\n";
         }
 
         return bend_energy;
     }
+    template float get_bend_energy_mutual_parallel_transport(const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float3 &, const float4 &, const float4 &);
 
     /*----------*/
     /* Dynamics */
@@ -1054,7 +1126,7 @@ namespace rod
         return result;
     }
 
-    float get_delta_r(float friction, float timestep, const std::vector<float> &forces)
+    float get_delta_r(float friction, float timestep, std::initializer_list<float> forces)
     {
         float force_sum = 0;
         for (auto& f : forces)
@@ -1064,7 +1136,7 @@ namespace rod
         return result;
     }
 
-    float get_delta_r(float friction, float timestep, const std::vector<float>& forces,
+    float get_delta_r(float friction, float timestep, std::initializer_list<float> forces,
         const float background_flow)
     {
         float force_sum = 0;
@@ -1137,13 +1209,15 @@ namespace rod
     /**
  This normalizes every segment in a 4-segment section of the rod.
 */
-    void normalize_all(float4x3 &p)
+    template <typename S>
+    void normalize_all(vec4x3<S> &p)
     {
         for (int j = 0; j < 4; j++)
         {
             normalize_unsafe(p[j], p[j]);
         }
     }
+    template void normalize_all(float4x3 &);
 
     /**
  This gets the absolute value of every segment in a 4-segment section of the rod.
@@ -1160,15 +1234,17 @@ namespace rod
  This returns the value of m_2 (the cross product of e and m) for every
  segment in a 4-segment section of the rod.
 */
-    void cross_all(const float4x3 &p, const float4x3 &m, OUT float4x3 &n)
+    template <typename S>
+    void cross_all(const vec4x3<S> &p, const vec4x3<S> &m, OUT vec4x3<S> &n)
     {
         for (int j = 0; j < 4; j++)
         {
-            float3 p_norm;
+            vec3<S> p_norm;
             normalize_unsafe(p[j], p_norm);
             cross_product_unsafe(m[j], p_norm, n[j]);
         }
     }
+    template void cross_all(const float4x3 &, const float4x3 &, OUT float4x3 &);
 
     /**
  This computes the difference between two values of e for a given 4-segment
@@ -1190,7 +1266,8 @@ namespace rod
  than the others in this list, it uses a lookup table, and skips non-existent
  segments.
 */
-    void update_m1_matrix_all(float4x3 &m, const float4x3 &p, const float4x3 &p_prime, OUT float4x3 &m_prime, int start_cutoff, int end_cutoff)
+    template <typename S>
+    void update_m1_matrix_all(const vec4x3<S> &m, const vec4x3<S> &p, const vec4x3<S> &p_prime, OUT vec4x3<S> &m_prime, int start_cutoff, int end_cutoff)
     {
         // I've tried writing 'clever' versions of this
         // but ultimately it's clearer to just write the lookup table explicitly
@@ -1228,6 +1305,7 @@ namespace rod
             throw FFEAException("InvalidArgument: Length of the rod must be larger than 3");
         }
     }
+    template void update_m1_matrix_all(const float4x3 &, const float4x3 &, const float4x3 &, OUT float4x3 &, int, int);
 
     void load_B_all(float4x4 &B, const std::vector<float> &B_matrix, int offset)
     {
@@ -1332,6 +1410,89 @@ namespace rod
     /* Move the node, get the energy */
     /*-------------------------------*/
 
+    /**
+ The energies of the 4-segment window around a node, for the (possibly
+ perturbed) elements p and material frames m. The scalar type S is float
+ for get_perturbation_energy and a dual number for get_energy_gradient.
+   - energies - bend, stretch and twist energy.
+*/
+    template <typename S>
+    void get_window_energies(
+        const float4x4 &B_equil,
+        const float4x3 &material,
+        int start_cutoff,
+        int end_cutoff,
+        const vec4x3<S> &p,
+        const float4x3 &p_equil,
+        const vec4x3<S> &m,
+        const float4x3 &m_equil,
+        OUT vec3<S> &energies)
+    {
+        // Compute m_i_2 (we know it's perpendicular to e_i and m_i_1, so this shouldn't be too hard)
+        vec4x3<S> n;
+        float4x3 n_equil;
+        cross_all(p, m, n);
+        cross_all(p_equil, m_equil, n_equil);
+
+        // Compute unperturbed energy.
+        // I could make this less verbose, but the explicit lookup table is a bit clearer about what's going on.
+        // The basic idea is: if we're close to the 'edge' of the rod, don't compute energies for non-existent nodes! Because they are out of bounds!
+        // Out of bounds values are set to NaN, so will corrupt the maths if an error is made.
+        S bend_energy = 0;
+        S stretch_energy = 0;
+        S twist_energy = 0;
+
+        if (start_cutoff == 0 && end_cutoff == 0)
+        {
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
+            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
+            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
+            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
+            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
+            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
+        }
+        else if (start_cutoff == 1 && end_cutoff == 0)
+        {
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
+            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
+            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
+            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
+            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
+        }
+        else if (start_cutoff == 2 && end_cutoff == 0)
+        {
+            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
+            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
+        }
+        else if (start_cutoff == 0 && end_cutoff == 1)
+        {
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
+            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
+            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
+            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
+            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
+        }
+        else if (start_cutoff == 0 && end_cutoff == 2)
+        {
+            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
+            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
+            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
+        }
+        else
+        {
+            throw FFEAException("InvalidArgument: Length of the rod must be larger than 3");
+        }
+
+        energies[0] = bend_energy;
+        energies[1] = stretch_energy;
+        energies[2] = twist_energy;
+    }
+
     /**
  The get_perturbation_energy function ties together everything in this file.
  It will compute the energy in a specified degree of freedom for a given node.
@@ -1411,69 +1572,242 @@ namespace rod
         normalize_all(m);
         normalize_all(m_equil);
 
-        // Compute m_i_2 (we know it's perpendicular to e_i and m_i_1, so this shouldn't be too hard)
-        float4x3 n;
-        float4x3 n_equil;
-        cross_all(p, m, n);
-        cross_all(p_equil, m_equil, n_equil);
+        get_window_energies(B_equil, material, start_cutoff, end_cutoff, p, p_equil, m, m_equil, energies);
+    }
 
-        // Compute unperturbed energy.
-        // I could make this less verbose, but the explicit lookup table is a bit clearer about what's going on.
-        // The basic idea is: if we're close to the 'edge' of the rod, don't compute energies for non-existent nodes! Because they are out of bounds!
-        // Out of bounds values are set to NaN, so will corrupt the maths if an error is made.
-        float bend_energy = 0;
-        float stretch_energy = 0;
-        float twist_energy = 0;
+    /*------------------------------------------*/
+    /* Forward-mode derivatives of the energies */
+    /*------------------------------------------*/
 
-        if (start_cutoff == 0 && end_cutoff == 0)
-        {
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
-            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
-            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
-            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
-            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
-            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
-        }
-        else if (start_cutoff == 1 && end_cutoff == 0)
-        {
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
-            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
-            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
-            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
-            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
-        }
-        else if (start_cutoff == 2 && end_cutoff == 0)
-        {
-            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
-            twist_energy += get_twist_energy(material[ip1][1], m[ip1], m[i], m_equil[ip1], m_equil[i], p[i], p[ip1], p_equil[i], p_equil[ip1]);
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[i], p[ip1], p_equil[i], p_equil[ip1], n[i], m[i], n_equil[i], m_equil[i], n[ip1], m[ip1], n_equil[ip1], m_equil[ip1], B_equil[ip1], B_equil[i]);
-        }
-        else if (start_cutoff == 0 && end_cutoff == 1)
+    namespace autodiff
+    {
+
+    /**
+     A value together with its derivatives with respect to the four degrees
+     of freedom of a node: x, y, z and twist. Used as the scalar type of the
+     energy functions above, so only what they need is defined. The functions
+     below live in this namespace so that they are found for dual4 arguments,
+     without hiding the float ones.
+    */
+    struct dual4
+    {
+        float v;
+        float4 d;
+        dual4(float v = 0) : v(v), d{0, 0, 0, 0} {}
+    };
+
+    typedef vec3<dual4> dual3;
+    typedef vec4x3<dual4> dual4x3;
+
+    inline dual4 operator+(const dual4 &a, const dual4 &b)
+    {
+        dual4 r(a.v + b.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] + b.d[k];
+        return r;
+    }
+
+    inline dual4 operator-(const dual4 &a, const dual4 &b)
+    {
+        dual4 r(a.v - b.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] - b.d[k];
+        return r;
+    }
+
+    inline dual4 operator-(const dual4 &a)
+    {
+        dual4 r(-a.v);
+        for (int k = 0; k < 4; k++) r.d[k] = -a.d[k];
+        return r;
+    }
+
+    inline dual4 operator*(const dual4 &a, const dual4 &b)
+    {
+        dual4 r(a.v * b.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] * b.v + a.v * b.d[k];
+        return r;
+    }
+
+    inline dual4 operator/(const dual4 &a, const dual4 &b)
+    {
+        float inv = 1 / b.v;
+        dual4 r(a.v * inv);
+        for (int k = 0; k < 4; k++) r.d[k] = (a.d[k] - r.v * b.d[k]) * inv;
+        return r;
+    }
+
+    inline dual4 operator+(const dual4 &a, float b) { dual4 r = a; r.v += b; return r; }
+    inline dual4 operator+(float a, const dual4 &b) { return b + a; }
+    inline dual4 operator-(const dual4 &a, float b) { return a + (-b); }
+    inline dual4 operator-(float a, const dual4 &b) { return -b + a; }
+
+    inline dual4 operator*(float a, const dual4 &b)
+    {
+        dual4 r(a * b.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a * b.d[k];
+        return r;
+    }
+
+    inline dual4 operator*(const dual4 &a, float b) { return b * a; }
+    inline dual4 operator/(const dual4 &a, float b) { return (1 / b) * a; }
+    inline dual4 operator/(float a, const dual4 &b) { return dual4(a) / b; }
+    inline dual4 &operator+=(dual4 &a, const dual4 &b) { return a = a + b; }
+
+    inline float value(const dual4 &a) { return a.v; }
+
+    inline dual4 sqrt(const dual4 &a)
+    {
+        dual4 r(std::sqrt(a.v));
+        // zero gradient at zero length (e.g. unset material frames), rather than NaN
+        float half_inv = r.v > 0 ? 0.5 / r.v : 0;
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] * half_inv;
+        return r;
+    }
+
+    inline dual4 sin(const dual4 &a)
+    {
+        dual4 r(std::sin(a.v));
+        float c = std::cos(a.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] * c;
+        return r;
+    }
+
+    inline dual4 cos(const dual4 &a)
+    {
+        dual4 r(std::cos(a.v));
+        float s = -std::sin(a.v);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] * s;
+        return r;
+    }
+
+    inline dual4 atan2(const dual4 &a, const dual4 &b)
+    {
+        dual4 r(std::atan2(a.v, b.v));
+        float norm = a.v * a.v + b.v * b.v;
+        float inv = norm > 0 ? 1 / norm : 0;
+        for (int k = 0; k < 4; k++) r.d[k] = (b.v * a.d[k] - a.v * b.d[k]) * inv;
+        return r;
+    }
+
+    /** fmod by a constant, which only shifts the value. */
+    inline dual4 fmod(const dual4 &a, double b)
+    {
+        dual4 r = a;
+        r.v = std::fmod(a.v, b);
+        return r;
+    }
+
+    inline dual4 pow(const dual4 &a, int n)
+    {
+        dual4 r(std::pow(a.v, n));
+        float scale = n * std::pow(a.v, n - 1);
+        for (int k = 0; k < 4; k++) r.d[k] = a.d[k] * scale;
+        return r;
+    }
+
+    bool not_simulation_destroying(const dual4 &a, std::string message)
+    {
+        return rod::not_simulation_destroying(a.v, message);
+    }
+
+    bool not_simulation_destroying(const dual3 &a, std::string message)
+    {
+        return rod::not_simulation_destroying(float3{a[0].v, a[1].v, a[2].v}, message);
+    }
+
+    /** The double precision is only there to get the value right for std::acos, which dual4 does not use. */
+    void precise_normalize(const dual3 &in, OUT dual3 &out)
+    {
+        rod::normalize(in, out);
+    }
+
+    } // end namespace autodiff
+
+    /**
+ Get the stretch, bend and twist energies of the 4-segment window around
+ a node, together with their derivatives with respect to moving the node
+ in x, y and z and to twisting its material frame. This is the same
+ calculation as get_perturbation_energy (both go through get_window_energies),
+ but the perturbation is carried by dual numbers instead of being applied
+ with a finite amount, so one call replaces eight and the result does not
+ depend on a step size.
+   - energies - bend, stretch and twist energy, as in get_perturbation_energy.
+   - gradients - gradients[dof][k] is the derivative of energies[k] with
+     respect to the degree of freedom dof (x, y, z or twist).
+*/
+    void get_energy_gradient(
+        std::vector<float> &B_matrix,
+        std::vector<float> &material_params,
+        int start_cutoff,
+        int end_cutoff,
+        int p_i_node_no,
+        std::vector<float> &r_all,
+        std::vector<float> &r_all_equil,
+        std::vector<float> &m_all,
+        std::vector<float> &m_all_equil,
+        OUT float3 &energies,
+        float4x3 &gradients)
+    {
+        using autodiff::dual4;
+        using autodiff::dual3;
+        using autodiff::dual4x3;
+
+        float4x4 B_equil;
+        load_B_all(B_equil, B_matrix, p_i_node_no);
+
+        float4x3 p_loaded;
+        float4x3 m_loaded;
+        float4x3 p_equil;
+        float4x3 m_equil;
+        float4x3 material;
+        load_p(p_loaded, r_all, p_i_node_no);
+        load_p(p_equil, r_all_equil, p_i_node_no);
+        load_m(m_loaded, m_all, p_i_node_no);
+        load_m(m_equil, m_all_equil, p_i_node_no);
+        load_m(material, material_params, p_i_node_no);
+
+        dual4x3 original_p;
+        dual4x3 m;
+        for (int j = 0; j < 4; j++)
         {
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im1], p[i], p_equil[im1], p_equil[i], n[im1], m[im1], n_equil[im1], m_equil[im1], n[i], m[i], n_equil[i], m_equil[i], B_equil[i], B_equil[im1]);
-            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
-            twist_energy += get_twist_energy(material[i][1], m[i], m[im1], m_equil[i], m_equil[im1], p[im1], p[i], p_equil[im1], p_equil[i]);
-            stretch_energy += get_stretch_energy(material[i][0], p[i], p_equil[i]);
-            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
+            original_p[j] = promote<dual4>(p_loaded[j]);
+            m[j] = promote<dual4>(m_loaded[j]);
         }
-        else if (start_cutoff == 0 && end_cutoff == 2)
+
+        // Moving the node by (dx, dy, dz) stretches p_im1 and shortens p_i,
+        // and twisting it rotates m_i about p_i.
+        dual4x3 p = original_p;
+        vec3d(n)
         {
-            bend_energy += get_bend_energy_mutual_parallel_transport(p[im2], p[im1], p_equil[im2], p_equil[im1], n[im2], m[im2], n_equil[im2], m_equil[im2], n[im1], m[im1], n_equil[im1], m_equil[im1], B_equil[im1], B_equil[im2]);
-            stretch_energy += get_stretch_energy(material[im1][0], p[im1], p_equil[im1]);
-            twist_energy += get_twist_energy(material[im1][1], m[im1], m[im2], m_equil[im1], m_equil[im2], p[im2], p[im1], p_equil[im2], p_equil[im1]);
+            p[im1][n].d[n] = 1;
+            p[i][n].d[n] = -1;
         }
-        else
+        dual4 theta;
+        theta.d[3] = 1;
+        rodrigues_rotation(m[i], p[i], theta, m[i]);
+
+        // The material frames follow the elements (this is the identity for
+        // the values, but not for the derivatives).
+        update_m1_matrix_all(m, original_p, p, m, start_cutoff, end_cutoff);
+
+        normalize_all(m);
+        normalize_all(m_equil);
+
+        dual3 window_energies;
+        get_window_energies(B_equil, material, start_cutoff, end_cutoff, p, p_equil, m, m_equil, window_energies);
+        dual4 bend_energy = window_energies[0];
+        dual4 stretch_energy = window_energies[1];
+        dual4 twist_energy = window_energies[2];
+
+        energies[0] = bend_energy.v;
+        energies[1] = stretch_energy.v;
+        energies[2] = twist_energy.v;
+        for (int dof = 0; dof < 4; dof++)
         {
-            throw FFEAException("InvalidArgument: Length of the rod must be larger than 3");
+            gradients[dof][0] = bend_energy.d[dof];
+            gradients[dof][1] = stretch_energy.d[dof];
+            gradients[dof][2] = twist_energy.d[dof];
+            not_simulation_destroying(gradients[dof], "get_energy_gradient is simulation destroying.");
         }
-
-        energies[0] = bend_energy;
-        energies[1] = stretch_energy;
-        energies[2] = twist_energy;
     }
 
     //   _ _
@@ -34,6 +34,8 @@
 
 #include "FFEA_return_codes.h"
 
+#include <exception>
+
 namespace rod
 {
 
@@ -66,18 +68,17 @@ namespace rod
     }
 
     /**
-    Generate a random number between A and B, given an array of RngStream
-    objects, and the id of the RngStream objects to be used.
+    Generate a random number between A and B from a single RngStream object.
     */
-    float random_number(float A, float B, std::vector<RngStream> &rng, int thread_id)
+    float random_number(float A, float B, RngStream &rng)
     {
-        return ((A) + ((B) - (A)) * (rng[thread_id].RandU01()));
+        return ((A) + ((B) - (A)) * (rng.RandU01()));
     }
 
-    InteractionData get_interaction_data(int elem_id_self, int elem_id_nbr,
-        const std::vector<std::vector<InteractionData>> &nbr_list)
+    const InteractionData &get_interaction_data(int elem_id_self, int elem_id_nbr,
+        const NbrList &nbr_list)
     {
-        return nbr_list.at(elem_id_self).at(elem_id_nbr);
+        return nbr_list.get(elem_id_self, elem_id_nbr);
     }
 
     /**-----**/
@@ -112,6 +113,10 @@ namespace rod
                                            vdw_force(length),
                                            num_vdw_nbrs(length/3),
                                            applied_forces(length + (length / 3)),
+                                           internal_forces(length + (length / 3)),
+                                           random_draws(length + (length / 3)),
+                                           delta_r(length),
+                                           element_forces(2 * length),
                                            pinned_nodes(length / 3) {}
 
     /**
@@ -133,7 +138,7 @@ namespace rod
     When the file is written, the units are converted back automagically.
     The units are specified in mesoDimensions.h.
     */
-    Rod Rod::set_units()
+    Rod &Rod::set_units()
     {
         /** Translate our units into the units specified in FFEA's mesoDimensions header file **/
         bending_response_factor = pow(mesoDimensions::length, 4) * mesoDimensions::pressure;
@@ -194,14 +199,48 @@ namespace rod
     /**---------**/
 
     /**
-    Do a timestep.
+    Draw the uniform random numbers for the noise on every unpinned node, in
+    node order, from a single stream. Drawing them before the step, rather
+    than from a stream per thread inside it, means each node gets the same
+    numbers however many threads (and however many rods at once) the step
+    is spread over.
+    */
+    Rod &Rod::draw_noise(RngStream &rng)
+    {
+        if (this->calc_noise != 1)
+            return *this;
+
+        for (int node_no = 0; node_no < this->get_num_nodes(); node_no++)
+        {
+            if (pinned_nodes[node_no] == true)
+                continue;
+            for (int dof = 0; dof < 4; dof++)
+                random_draws[(node_no * 4) + dof] = random_number(-0.5, 0.5, rng);
+        }
+        return *this;
+    }
+
+    /**
+    Do a timestep, drawing the noise from the first of the RngStream objects.
+    */
+    Rod &Rod::do_timestep(std::shared_ptr<std::vector<RngStream>> &rng)
+    {
+        this->draw_noise((*rng)[0]);
+        return this->do_timestep();
+    }
+
+    /**
+    Do a timestep, with the noise already drawn by draw_noise.
     This function contains three loops. Two over nodes and one over elements. The
     first loop (nodes) populates the contents of the energy arrays, which we use to
     work out delta E. The second one (elements) works out the energy from all steric
     interactions between neighbouring elements. The third loop (nodes) uses energies
     to compute dynamics and applies those dynamics to the position arrays.
+    The loops are OpenMP taskloops, so that when World runs several rods as
+    concurrent tasks their nodes share the same pool of threads. Every node only
+    writes its own entries, so the result does not depend on the number of threads.
     */
-    Rod Rod::do_timestep(std::shared_ptr<std::vector<RngStream>> &rng)
+    Rod &Rod::do_timestep()
     {
 
         // if there is a rod-blob interface, this will avoid doing dynamics
@@ -219,7 +258,7 @@ namespace rod
         }
 
 //The first loop is over all the nodes, and it computes all the energies for each one
-#pragma omp parallel for schedule(dynamic) //most of the execution time is spent in this first loop
+#pragma omp taskloop //most of the execution time is spent in this first loop
         for (int node_no = 0; node_no < end_node; node_no++)
         {
             if (rod::dbg_print)
@@ -240,40 +279,14 @@ namespace rod
             int *end_cutoff = &end_cutoff_val; // for the multiple return values
             set_cutoff_values(node_no, this->get_num_nodes(), start_cutoff, end_cutoff);
 
-            // We need this e now because we need the previous value of e to do a material frame update
-            // If you're curious about the [4][3] check out the get_perturbation_energy docs
-            float4x3 p;
-            load_p(p, current_r, node_no);
-
-            float3 energies; //bend, stretch, twist (temporary variable).
-
-            // We move the node backwards and forwards in each degree of freedom, so we end up calling get_perturbation_energy eight whole times
-            // Fill the temporary variable with energies ( we basically pass the entire state of the rod to get_perturbation_energy)
+            // Get the energies and their derivatives with respect to moving the
+            // node in x, y and z and twisting it, all in a single pass
             if (rod::dbg_print)
-                std::cout << "CALCULATING INTERNAL PERTURBATION ENERGIES\n";
+                std::cout << "CALCULATING INTERNAL ENERGY GRADIENTS\n";
 
-            get_perturbation_energy(
-                perturbation_amount * 0.5, //half one way, half the other
-                x,                         // dimension (x, y, z are array indices, defined to be 1, 2, 3 at the top of this file, twist is = 4)
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies); // this is a void function with energies as the output
-
-            // transfer them from the temporary variable to the real thing
-            internal_perturbed_x_energy_positive[node_no * 3] = energies[stretch_index];
-            internal_perturbed_x_energy_positive[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_x_energy_positive[(node_no * 3) + 2] = energies[twist_index];
-
-            get_perturbation_energy( //from rod_math
-                perturbation_amount * 0.5,
-                y, // dimension
+            float3 energies; //bend, stretch, twist (temporary variable).
+            float4x3 gradients; // d(energies)/d(x, y, z, twist)
+            get_energy_gradient(
                 B_matrix,
                 material_params,
                 start_cutoff_val,
@@ -283,120 +296,42 @@ namespace rod
                 equil_r,
                 current_m,
                 equil_m,
-                energies);
-
-            internal_perturbed_y_energy_positive[node_no * 3] = energies[stretch_index];
-            internal_perturbed_y_energy_positive[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_y_energy_positive[(node_no * 3) + 2] = energies[twist_index];
+                energies,
+                gradients);
 
-            get_perturbation_energy( //from rod_math
-                perturbation_amount * 0.5,
-                z, // dimension
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
+            for (int dof = 0; dof < 4; dof++)
+                internal_forces[(node_no * 4) + dof] = -(gradients[dof][0] + gradients[dof][1] + gradients[dof][2]);
 
-            internal_perturbed_z_energy_positive[node_no * 3] = energies[stretch_index];
-            internal_perturbed_z_energy_positive[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_z_energy_positive[(node_no * 3) + 2] = energies[twist_index];
+            // The perturbed energies are no longer needed for the dynamics, so they
+            // are only worked out, the same way as before, when they are written out
+            if (!perturbed_energies_due)
+                continue;
 
             float twist_perturbation = 0.006283185; // 2pi/1000
-            get_perturbation_energy(                //from rod_math
-                twist_perturbation * 0.5,
-                4, // twist dimension = 4
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
-
-            internal_twisted_energy_positive[node_no * 3] = energies[stretch_index];
-            internal_twisted_energy_positive[(node_no * 3) + 1] = energies[bend_index];
-            internal_twisted_energy_positive[(node_no * 3) + 2] = energies[twist_index];
-
-            get_perturbation_energy(
-                perturbation_amount * -0.5,
-                x, // dimension
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
-
-            internal_perturbed_x_energy_negative[node_no * 3] = energies[stretch_index];
-            internal_perturbed_x_energy_negative[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_x_energy_negative[(node_no * 3) + 2] = energies[twist_index];
-
-            get_perturbation_energy( //from rod_math
-                perturbation_amount * -0.5,
-                y, // dimension
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
-
-            internal_perturbed_y_energy_negative[node_no * 3] = energies[stretch_index];
-            internal_perturbed_y_energy_negative[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_y_energy_negative[(node_no * 3) + 2] = energies[twist_index];
-
-            get_perturbation_energy( //from rod_math
-                perturbation_amount * -0.5,
-                z, // dimension
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
-
-            internal_perturbed_z_energy_negative[node_no * 3] = energies[stretch_index];
-            internal_perturbed_z_energy_negative[(node_no * 3) + 1] = energies[bend_index];
-            internal_perturbed_z_energy_negative[(node_no * 3) + 2] = energies[twist_index];
-
-            get_perturbation_energy( //from rod_math
-                twist_perturbation * -0.5,
-                4, // twist dimension = 4
-                B_matrix,
-                material_params,
-                start_cutoff_val,
-                end_cutoff_val,
-                node_no,
-                current_r,
-                equil_r,
-                current_m,
-                equil_m,
-                energies);
-
-            internal_twisted_energy_negative[node_no * 3] = energies[stretch_index];
-            internal_twisted_energy_negative[(node_no * 3) + 1] = energies[bend_index];
-            internal_twisted_energy_negative[(node_no * 3) + 2] = energies[twist_index];
+            std::array<std::vector<float> *, 8> perturbed = {
+                &internal_perturbed_x_energy_positive, &internal_perturbed_y_energy_positive, &internal_perturbed_z_energy_positive, &internal_twisted_energy_positive,
+                &internal_perturbed_x_energy_negative, &internal_perturbed_y_energy_negative, &internal_perturbed_z_energy_negative, &internal_twisted_energy_negative};
+            for (int k = 0; k < 8; k++)
+            {
+                int dof = k % 4;
+                float sign = k < 4 ? 0.5 : -0.5; //half one way, half the other
+                get_perturbation_energy(
+                    (dof == 3 ? twist_perturbation : perturbation_amount) * sign,
+                    dof == 3 ? 4 : dof, // x, y, z, or twist = 4
+                    B_matrix,
+                    material_params,
+                    start_cutoff_val,
+                    end_cutoff_val,
+                    node_no,
+                    current_r,
+                    equil_r,
+                    current_m,
+                    equil_m,
+                    energies);
+                (*perturbed[k])[node_no * 3] = energies[stretch_index];
+                (*perturbed[k])[(node_no * 3) + 1] = energies[bend_index];
+                (*perturbed[k])[(node_no * 3) + 2] = energies[twist_index];
+            }
         }
 
         if (this->calc_steric == 1)
@@ -405,7 +340,11 @@ namespace rod
         if (this->calc_vdw == 1)
             do_vdw();
 
-        // Dynamics
+        // Dynamics. Each node works out its displacement and updates its own
+        // material frame against the unmoved position of the next node, which
+        // is what a node-by-node loop sees, and the displacements are applied
+        // afterwards
+#pragma omp taskloop
         for (int node_no = 0; node_no < end_node; node_no++)
         {
             if (pinned_nodes[node_no] == true)
@@ -414,13 +353,6 @@ namespace rod
             if (node_no < node_min)
                 continue;
 
-// Grab thread ID from openMP (needed for RNG)
-#ifdef USE_OPENMP
-            int thread_id = omp_get_thread_num();
-#else
-            int thread_id = 0;
-#endif
-
             // Get friction, needed for delta r and delta theta
             float translational_friction = get_translational_friction(this->viscosity, get_radius(node_no), false);
             //float length_for_friction = (get_absolute_length_from_array(equil_r, node_no, this->length) + get_absolute_length_from_array(equil_r, node_no-1, this->length))/2;
@@ -428,9 +360,6 @@ namespace rod
 
             float rotational_friction = get_rotational_friction(this->viscosity, get_radius(node_no), length_for_friction, true);
 
-            // Need these again
-            float twist_perturbation = 0.006283185; // 2pi/1000
-
             // The material frame update requires that we grab the ith segment as it was before we did any dynamics
             float3 previous_p_i;
             float3 r_i;
@@ -451,18 +380,17 @@ namespace rod
 
             if (this->calc_noise == 1)
             {
-                x_noise = get_noise(timestep, kT, translational_friction, random_number(-0.5, 0.5, *rng, thread_id));
-                y_noise = get_noise(timestep, kT, translational_friction, random_number(-0.5, 0.5, *rng, thread_id));
-                z_noise = get_noise(timestep, kT, translational_friction, random_number(-0.5, 0.5, *rng, thread_id));
-                twist_noise = get_noise(timestep, kT, rotational_friction, random_number(-0.5, 0.5, *rng, thread_id));
+                x_noise = get_noise(timestep, kT, translational_friction, random_draws[node_no * 4]);
+                y_noise = get_noise(timestep, kT, translational_friction, random_draws[(node_no * 4) + 1]);
+                z_noise = get_noise(timestep, kT, translational_friction, random_draws[(node_no * 4) + 2]);
+                twist_noise = get_noise(timestep, kT, rotational_friction, random_draws[(node_no * 4) + 3]);
             }
 
-            // Sum our energies and use them to compute the force
-            // ! Not sure why we have negative - positive here, I'd have assumed it was the other way around
-            float x_force = (internal_perturbed_x_energy_negative[node_no * 3] + internal_perturbed_x_energy_negative[(node_no * 3) + 1] + internal_perturbed_x_energy_negative[(node_no * 3) + 2] - (internal_perturbed_x_energy_positive[node_no * 3] + internal_perturbed_x_energy_positive[(node_no * 3) + 1] + internal_perturbed_x_energy_positive[(node_no * 3) + 2])) / perturbation_amount;
-            float y_force = (internal_perturbed_y_energy_negative[node_no * 3] + internal_perturbed_y_energy_negative[(node_no * 3) + 1] + internal_perturbed_y_energy_negative[(node_no * 3) + 2] - (internal_perturbed_y_energy_positive[node_no * 3] + internal_perturbed_y_energy_positive[(node_no * 3) + 1] + internal_perturbed_y_energy_positive[(node_no * 3) + 2])) / perturbation_amount;
-            float z_force = (internal_perturbed_z_energy_negative[node_no * 3] + internal_perturbed_z_energy_negative[(node_no * 3) + 1] + internal_perturbed_z_energy_negative[(node_no * 3) + 2] - (internal_perturbed_z_energy_positive[node_no * 3] + internal_perturbed_z_energy_positive[(node_no * 3) + 1] + internal_perturbed_z_energy_positive[(node_no * 3) + 2])) / perturbation_amount;
-            float twist_force = (internal_twisted_energy_negative[node_no * 3] + internal_twisted_energy_negative[(node_no * 3) + 1] + internal_twisted_energy_negative[(node_no * 3) + 2] - (internal_twisted_energy_positive[node_no * 3] + internal_twisted_energy_positive[(node_no * 3) + 1] + internal_twisted_energy_positive[(node_no * 3) + 2])) / twist_perturbation;
+            // Internal forces, from the energy gradients
+            float x_force = internal_forces[node_no * 4];
+            float y_force = internal_forces[(node_no * 4) + 1];
+            float z_force = internal_forces[(node_no * 4) + 2];
+            float twist_force = internal_forces[(node_no * 4) + 3];
 
             float applied_force_x = applied_forces[node_no * 4];
             float applied_force_y = applied_forces[(node_no * 4) + 1];
@@ -492,18 +420,13 @@ namespace rod
                     std::cout << "vdw_force, node " << node_no << ": (" << x_vdw << ", " << y_vdw << ", " << z_vdw << ")\n";
             }
 
-
-
+            float3 velocity = {flow_velocity[0], flow_velocity[1], flow_velocity[2]};
             if (flow_profile == "shear")
-                flow_velocity[0] = shear_rate * current_r[(node_no*3) + 1];
-
-            std::vector<float> x_force_vector{x_force, x_noise, applied_force_x, x_steric, x_vdw};
-            std::vector<float> y_force_vector{y_force, y_noise, applied_force_y, y_steric, y_vdw};
-            std::vector<float> z_force_vector{z_force, z_noise, applied_force_z, z_steric, z_vdw};
+                velocity[0] = shear_rate * current_r[(node_no*3) + 1];
 
-            float delta_r_x = rod::get_delta_r(translational_friction, timestep, x_force_vector, flow_velocity[0]);
-            float delta_r_y = rod::get_delta_r(translational_friction, timestep, y_force_vector, flow_velocity[1]);
-            float delta_r_z = rod::get_delta_r(translational_friction, timestep, z_force_vector, flow_velocity[2]);
+            float delta_r_x = rod::get_delta_r(translational_friction, timestep, {x_force, x_noise, applied_force_x, x_steric, x_vdw}, velocity[0]);
+            float delta_r_y = rod::get_delta_r(translational_friction, timestep, {y_force, y_noise, applied_force_y, y_steric, y_vdw}, velocity[1]);
+            float delta_r_z = rod::get_delta_r(translational_friction, timestep, {z_force, z_noise, applied_force_z, z_steric, z_vdw}, velocity[2]);
             float delta_twist = rod::get_delta_r(rotational_friction, timestep, twist_force, twist_noise, applied_force_twist);
 
             if (dbg_print)
@@ -514,23 +437,23 @@ namespace rod
                 std::cout << "  delta_twist : " << delta_twist << "\n";
             }
 
-            // Update rod node positions
-            current_r[node_no * 3] += delta_r_x;
-            current_r[(node_no * 3) + 1] += delta_r_y;
-            current_r[(node_no * 3) + 2] += delta_r_z;
+            // New rod node position, applied to current_r after the loop
+            delta_r[node_no * 3] = delta_r_x;
+            delta_r[(node_no * 3) + 1] = delta_r_y;
+            delta_r[(node_no * 3) + 2] = delta_r_z;
+            r_i[0] += delta_r_x;
+            r_i[1] += delta_r_y;
+            r_i[2] += delta_r_z;
 
             // A wee sanity check to stop your simulations from exploding horribly
-            for (int i = 0; i < length; i++)
+            if (std::abs(delta_r_x) >= 800000 || std::abs(delta_r_y) >= 800000 || std::abs(delta_r_z) >= 800000)
             {
-                if (std::abs(delta_r_x) >= 800000 || std::abs(delta_r_y) >= 800000 || std::abs(delta_r_z) >= 800000)
-                {
-                    std::cout << "node " << node_no << " frame " << frame_no << "\n";
-                    std::cout << "delta_r: " << delta_r_x << ", " << delta_r_y << ", " << delta_r_z << "\n";
-                    if (rod::dbg_print)
-                        std::cout << "WARNING: Rod dynamics explosion\n";
-                    else
-                        rod_abort("Rod dynamics explosion. Bring your debugger.");
-                }
+                std::cout << "node " << node_no << " frame " << frame_no << "\n";
+                std::cout << "delta_r: " << delta_r_x << ", " << delta_r_y << ", " << delta_r_z << "\n";
+                if (rod::dbg_print)
+                    std::cout << "WARNING: Rod dynamics explosion\n";
+                else
+                    rod_abort("Rod dynamics explosion. Bring your debugger.");
             }
 
             // If we're applying delta twist, we must load our new p_i back in
@@ -541,14 +464,6 @@ namespace rod
                 m_to_rotate[1] = current_m[(node_no * 3) + 1];
                 m_to_rotate[2] = current_m[(node_no * 3) + 2]; // take the relevant info out of the data structure
                 float3 p_i;
-                float3 r_i;
-                float3 r_ip1; // we need all of these from the rod again
-                r_i[0] = current_r[node_no * 3];
-                r_i[1] = current_r[(node_no * 3) + 1];
-                r_i[2] = current_r[(node_no * 3) + 2];
-                r_ip1[0] = current_r[(node_no * 3) + 3];
-                r_ip1[1] = current_r[(node_no * 3) + 1 + 3];
-                r_ip1[2] = current_r[(node_no * 3) + 2 + 3];
                 get_p_i(r_i, r_ip1, p_i);                                       //from rod_math
                 rodrigues_rotation(m_to_rotate, p_i, delta_twist, m_to_rotate); // work out the actual rotated value
                 current_m[node_no * 3] = m_to_rotate[0];
@@ -562,14 +477,6 @@ namespace rod
                 float3 current_p_i;
                 float3 m_to_fix;
                 float3 m_i_prime;
-                float3 r_i;
-                float3 r_ip1; //now: grab the quantities we need out of the data structure
-                r_i[0] = current_r[node_no * 3];
-                r_i[1] = current_r[(node_no * 3) + 1];
-                r_i[2] = current_r[(node_no * 3) + 2];
-                r_ip1[0] = current_r[(node_no * 3) + 3];
-                r_ip1[1] = current_r[(node_no * 3) + 1 + 3];
-                r_ip1[2] = current_r[(node_no * 3) + 2 + 3];
                 for (int i = 0; i < 3; i++)
                 {
                     current_p_i[i] = r_ip1[i] - r_i[i];
@@ -582,22 +489,34 @@ namespace rod
                 current_m[(node_no * 3) + 1] = m_i_prime[1];
                 current_m[(node_no * 3) + 2] = m_i_prime[2]; // back into the data structure you go
             }
+        }  // end node loop
 
-            if (this->calc_vdw)
-            {
-                if (this->num_vdw_sites != this->vdw_sites.size())
-                    throw FFEAException("'num_vdw_sites' is not equal to the number of VDW site structs");
+        // Update rod node positions
+        for (int node_no = node_min; node_no < end_node; node_no++)
+        {
+            if (pinned_nodes[node_no] == true)
+                continue;
 
-                for (int site_index = 0; site_index < this->vdw_sites.size(); ++site_index)
-                {
-                    // ! given that this happens in the nbr list update, it may not be required here
-                    this->vdw_sites.at(site_index).update_position(this->current_r);
-                    vec3d(n) { vdw_site_pos.at((site_index * 3) + n) = this->vdw_sites.at(site_index).pos[n]; }
-                }
-            }
+            current_r[node_no * 3] += delta_r[node_no * 3];
+            current_r[(node_no * 3) + 1] += delta_r[(node_no * 3) + 1];
+            current_r[(node_no * 3) + 2] += delta_r[(node_no * 3) + 2];
 
             step_no += 1;
-        }  // end node loop
+        }
+
+        // The sites only depend on the final node positions, so they are moved once per step
+        if (this->calc_vdw)
+        {
+            if (this->num_vdw_sites != this->vdw_sites.size())
+                throw FFEAException("'num_vdw_sites' is not equal to the number of VDW site structs");
+
+            for (int site_index = 0; site_index < this->vdw_sites.size(); ++site_index)
+            {
+                // ! given that this happens in the nbr list update, it may not be required here
+                this->vdw_sites[site_index].update_position(this->current_r);
+                vec3d(n) { vdw_site_pos[(site_index * 3) + n] = this->vdw_sites[site_index].pos[n]; }
+            }
+        }
 
         if (this->calc_steric == 1)
             this->reset_nbr_list(this->steric_nbrs);
@@ -626,7 +545,7 @@ namespace rod
     sets some default values for global simulation parameters. Eventually,
     these will be overwritten by parameters from the .ffea file.
     */
-    Rod Rod::load_header(std::string filename)
+    Rod &Rod::load_header(std::string filename)
     {
         rod_filename = filename;
         file_ptr = fopen(filename.c_str(), "a");
@@ -717,6 +636,10 @@ namespace rod
         steric_force.resize(length);
         num_steric_nbrs.resize(length/3);
         applied_forces.resize(length + (length / 3));
+        internal_forces.resize(length + (length / 3));
+        random_draws.resize(length + (length / 3));
+        delta_r.resize(length);
+        element_forces.resize(2 * length);
         pinned_nodes.resize(length / 3);
         steric_nbrs.resize((length / 3) - 1);
         vdw_energy.resize(length);
@@ -746,7 +669,7 @@ namespace rod
     Note: to remove the force, you must call this function again with 0s,
     or it will continue appyling the force.
     */
-    Rod Rod::add_force(const float4 &force, int node_index)
+    Rod &Rod::add_force(const float4 &force, int node_index)
     {
         this->applied_forces[node_index * 4] = force[0] / mesoDimensions::force;
         this->applied_forces[(node_index * 4) + 1] = force[1] / mesoDimensions::force;
@@ -762,7 +685,7 @@ namespace rod
     current state of the rod - the FFEA_rod python class is the only one
     that loads the rod trajectory.
     */
-    Rod Rod::load_contents(std::string filename)
+    Rod &Rod::load_contents(std::string filename)
     {
 
         /** Make sure this method isn't called before loading header info */
@@ -955,7 +878,7 @@ namespace rod
     }
 
     // Read in VDW interaction types and positions and initialise the relevant arrays
-    Rod Rod::load_vdw(const std::string filename)
+    Rod &Rod::load_vdw(const std::string filename)
     {
         std::ifstream infile(filename);
         if (!infile)
@@ -1040,7 +963,7 @@ namespace rod
     *file_ptr. This will convert from MesoDimensions to SI units, so if your
     values are already in SI units, they'll be wrong.
     */
-    Rod Rod::write_frame_to_file()
+    Rod &Rod::write_frame_to_file()
     {
         this->frame_no += 1;
         std::fprintf(file_ptr, "FRAME %i ROD %i\n", frame_no, rod_no);
@@ -1073,7 +996,7 @@ namespace rod
     This function is almost identical to the one above, but it appllies
     different scale factors for objects in the array,
     */
-    Rod Rod::write_mat_params_vector(const std::vector<float> &vec, float stretch_scale_factor, float twist_scale_factor, float length_scale_factor)
+    Rod &Rod::write_mat_params_vector(const std::vector<float> &vec, float stretch_scale_factor, float twist_scale_factor, float length_scale_factor)
     {
         float3 scale_factors = {stretch_scale_factor, twist_scale_factor, length_scale_factor};
         for (int i = 0; i < vec.size(); i++) {
@@ -1087,12 +1010,72 @@ namespace rod
         return *this;
     }
 
+    /**
+    Append the arrays that do not change during a run (equilibrium
+    positions and material frames, material parameters and the B matrix) to
+    a binary trajectory buffer, in the same SI units as write_frame_to_file.
+    These go in the header of a binary rod trajectory, written once.
+    */
+    Rod &Rod::append_static_data(std::vector<float> &buffer)
+    {
+        append_vector(buffer, equil_r, mesoDimensions::length);
+        append_vector(buffer, equil_m, mesoDimensions::length);
+        float3 scale_factors = {spring_constant_factor, twist_constant_factor, mesoDimensions::length};
+        for (int i = 0; i < material_params.size(); i++)
+            buffer.push_back(material_params[i] * scale_factors[i % 3]);
+        append_vector(buffer, B_matrix, bending_response_factor);
+        return *this;
+    }
+
+    /**
+    Append a binary trajectory frame to the buffer: current_r and current_m,
+    then, if diagnostics are requested, the steric and vdw energies and
+    forces and the vdw site positions. World collects the frames of every
+    rod and writes them with a single call.
+    */
+    Rod &Rod::append_frame(std::vector<float> &buffer, bool diagnostics)
+    {
+        append_vector(buffer, current_r, mesoDimensions::length);
+        append_vector(buffer, current_m, mesoDimensions::length);
+        if (diagnostics)
+        {
+            append_vector(buffer, steric_energy, mesoDimensions::Energy);
+            append_vector(buffer, steric_force, mesoDimensions::force);
+            append_vector(buffer, vdw_energy, mesoDimensions::Energy);
+            append_vector(buffer, vdw_force, mesoDimensions::force);
+            append_vector(buffer, vdw_site_pos, mesoDimensions::length);
+        }
+        return *this;
+    }
+
+    /**
+    Read current_r and current_m back from a frame written by append_frame,
+    leaving frame pointing at the next rod in the frame.
+    */
+    Rod &Rod::load_binary_frame(const float *&frame, bool diagnostics)
+    {
+        for (int i = 0; i < this->length; i++)
+            current_r[i] = frame[i] / mesoDimensions::length;
+        for (int i = 0; i < this->length; i++)
+            current_m[i] = frame[this->length + i] / mesoDimensions::length;
+        frame += get_frame_length(diagnostics);
+        return *this;
+    }
+
+    /** Number of floats this rod adds to each binary trajectory frame. */
+    int Rod::get_frame_length(bool diagnostics)
+    {
+        if (diagnostics)
+            return (6 * this->length) + vdw_site_pos.size();
+        return 2 * this->length;
+    }
+
     /**
     Close the previous file and create a new file, assigning that to the rod
     variable *file_ptr. This will also copy the contents of the previous
     file into this one.
     */
-    Rod Rod::change_filename(std::string new_filename)
+    Rod &Rod::change_filename(std::string new_filename)
     {
         /** Check if output file exists */
         std::ifstream out_test(new_filename);
@@ -1135,7 +1118,7 @@ namespace rod
     arbitrary 1e-7 seconds and does not save the trajectory from the
     equilibration.
     */
-    Rod Rod::equilibrate_rod(std::shared_ptr<std::vector<RngStream>> &rng)
+    Rod &Rod::equilibrate_rod(std::shared_ptr<std::vector<RngStream>> &rng)
     {
         int no_steps = 1e-7 / timestep; // this is arbitrary
         for (int i = 0; i < no_steps; i++)
@@ -1151,7 +1134,7 @@ namespace rod
     node positions, e.g. this->current_r or this->equil_r. No return values,
     it just updates those arrays
     */
-    Rod Rod::translate_rod(std::vector<float> &r, const float3 &translation_vec)
+    Rod &Rod::translate_rod(std::vector<float> &r, const float3 &translation_vec)
     {
         for (int i = 0; i < this->length; i += 3)
         {
@@ -1169,7 +1152,7 @@ namespace rod
     each centroid, so if current_r and equil_r have different centroids,
     they will be rotated about different points.
     */
-    Rod Rod::rotate_rod(const std::array<float, 3> &euler_angles)
+    Rod &Rod::rotate_rod(const std::array<float, 3> &euler_angles)
     {
         /** Put rod centroid on 0,0,0 */
         float3 equil_centroid;
@@ -1231,7 +1214,7 @@ namespace rod
      * arrays current_r and equil_r. It doesn't modify m, that'll be
      * normalized away anyway.
     */
-    Rod Rod::scale_rod(float scale)
+    Rod &Rod::scale_rod(float scale)
     {
         for (int i = 0; i < this->length; i += 3)
         {
@@ -1249,7 +1232,7 @@ namespace rod
      * Get a centroid for the current frame of the rod. Note: you must supply
      * an array (either current_r or equil_r).
     */
-    Rod Rod::get_centroid(const std::vector<float> &r, OUT float3 &centroid)
+    void Rod::get_centroid(const std::vector<float> &r, OUT float3 &centroid)
     {
         vec3d(n) { centroid[n] = 0; }
         for (int i = 0; i < this->length; i += 3)
@@ -1259,10 +1242,9 @@ namespace rod
             centroid[2] += r[i + 2];
         }
         vec3d(n) { centroid[n] /= this->get_num_nodes(); }
-        return *this;
     }
 
-    Rod Rod::get_min_max(const std::vector<float> &r, OUT float3 &min, float3 &max)
+    void Rod::get_min_max(const std::vector<float> &r, OUT float3 &min, float3 &max)
     {
         std::fill(min.begin(), min.end(), std::numeric_limits<float>::max());
         std::fill(max.begin(),max.end(), std::numeric_limits<float>::min());
@@ -1275,14 +1257,13 @@ namespace rod
             min[z] = std::min(r[i + z], min[z]);
             max[z] = std::max(r[i + z], max[z]);
         }
-        return *this;
     }
 
     /**
      * Get the rod element for the equilibrium or current structure, given
      * an element index.
      */
-    Rod Rod::get_p(int index, OUT float3 &p, bool equil)
+    void Rod::get_p(int index, OUT float3 &p, bool equil)
     {
         if (equil)
         {
@@ -1295,14 +1276,13 @@ namespace rod
             vec3d(n) { p[n] = current_r[(index * 3) + 3 + n] - current_r[(index * 3) + n]; }
         }
         assert(std::abs(rod::absolute(p)) > 1e-7 && "Length of rod element is zero");
-        return *this;
     }
 
     /**
      * Get the rod node position for the equilibrium or current structure, given
      * a node index.
      */
-    Rod Rod::get_r(int node_index, OUT float3 &r_i, bool equil)
+    void Rod::get_r(int node_index, OUT float3 &r_i, bool equil)
     {
         if (equil)
         {
@@ -1312,7 +1292,6 @@ namespace rod
         {
             vec3d(n) { r_i[n] = current_r[(node_index * 3) + n]; }
         }
-        return *this;
     }
 
     float Rod::get_radius(int node_index)
@@ -1341,9 +1320,9 @@ namespace rod
         return rod::absolute(disp);
     }
 
-    int Rod::get_num_nbrs(int element_index, const std::vector<std::vector<InteractionData>> &nbr_list)
+    int Rod::get_num_nbrs(int element_index, const NbrList &nbr_list)
     {
-        return nbr_list.at(element_index).size();
+        return nbr_list.num_nbrs(element_index);
     }
 
     int Rod::get_num_vdw_sites()
@@ -1363,9 +1342,9 @@ namespace rod
         return this->num_nodes;
     }
 
-    Rod Rod::check_nbr_list_dim(std::vector<std::vector<InteractionData>> &nbr_list)
+    Rod &Rod::check_nbr_list_dim(const NbrList &nbr_list)
     {
-        int num_rows = nbr_list.size();
+        int num_rows = nbr_list.num_elements();
         
         if (num_rows != this->get_num_nodes() - 1)
         {
@@ -1379,17 +1358,16 @@ namespace rod
         return *this;
     }
 
-    void Rod::reset_nbr_list(std::vector<std::vector<InteractionData>> &nbr_list)
+    void Rod::reset_nbr_list(NbrList &nbr_list)
     {
-        for (int i = 0; i < this->get_num_nodes() - 1; i++)
-            nbr_list.at(i).clear();
+        nbr_list.clear();
 
         if (rod::dbg_print)
             std::cout << "Reset neighbour list of rod " << this->rod_no << std::endl;
     }
 
     // Just a silly debug function that prints all the positional data of the rod
-    Rod Rod::print_node_positions()
+    Rod &Rod::print_node_positions()
     {
         std::array<float, 3> r = {0, 0, 0};
         for (int i = 0; i < this->get_num_nodes(); i++)
@@ -1408,13 +1386,13 @@ namespace rod
      * @param elem_id
      * @return std::vector<float, 6> - force on nodes [x0, y0, z0, x1, y1, z1]
      */
-    std::vector<float> Rod::net_steric_force_nbrs(int elem_id)
+    float6 Rod::net_steric_force_nbrs(int elem_id)
     {
-        std::vector<float> element_force(3, 0);
-        std::vector<float> energy(3, 0);
+        float3 element_force = { 0 };
+        float3 energy = { 0 };
         float energy_sum = 0;
-        std::vector<float> node_force(6, 0);
-        std::vector<float> node_force_sum(6, 0);
+        float6 node_force = { 0 };
+        float6 node_force_sum = { 0 };
         float3 c_ab = { 0 };
         float3 c_ab_norm = { 0 };
         float gradient = 0;
@@ -1431,7 +1409,7 @@ namespace rod
 
         for (int nbr_id = 0; nbr_id < num_nbrs_on_elem; nbr_id++)
         {
-            rod::InteractionData stericInt = get_interaction_data(elem_id, nbr_id, this->steric_nbrs);
+            const rod::InteractionData &stericInt = get_interaction_data(elem_id, nbr_id, this->steric_nbrs);
 
             // sanity check
             if (!stericInt.elements_intersect())
@@ -1447,13 +1425,13 @@ namespace rod
                 stericInt.radius_self + stericInt.radius_nbr,
                 stericInt.contact_self,
                 stericInt.contact_nbr);
-            gradient = (energy.at(0) - energy.at(1)) / this->perturbation_amount;
-            energy_sum += energy.at(2);
+            gradient = (energy[0] - energy[1]) / this->perturbation_amount;
+            energy_sum += energy[2];
 
             // Project force along interaction vector
             this->get_p(elem_id, p_self, false);
             rod::normalize(stericInt.c_ab, c_ab_norm);
-            vec3d(n) { element_force.at(n) = gradient * c_ab_norm[n]; }
+            vec3d(n) { element_force[n] = gradient * c_ab_norm[n]; }
 
             node_force = node_force_interpolation(
                 stericInt.contact_self,
@@ -1479,10 +1457,8 @@ namespace rod
 
         if (rod::dbg_print)
         {
-            print_vector("  force sum start node",
-                std::vector<float>(node_force_sum.begin(), std::next(node_force_sum.begin(), 3)));
-            print_vector("  force sum end node",
-                std::vector<float>(std::next(node_force_sum.begin(), 3), node_force_sum.end()));
+            print_array("  force sum start node", float3 {node_force_sum[0], node_force_sum[1], node_force_sum[2]});
+            print_array("  force sum end node", float3 {node_force_sum[3], node_force_sum[4], node_force_sum[5]});
             std::cout << "\n";
         }
 
@@ -1496,32 +1472,36 @@ namespace rod
     /**
      * @brief Compute steric interactions for the whole rod. Loop over elements.
      *
-     * ! Currently parallel-unfriendly
+     * The elements are done in parallel, each writing the forces on its two
+     * nodes into element_forces, which are then summed onto the nodes in
+     * element order.
      */
     void Rod::do_steric()
     {
-        std::vector<float> node_force(6, 0);  // x0, y0, z0, x1, y1, z1
+        std::exception_ptr error;
 
-        // reset force from last timestep
-        for (int i = 0; i < this->length; i++)
-            this->steric_force[i] = 0;
-
-        // loop over elements
+#pragma omp taskloop shared(error)
         for (int i = 0; i < this->get_num_nodes() - 1; i++)
         {
             if(rod::dbg_print)
                 std::cout << "ROD STERIC CALC " << this->rod_no << "|" << i << "\n";
 
-            node_force = net_steric_force_nbrs(i);
-            // start node
-            this->steric_force[i * 3] += node_force[0];
-            this->steric_force[(i * 3) + 1] += node_force[1];
-            this->steric_force[(i * 3) + 2] += node_force[2];
-            // end node
-            this->steric_force[(i * 3) + 3] += node_force[3];
-            this->steric_force[(i * 3) + 4] += node_force[4];
-            this->steric_force[(i * 3) + 5] += node_force[5];
+            try
+            {
+                float6 node_force = net_steric_force_nbrs(i);  // x0, y0, z0, x1, y1, z1
+                for (int n = 0; n < 6; n++)
+                    this->element_forces[(i * 6) + n] = node_force[n];
+            }
+            catch (...)
+            {
+#pragma omp critical(rod_force_error)
+                error = std::current_exception();
+            }
         }
+        if (error)
+            std::rethrow_exception(error);
+
+        gather_element_forces(this->steric_force);
 
         if (rod::dbg_print)
         {
@@ -1531,12 +1511,12 @@ namespace rod
 
     }
 
-    std::vector<float> Rod::net_vdw_force_nbrs(int elem_id)
+    float6 Rod::net_vdw_force_nbrs(int elem_id)
     {
-        std::vector<float> element_force(3, 0);
+        float3 element_force = { 0 };
         float energy_sum = 0;
-        std::vector<float> node_force(6, 0);
-        std::vector<float> node_force_sum(6, 0);
+        float6 node_force = { 0 };
+        float6 node_force_sum = { 0 };
         float3 c_ab_norm = { 0 };
         float3 p_self = { 0 };
         float3 diff = { 0 };
@@ -1552,7 +1532,7 @@ namespace rod
 
         for (int nbr_id = 0; nbr_id < num_nbrs_on_elem; nbr_id++)
         {
-            rod::InteractionData VDWInt = get_interaction_data(elem_id, nbr_id, this->vdw_nbrs);
+            const rod::InteractionData &VDWInt = get_interaction_data(elem_id, nbr_id, this->vdw_nbrs);
 
             // for purposes of energy, use surface-surface distance
             r_mag = rod::absolute(VDWInt.c_ab) - (VDWInt.radius_self + VDWInt.radius_nbr);
@@ -1574,7 +1554,7 @@ namespace rod
 
             // Project force along interaction vector
             rod::normalize(VDWInt.c_ab, c_ab_norm);
-            vec3d(n) { element_force.at(n) = force_mag * c_ab_norm[n]; }
+            vec3d(n) { element_force[n] = force_mag * c_ab_norm[n]; }
 
             this->get_p(elem_id, p_self, false);
             node_force = node_force_interpolation(
@@ -1600,10 +1580,8 @@ namespace rod
 
         if (rod::dbg_print)
         {
-            print_vector("  force sum start node",
-                std::vector<float>(node_force_sum.begin(), std::next(node_force_sum.begin(), 3)));
-            print_vector("  force sum end node",
-                std::vector<float>(std::next(node_force_sum.begin(), 3), node_force_sum.end()));
+            print_array("  force sum start node", float3 {node_force_sum[0], node_force_sum[1], node_force_sum[2]});
+            print_array("  force sum end node", float3 {node_force_sum[3], node_force_sum[4], node_force_sum[5]});
             std::cout << "\n";
         }
 
@@ -1617,34 +1595,55 @@ namespace rod
     /**
      * @brief Compute vdw interactions for the whole rod. Loop over elements.
      *
-     * ! Currently parallel-unfriendly
+     * Parallel over elements, in the same way as do_steric.
      */
     void Rod::do_vdw()
     {
-        std::vector<float> node_force(6, 0);
-
-        // reset force from last timestep
-        for (int i = 0; i < this->length; i++)
-            this->vdw_force[i] = 0;
+        std::exception_ptr error;
 
+#pragma omp taskloop shared(error)
         for (int i = 0; i < this->get_num_nodes() - 1; i++)
         {
             if(rod::dbg_print)
                 std::cout << "ROD VDW CALC " << this->rod_no << "|" << i << "\n";
 
-            node_force = net_vdw_force_nbrs(i);
+            try
+            {
+                float6 node_force = net_vdw_force_nbrs(i);
+                for (int n = 0; n < 6; n++)
+                    this->element_forces[(i * 6) + n] = node_force[n];
+            }
+            catch (...)
+            {
+#pragma omp critical(rod_force_error)
+                error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
 
-            // start node
-            this->vdw_force[i * 3] += node_force[0];
-            this->vdw_force[(i * 3) + 1] += node_force[1];
-            this->vdw_force[(i * 3) + 2] += node_force[2];
-            // end node
-            this->vdw_force[(i * 3) + 3] += node_force[3];
-            this->vdw_force[(i * 3) + 4] += node_force[4];
-            this->vdw_force[(i * 3) + 5] += node_force[5];
+        gather_element_forces(this->vdw_force);
+    }
 
+    /**
+     * @brief Sum the start and end node forces in element_forces onto the
+     * nodes, in the same order as adding them element by element would.
+     */
+    void Rod::gather_element_forces(std::vector<float> &node_force)
+    {
+        int num_nodes = this->get_num_nodes();
+        for (int node = 0; node < num_nodes; node++)
+        {
+            vec3d(n)
+            {
+                float force = 0;
+                if (node > 0)
+                    force += this->element_forces[((node - 1) * 6) + 3 + n];
+                if (node < num_nodes - 1)
+                    force += this->element_forces[(node * 6) + n];
+                node_force[(node * 3) + n] = force;
+            }
         }
-
     }
 
 } //end namespace
@@ -45,23 +45,15 @@ tetra_element_linear::tetra_element_linear() {
     vol_0 = 0;
     vol = 0;
     mat3_set_identity(F_ij);
-    internal_stress_mag = 0;
     initialise(J_inv_0);
     initialise(viscosity_matrix);
-    zero_force();
+    blob_force = nullptr;
     last_det = 0;
     daddy_blob = nullptr;
 }
 
-/*
- * Get the memory location of the specified element of K_alpha
- */
-scalar * tetra_element_linear::get_K_alpha_element_mem_loc(int ni, int nj) {
-    return K_alpha.get_K_alpha_mem_loc(ni, nj);
-}
-
 /* Calc the diffusion matrix for this element */
-void tetra_element_linear::calculate_K_alpha() {
+void tetra_element_linear::calculate_K_alpha(PoissonMatrixQuadratic &K_alpha) {
     // Build the poisson diffusion matrix corresponding to this element
     K_alpha.build(n, dielectric);
 }
@@ -76,14 +68,6 @@ void tetra_element_linear::construct_element_mass_matrix(MassMatrixLinear &M_alp
     M_alpha.build(rho, vol_0);
 }
 
-void tetra_element_linear::add_K_alpha(scalar *K, int num_nodes) {
-    for (int i = 0; i < NUM_NODES_QUADRATIC_TET; i++) {
-        for (int j = 0; j < NUM_NODES_QUADRATIC_TET; j++) {
-            K[n[i]->index * num_nodes + n[j]->index] += K_alpha.get_K_alpha_value(i, j);
-        }
-    }
-}
-
 /* Returns the gradient of the potential at the given (s,t,u) position in the element */
 void tetra_element_linear::get_grad_phi_at_stu(arr3 &grad_phi, scalar s, scalar t, scalar u) {
     std::array<arr3, NUM_NODES_QUADRATIC_TET> grad_psi = {};
@@ -220,6 +204,10 @@ void tetra_element_linear::calculate_jacobian(matrix3 &J) {
  * @return True if the element has inverted
  */
 bool tetra_element_linear::calc_shape_function_derivatives_and_volume(matrix3 &J) {
+    return calc_shape_function_derivatives_and_volume(J, dpsi, last_det, vol);
+}
+
+bool tetra_element_linear::calc_shape_function_derivatives_and_volume(const matrix3 &J, vector12 &dpsi, scalar &last_det, scalar &vol) {
     scalar det;
 
     // Calculate shape function derivs from inverse jacobian directly into dpsi[]
@@ -296,34 +284,39 @@ bool tetra_element_linear::calc_shape_function_derivatives_and_volume(matrix3 &J
  * viscosity constants, and the element volume
  */
 void tetra_element_linear::create_viscosity_matrix() {
+    create_viscosity_matrix(dpsi, A, B, vol, viscosity_matrix);
+}
+
+void tetra_element_linear::create_viscosity_matrix(const vector12 &dpsi, scalar A, scalar B, scalar vol, matrix12 &V) {
     int i, j;
     matrix4 K;
+    upper_triangular_matrix4 del2;
 
     // Construct submatrices on the diagonal
-    BULK_VISCOUS_SUBMATRIX_DIAG(viscosity_matrix, 0)
-    BULK_VISCOUS_SUBMATRIX_DIAG(viscosity_matrix, 4)
-    BULK_VISCOUS_SUBMATRIX_DIAG(viscosity_matrix, 8)
+    BULK_VISCOUS_SUBMATRIX_DIAG(V, 0)
+    BULK_VISCOUS_SUBMATRIX_DIAG(V, 4)
+    BULK_VISCOUS_SUBMATRIX_DIAG(V, 8)
 
     // Construct submatrices off diagonal
-    BULK_VISCOUS_SUBMATRIX_OFFDIAG(viscosity_matrix, 0, 4)
-    BULK_VISCOUS_SUBMATRIX_OFFDIAG(viscosity_matrix, 0, 8)
-    BULK_VISCOUS_SUBMATRIX_OFFDIAG(viscosity_matrix, 4, 8)
+    BULK_VISCOUS_SUBMATRIX_OFFDIAG(V, 0, 4)
+    BULK_VISCOUS_SUBMATRIX_OFFDIAG(V, 0, 8)
+    BULK_VISCOUS_SUBMATRIX_OFFDIAG(V, 4, 8)
 
     // Create the diffusion matrix and add it to the viscosity matrix in 3 upper
     // triangular blocks along the diagonal
-    calc_del2_matrix();
-    add_diffusion_matrix(viscosity_matrix);
+    calc_del2_matrix(dpsi, del2);
+    add_diffusion_matrix(del2, A, V);
 
     // Multiply all these values (currently only in upper half of matrix) by the element volume
     for (i = 0; i < 12; i++)
         for (j = 0; j <= i; j++)
-            viscosity_matrix[j][i] *= vol;
+            V[j][i] *= vol;
 
     // Viscosity matrix is symmetric, so no need to recalculate entries.
     // Simply 'mirror image' the matrix back into itself
     for (i = 1; i < 12; i++)
         for (j = 0; j < i; j++)
-            viscosity_matrix[i][j] = viscosity_matrix[j][i];
+            V[i][j] = V[j][i];
 }
 
 /*
@@ -373,6 +366,10 @@ void tetra_element_linear::calc_deformation(matrix3 &J) {
 }
 
 void tetra_element_linear::add_shear_elastic_stress(matrix3 &J, matrix3 &stress) {
+    add_shear_elastic_stress(J, J_inv_0, G, vol_0, vol, F_ij, stress);
+}
+
+void tetra_element_linear::add_shear_elastic_stress(const matrix3 &J, const matrix3 &J_inv_0, scalar G, scalar vol_0, scalar vol, matrix3 &F_ij, matrix3 &stress) {
     // Reset gradient deformation to zero
     initialise(F_ij);
 
@@ -395,6 +392,10 @@ void tetra_element_linear::add_shear_elastic_stress(matrix3 &J, matrix3 &stress)
  *
  */
 void tetra_element_linear::add_bulk_elastic_stress(matrix3 &stress) {
+    add_bulk_elastic_stress(G, E, vol_0, vol, stress);
+}
+
+void tetra_element_linear::add_bulk_elastic_stress(scalar G, scalar E, scalar vol_0, scalar vol, matrix3 &stress) {
     scalar c_2 = E - G * 2.0 / 3.0;
     scalar c = G * (1.0 - (vol_0 / vol)) + 0.5 * c_2 * ((vol / vol_0) - (vol_0 / vol));
     stress[0][0] += c;
@@ -410,20 +411,24 @@ void tetra_element_linear::add_bulk_elastic_stress(matrix3 &stress) {
  *
  */
 void tetra_element_linear::add_fluctuating_stress(const SimulationParams &params, std::shared_ptr<std::vector<RngStream>> &rng, matrix3 &stress, int thread_id) {
+    add_fluctuating_stress(params, rng, vol, sqrt(A), sqrt(2 * A), sqrt(B), stress, thread_id);
+}
+
+void tetra_element_linear::add_fluctuating_stress(const SimulationParams &params, std::shared_ptr<std::vector<RngStream>> &rng, scalar vol, scalar sqrt_A, scalar sqrt_2A, scalar sqrt_B, matrix3 &stress, int thread_id) {
     scalar c = sqrt((24 * params.kT) / (vol * params.dt));
 
     // Bulk fluctuation term
-    scalar bf = sqrt(B) * RAND(-.5, .5);
+    scalar bf = sqrt_B * RAND(-.5, .5);
 
     // Diagonal terms
-    stress[0][0] += c * (sqrt(2 * A) * RAND(-.5, .5) + bf);
-    stress[1][1] += c * (sqrt(2 * A) * RAND(-.5, .5) + bf);
-    stress[2][2] += c * (sqrt(2 * A) * RAND(-.5, .5) + bf);
+    stress[0][0] += c * (sqrt_2A * RAND(-.5, .5) + bf);
+    stress[1][1] += c * (sqrt_2A * RAND(-.5, .5) + bf);
+    stress[2][2] += c * (sqrt_2A * RAND(-.5, .5) + bf);
 
     // Off diagonal terms (note that stress matrix is symmetric)
-    stress[0][1] += c * sqrt(A) * RAND(-.5, .5);
-    stress[0][2] += c * sqrt(A) * RAND(-.5, .5);
-    stress[1][2] += c * sqrt(A) * RAND(-.5, .5);
+    stress[0][1] += c * sqrt_A * RAND(-.5, .5);
+    stress[0][2] += c * sqrt_A * RAND(-.5, .5);
+    stress[1][2] += c * sqrt_A * RAND(-.5, .5);
 
     stress[1][0] = stress[0][1];
     stress[2][0] = stress[0][2];
@@ -434,6 +439,10 @@ void tetra_element_linear::add_fluctuating_stress(const SimulationParams &params
  * Applies the given stress tensor to the shape function derivatives to get the contribution to du
  */
 void tetra_element_linear::apply_stress_tensor(matrix3 &stress, vector12 &du) {
+    apply_stress_tensor(dpsi, vol, stress, du);
+}
+
+void tetra_element_linear::apply_stress_tensor(const vector12 &dpsi, scalar vol, const matrix3 &stress, vector12 &du) {
     for (int i = 0; i < 3; i++) {
         du[4 * i] += vol * (dpsi[0] * stress[i][0] + dpsi[4] * stress[i][1] + dpsi[8] * stress[i][2]);
         du[4 * i + 1] += vol * (dpsi[1] * stress[i][0] + dpsi[5] * stress[i][1] + dpsi[9] * stress[i][2]);
@@ -445,48 +454,32 @@ void tetra_element_linear::apply_stress_tensor(matrix3 &stress, vector12 &du) {
 /*
  * Sets the given 12-vector to the velocities of this element's four nodes,
  */
-void tetra_element_linear::get_element_velocity_vector(vector12 &v) {
-    v[0] = n[0]->vel[0];
-    v[1] = n[1]->vel[0];
-    v[2] = n[2]->vel[0];
-    v[3] = n[3]->vel[0];
+void tetra_element_linear::get_element_velocity_vector(const std::vector<arr3> &vel, vector12 &v) {
+    v[0] = vel[n[0]->index][0];
+    v[1] = vel[n[1]->index][0];
+    v[2] = vel[n[2]->index][0];
+    v[3] = vel[n[3]->index][0];
 
-    v[4] = n[0]->vel[1];
-    v[5] = n[1]->vel[1];
-    v[6] = n[2]->vel[1];
-    v[7] = n[3]->vel[1];
+    v[4] = vel[n[0]->index][1];
+    v[5] = vel[n[1]->index][1];
+    v[6] = vel[n[2]->index][1];
+    v[7] = vel[n[3]->index][1];
 
-    v[8] = n[0]->vel[2];
-    v[9] = n[1]->vel[2];
-    v[10] = n[2]->vel[2];
-    v[11] = n[3]->vel[2];
-}
-
-/*
- * Add this element's nodal forces to those given in the force 12-vector
- */
-void tetra_element_linear::add_element_force_vector(vector12 &force) {
-    node_force[0][0] -= force[0];
-    node_force[1][0] -= force[1];
-    node_force[2][0] -= force[2];
-    node_force[3][0] -= force[3];
-
-    node_force[0][1] -= force[4];
-    node_force[1][1] -= force[5];
-    node_force[2][1] -= force[6];
-    node_force[3][1] -= force[7];
-
-    node_force[0][2] -= force[8];
-    node_force[1][2] -= force[9];
-    node_force[2][2] -= force[10];
-    node_force[3][2] -= force[11];
+    v[8] = vel[n[0]->index][2];
+    v[9] = vel[n[1]->index][2];
+    v[10] = vel[n[2]->index][2];
+    v[11] = vel[n[3]->index][2];
 }
 
 /* Add given force to the specified node of this element */
 void tetra_element_linear::add_force_to_node(int i, arr3 &f) {
-    node_force[i][0] += f[0];
-    node_force[i][1] += f[1];
-    node_force[i][2] += f[2];
+    arr3 &force = blob_force[n[i]->index];
+    for (int j = 0; j < 3; ++j) {
+#ifdef USE_OPENMP
+        #pragma omp atomic
+#endif
+        force[j] += f[j];
+    }
 }
 
 /* A roundabout and inefficient way of working out what node (from 0 to 9) this index corresponds to */
@@ -503,7 +496,6 @@ void tetra_element_linear::print() {
     for (int i = 0; i < NUM_NODES_QUADRATIC_TET; i++) {
         printf("Node %d:\n", i);
         n[i]->print();
-        printf("node_force: %e %e %e\n", node_force[i][0], node_force[i][1], node_force[i][2]);
         printf("volume: %e\n", vol);
     }
 }
@@ -546,10 +538,6 @@ void tetra_element_linear::volume_coord_to_xyz(scalar eta0, scalar eta1, scalar
         r[i] = eta0 * n[0]->pos[i] + eta1 * n[1]->pos[i] + eta2 * n[2]->pos[i] + eta3 * n[3]->pos[i];
 }
 
-void tetra_element_linear::zero_force() {
-    initialise(node_force);
-}
-
 void tetra_element_linear::linearise_element() {
     n[4]->pos[0] = .5 * (n[0]->pos[0] + n[1]->pos[0]);
     n[4]->pos[1] = .5 * (n[0]->pos[1] + n[1]->pos[1]);
@@ -582,7 +570,7 @@ void tetra_element_linear::calc_centroid() {
     centroid[2] = .25 * (n[0]->pos[2] + n[1]->pos[2] + n[2]->pos[2] + n[3]->pos[2]);
 }
 
-void tetra_element_linear::calc_del2_matrix() {
+void tetra_element_linear::calc_del2_matrix(const vector12 &dpsi, upper_triangular_matrix4 &del2) {
     del2.u00 = (dpsi[0] * dpsi[0] + dpsi[4] * dpsi[4] + dpsi[8] * dpsi[8]);
     del2.u01 = (dpsi[0] * dpsi[1] + dpsi[4] * dpsi[5] + dpsi[8] * dpsi[9]);
     del2.u02 = (dpsi[0] * dpsi[2] + dpsi[4] * dpsi[6] + dpsi[8] * dpsi[10]);
@@ -604,7 +592,7 @@ void tetra_element_linear::calc_del2_matrix() {
     //			printf("%e %e %e %e\n", del2.u03, del2.u13, del2.u23, del2.u33);
 }
 
-void tetra_element_linear::add_diffusion_matrix(matrix12 &V) {
+void tetra_element_linear::add_diffusion_matrix(const upper_triangular_matrix4 &del2, scalar A, matrix12 &V) {
     // Drop each upper triangle of this diffusion matrix along the block diagonal
     // of the viscosity matrix
     for (int i = 0; i < 3; i++) {
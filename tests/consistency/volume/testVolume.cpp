@@ -128,11 +128,52 @@ int main() {
 
   vol = volumeIntersection(tetC, tetD, false, cm);
   if (vol == 0) {
-    cout << " intersecting volume should not be zero for these tetrahedra" << endl; 
+    cout << " intersecting volume should not be zero for these tetrahedra" << endl;
     return 1;
-  } 
+  }
+
+  // the analytic gradient with respect to moving tetB must match
+  //   central differences of the volume, and give the same volume and CM:
+  for (int t=0; t<4; t++) {
+    // three displacements of tetB against tetA, and the skewed tetC and tetD:
+    arr3 shift = {0.07*t, -0.05*t, 0.11*t};
+    std::array<arr3, 4> tetE;
+    if (t == 3) {
+      tetA = tetC;
+      tetE = tetD;
+    } else {
+      for (int i=0; i<4; i++)
+        for (int j=0; j<3; j++)
+          tetE[i][j] = tetB[i][j] + shift[j];
+    }
+
+    arr3 dVdB, cmg;
+    scalar volg = volumeIntersectionAndGradientII(tetA[0], tetA[1], tetA[2], tetA[3], tetE[0], tetE[1], tetE[2], tetE[3], dVdB, cmg);
+    vol = volumeIntersectionII(tetA[0], tetA[1], tetA[2], tetA[3], tetE[0], tetE[1], tetE[2], tetE[3], true, cm);
+    if ((fabs(volg - vol) > 1e-14) || (distance(cm, cmg) > 1e-14)) {
+      cout << " volumeIntersectionAndGradientII and volumeIntersectionII disagree: " << volg << " " << vol << endl;
+      return 1;
+    }
+
+    scalar dr = 1e-6;
+    for (int dir=0; dir<3; dir++) {
+      std::array<arr3, 4> tetP = tetE, tetM = tetE;
+      for (int i=0; i<4; i++) {
+        tetP[i][dir] += dr;
+        tetM[i][dir] -= dr;
+      }
+      scalar vP = volumeIntersectionII(tetA[0], tetA[1], tetA[2], tetA[3], tetP[0], tetP[1], tetP[2], tetP[3], false, cm);
+      scalar vM = volumeIntersectionII(tetA[0], tetA[1], tetA[2], tetA[3], tetM[0], tetM[1], tetM[2], tetM[3], false, cm);
+      scalar fd = (vP - vM) / (2*dr);
+      cout << "dV/dx_" << dir << ": analytic " << dVdB[dir] << ", numerical " << fd << endl;
+      if (fabs(fd - dVdB[dir]) > 1e-6) {
+        cout << " the analytic volume gradient does not match the numerical one" << endl;
+        return 1;
+      }
+    }
+  }
 
-  return 0; 
+  return 0;
 
 }
    
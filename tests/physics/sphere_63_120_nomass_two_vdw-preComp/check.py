@@ -59,7 +59,7 @@ def readAndStore(iFile):
 
 ## compare the PreCompEnergy of the first step to a value that has been checked:
 err = 0
-knownValue = 2.79280200000000000e-18
+knownValue = 2.79271300000000000e-18
 #knownValue = 1.0075630000000001e-18
 #knownValue = 6.87781100000000001e-17
 
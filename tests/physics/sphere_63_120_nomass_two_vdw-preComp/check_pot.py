@@ -0,0 +1,75 @@
+# 
+#  This file is part of the FFEA simulation package
+#  
+#  Copyright (c) by the Theory and Development FFEA teams,
+#  as they appear in the README.md file. 
+# 
+#  FFEA is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+# 
+#  FFEA is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+# 
+#  You should have received a copy of the GNU General Public License
+#  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+# 
+#  To help us fund FFEA development, we humbly ask that you cite 
+#  the research papers on the package.
+#
+
+import sys
+
+
+def readAndStore(iFile):
+  H = []
+  dH = {}
+  with open(iFile, 'r') as sta:
+    while (sta.readline() != "Measurements:\n"):
+      continue
+
+    blob = ""
+    readblob = False
+    for i in sta.readline().split():
+      if i == "|":
+        readblob = True
+        continue
+      if readblob:
+        blob = i
+        readblob = False
+        print(i)
+        continue
+      H.append([blob+i])
+    for line in sta:
+      cnt = 0
+      if line.count("RESTART"): continue
+      for i in line.split():
+        H[cnt].append(float(i))
+        cnt += 1
+
+  for i in range(len(H)):
+    dH[H[i][0]] = i
+    H[i].pop(0)
+
+  return H, dH
+
+
+## inputData = 2 computes the forces from the .pot table. Those have to be in the same units
+##   as the forces read from the .force table (inputData = 1), so both runs should evolve alike:
+err = 0
+tol = 1e-3
+
+H1, dH1 = readAndStore("sphere_63_120_two-force_measurement.out")
+H2, dH2 = readAndStore("sphere_63_120_two-pot_measurement.out")
+
+for m in ["StrainEnergy", "RMSD", "PreCompEnergy"]:
+  for v1, v2 in zip(H1[dH1[m]], H2[dH2[m]]):
+    if ( abs (v2 - v1) > tol * abs(v1) ):
+      print( "%s from the .pot table only should be %e, but was found to be %e" % (m, v1, v2))
+      err = 1
+      break
+
+sys.exit(err)
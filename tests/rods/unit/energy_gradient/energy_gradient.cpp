@@ -0,0 +1,105 @@
+// 
+//  This file is part of the FFEA simulation package
+//  
+//  Copyright (c) by the Theory and Development FFEA teams,
+//  as they appear in the README.md file. 
+// 
+//  FFEA is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+// 
+//  FFEA is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+// 
+//  You should have received a copy of the GNU General Public License
+//  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//  To help us fund FFEA development, we humbly ask that you cite 
+//  the research papers on the package.
+//
+
+/*
+ * Check that the energy gradients from get_energy_gradient match central
+ * differences of get_perturbation_energy, for every node and degree of
+ * freedom of a bent and twisted rod, and that the energies are the same.
+ */
+
+#include "rod_structure.h"
+#include <string>
+#include <cmath>
+
+int main(){
+    rod::Rod test_rod("twisted_bent_rod.rod", 0);
+    test_rod.load_header("twisted_bent_rod.rod");
+    test_rod.load_contents("twisted_bent_rod.rod");
+    test_rod.set_units();
+
+    // The material frames in the file are not quite perpendicular to the
+    // elements, which they always are after a timestep
+    for (int elem = 0; elem < test_rod.num_nodes - 1; elem++) {
+        rod::float3 p_i, m_i;
+        for (int n = 0; n < 3; n++) {
+            p_i[n] = test_rod.current_r[(elem + 1) * 3 + n] - test_rod.current_r[elem * 3 + n];
+            m_i[n] = test_rod.current_m[elem * 3 + n];
+        }
+        rod::perpendicularize(m_i, p_i, m_i);
+        rod::normalize(m_i, m_i);
+        for (int n = 0; n < 3; n++)
+            test_rod.current_m[elem * 3 + n] = m_i[n];
+    }
+
+    // float precision limits how small the finite differences can be
+    float perturbation_amount = (0.01*pow(10,-9))/mesoDimensions::length;
+    float twist_perturbation = 0.006283185;
+    float tolerance = 0.02;
+    int result = 0;
+
+    for (int node_no = 0; node_no < test_rod.num_nodes; node_no++) {
+        int start_cutoff;
+        int end_cutoff;
+        rod::set_cutoff_values(node_no, test_rod.num_nodes, &start_cutoff, &end_cutoff);
+
+        rod::float3 energies;
+        rod::float4x3 gradients;
+        rod::get_energy_gradient(test_rod.B_matrix, test_rod.material_params, start_cutoff, end_cutoff, node_no,
+                                 test_rod.current_r, test_rod.equil_r, test_rod.current_m, test_rod.equil_m,
+                                 energies, gradients);
+
+        rod::float3 unperturbed;
+        rod::get_perturbation_energy(0, rod::x, test_rod.B_matrix, test_rod.material_params, start_cutoff, end_cutoff, node_no,
+                                     test_rod.current_r, test_rod.equil_r, test_rod.current_m, test_rod.equil_m, unperturbed);
+        for (int k = 0; k < 3; k++) {
+            if (std::abs(energies[k] - unperturbed[k]) > 1e-4 * std::abs(unperturbed[k]) + 1e-6) {
+                std::cout << "node " << node_no << ": energy " << k << " is " << energies[k] << " but should be " << unperturbed[k] << "\n";
+                result = 1;
+            }
+        }
+
+        for (int dof = 0; dof < 4; dof++) {
+            // x, y and z are dimensions 0 to 2, the twist is dimension 4
+            int dimension = (dof == 3) ? 4 : dof;
+            float h = (dof == 3) ? twist_perturbation : perturbation_amount;
+            rod::float3 energy_plus, energy_minus;
+            rod::get_perturbation_energy(0.5 * h, dimension, test_rod.B_matrix, test_rod.material_params, start_cutoff, end_cutoff, node_no,
+                                         test_rod.current_r, test_rod.equil_r, test_rod.current_m, test_rod.equil_m, energy_plus);
+            rod::get_perturbation_energy(-0.5 * h, dimension, test_rod.B_matrix, test_rod.material_params, start_cutoff, end_cutoff, node_no,
+                                         test_rod.current_r, test_rod.equil_r, test_rod.current_m, test_rod.equil_m, energy_minus);
+            float numerical = 0;
+            float analytic = 0;
+            for (int k = 0; k < 3; k++) {
+                numerical += (energy_plus[k] - energy_minus[k]) / h;
+                analytic += gradients[dof][k];
+            }
+            std::cout << "node " << node_no << " dof " << dof << ": dE " << analytic << ", numerical " << numerical << "\n";
+            if (std::abs(analytic - numerical) > tolerance * std::abs(numerical) + 1e-4) {
+                std::cout << "  the energy gradient does not match the numerical one\n";
+                result = 1;
+            }
+        }
+    }
+
+    return result;
+}
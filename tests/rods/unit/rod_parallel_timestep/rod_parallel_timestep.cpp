@@ -0,0 +1,91 @@
+// 
+//  This file is part of the FFEA simulation package
+//  
+//  Copyright (c) by the Theory and Development FFEA teams,
+//  as they appear in the README.md file. 
+// 
+//  FFEA is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+// 
+//  FFEA is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+// 
+//  You should have received a copy of the GNU General Public License
+//  along with FFEA.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//  To help us fund FFEA development, we humbly ask that you cite 
+//  the research papers on the package.
+//
+
+/*
+ * Check that a rod stepped with its node loops spread over several threads
+ * ends up exactly where the same rod stepped on one thread does, given the
+ * same random number stream.
+ */
+
+#include "rod_structure.h"
+#include <string>
+#include <cmath>
+
+rod::Rod *load_rod(const std::string &filename)
+{
+    rod::Rod *test_rod = new rod::Rod(filename, 0);
+    test_rod->load_header(filename);
+    test_rod->load_contents(filename);
+    test_rod->set_units();
+    test_rod->viscosity = 1e-3 / (mesoDimensions::pressure * mesoDimensions::time);
+    test_rod->timestep = 1e-12 / mesoDimensions::time;
+    test_rod->kT = 4.11e-21 / mesoDimensions::Energy;
+    test_rod->calc_noise = 1;
+    test_rod->calc_steric = 1;
+    return test_rod;
+}
+
+int main(){
+    rod::Rod *serial_rod = load_rod("twisted_bent_rod.rod");
+    rod::Rod *threaded_rod = load_rod("twisted_bent_rod.rod");
+
+    const uint32_t seed[6] = {12345, 12345, 12345, 12345, 12345, 12345};
+    RngStream serial_rng, threaded_rng;
+    serial_rng.SetSeed(seed);
+    threaded_rng.SetSeed(seed);
+
+    for (int step = 0; step < 200; step++) {
+        serial_rod->draw_noise(serial_rng).do_timestep();
+
+        threaded_rod->draw_noise(threaded_rng);
+#pragma omp parallel num_threads(4)
+#pragma omp single
+        threaded_rod->do_timestep();
+    }
+
+    int result = 0;
+    for (int i = 0; i < serial_rod->length; i++) {
+        if (serial_rod->current_r[i] != threaded_rod->current_r[i] || serial_rod->current_m[i] != threaded_rod->current_m[i]) {
+            std::cout << "entry " << i << " differs: r " << serial_rod->current_r[i] << " vs " << threaded_rod->current_r[i]
+                      << ", m " << serial_rod->current_m[i] << " vs " << threaded_rod->current_m[i] << "\n";
+            result = 1;
+        }
+    }
+
+    float moved = 0;
+    rod::Rod *initial_rod = load_rod("twisted_bent_rod.rod");
+    for (int i = 0; i < serial_rod->length; i++)
+        moved += std::abs(serial_rod->current_r[i] - initial_rod->current_r[i]);
+    if (moved == 0) {
+        std::cout << "the rod did not move\n";
+        result = 1;
+    }
+
+    if (result == 0)
+        std::cout << "Threaded rod timesteps match the serial ones.\n";
+
+    delete serial_rod;
+    delete threaded_rod;
+    delete initial_rod;
+    return result;
+}